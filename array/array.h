@@ -84,4 +84,5 @@ using Enum_Table_Allow_Nil = Enum_Table<ENUM_KEY, T_VALUE, ENUM_KEY::NIL>;
 
 #include "slice.h"
 #include "buffer.h"
-#include "priority_queue.h"
+#include "slot_map.h"
+#include "priority_queue.h"     // After slot_map.h, for Slot_Handle
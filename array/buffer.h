@@ -53,7 +53,7 @@ EnsureCapacity(DynArray<T>* array, int capacity)
             newCapacity *= 2;
         }
 
-        array->items = (T*)reallocate_tracked(array->memory, array->items, sizeof(T) * newCapacity);
+        array->items = (T*)reallocate_tracked(array->memory, array->items, sizeof(T) * newCapacity, alignof(T));
         array->capacity = newCapacity;
     }
 }
@@ -1,12 +1,252 @@
 // --- Priority Queue
+//  d-ary min-heap: pop returns the item that compares lowest. ARITY children per node. 4 is usually faster
+//  than 2 once the heap outgrows the cache, since the tree is half as deep and a node's children are
+//  adjacent (one or two cache lines), at the price of more compares per level on the way down.
+//
+//  The comparator is either a function pointer passed at creation (COMPARE = void), or fixed at compile
+//  time with Priority_Queue_Compare<T, fn>, which lets it inline.
+//
+//  Sifting moves a hole instead of swapping, so each level costs one copy instead of three.
+//
+//  usage:
+//      using Open_Set = Priority_Queue<Node, Priority_Queue_Compare<Node, node_compare>, 4>;
+//      Open_Set open = priority_queue_create<Node, Priority_Queue_Compare<Node, node_compare>, 4>(memory);
+//      priority_queue_insert(&open, start);
+//      while (!priority_queue_is_empty(open)) { Node node = priority_queue_pop(&open); ... }
+//
+//  Indexed_Priority_Queue also hands out a Slot_Handle per item, which can change the item's priority
+//  (decrease-key) or remove it from the middle of the heap, in O(log n).
 
-template <typename T>
+template <typename T, int (*FN)(T const& a, T const& b)>
+struct Priority_Queue_Compare
+{
+    static int compare(T const& a, T const& b) { return FN(a, b); }
+};
+
+template <typename T, typename COMPARE = void, int ARITY = 2>
 struct Priority_Queue
 {
+    STATIC_ASSERT(ARITY >= 2);
+
     DynArray<T> array;
-    int (*compare)(T const& a, T const& b);
+    int (*compare)(T const& a, T const& b);     // Only used if COMPARE is void
+};
+
+template <typename T, typename COMPARE = void, int ARITY = 2>
+struct Indexed_Priority_Queue
+{
+    STATIC_ASSERT(ARITY >= 2);
+
+    struct Entry
+    {
+        T item;
+        u32 sparse_index;
+    };
+
+    DynArray<Entry> array;                  // The heap
+    DynArray<Slot_Map_Sparse> sparse;       // Indexed by handle. dense_index is the entry's heap index.
+    u32 free_head;                          // Free list through Slot_Map_Sparse::dense_index
+    int (*compare)(T const& a, T const& b);     // Only used if COMPARE is void
+};
+
+namespace PRIORITY_QUEUE
+{
+
+template <typename T, typename COMPARE>
+struct Comparator
+{
+    static int compare(int (*)(T const&, T const&), T const& a, T const& b) { return COMPARE::compare(a, b); }
+};
+
+template <typename T>
+struct Comparator<T, void>
+{
+    static int compare(int (*fn)(T const&, T const&), T const& a, T const& b) { return fn(a, b); }
 };
 
+// The heap code below is shared by both queues. Entries are what the heap stores, and placing one has to
+//  tell the indexed queue where its item went.
+
+template <typename T, typename COMPARE, int ARITY>
+function bool
+entry_less(Priority_Queue<T, COMPARE, ARITY> const& queue, T const& a, T const& b)
+{
+    return Comparator<T, COMPARE>::compare(queue.compare, a, b) < 0;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function bool
+entry_less(
+    Indexed_Priority_Queue<T, COMPARE, ARITY> const& queue,
+    typename Indexed_Priority_Queue<T, COMPARE, ARITY>::Entry const& a,
+    typename Indexed_Priority_Queue<T, COMPARE, ARITY>::Entry const& b)
+{
+    return Comparator<T, COMPARE>::compare(queue.compare, a.item, b.item) < 0;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function void
+entry_place(Priority_Queue<T, COMPARE, ARITY>* queue, int index, T const& entry)
+{
+    queue->array.items[index] = entry;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function void
+entry_place(
+    Indexed_Priority_Queue<T, COMPARE, ARITY>* queue,
+    int index,
+    typename Indexed_Priority_Queue<T, COMPARE, ARITY>::Entry const& entry)
+{
+    queue->array.items[index] = entry;
+    queue->sparse.items[entry.sparse_index].dense_index = (u32)index;
+}
+
+// The sift loops work on a copy of the queue header, since entry_place only writes through its pointers.
+//  With the comparator behind a function pointer, the compiler has to assume each call can change the
+//  queue, and would otherwise reload items and compare on every level.
+
+// Places entry at index or above, moving parents down until it's not less than its parent. Returns its index.
+template <int ARITY, typename QUEUE, typename ENTRY>
+function int
+sift_up(QUEUE* queue, int index, ENTRY const& entry)
+{
+    QUEUE heap = *queue;
+    ENTRY const* items = heap.array.items;
+
+    while (index > 0)
+    {
+        int parent_index = (index - 1) / ARITY;
+        if (!entry_less(heap, entry, items[parent_index]))
+            break;
+
+        entry_place(&heap, index, items[parent_index]);
+        index = parent_index;
+    }
+
+    entry_place(&heap, index, entry);
+    return index;
+}
+
+// Places entry at index or below, moving its least child up until no child is less than it
+template <int ARITY, typename QUEUE, typename ENTRY>
+function void
+sift_down(QUEUE* queue, int index, ENTRY const& entry)
+{
+    QUEUE heap = *queue;
+    ENTRY const* items = heap.array.items;
+    int count = heap.array.count;
+
+    while (true)
+    {
+        int first_child = ARITY * index + 1;
+        if (first_child >= count)
+            break;
+
+        // Picking the least child is branchless, so the next level's loads can't start early on a predicted
+        //  branch. Prefetch the grandchildren instead, which overlaps the cache misses in big heaps.
+        int first_grandchild = ARITY * first_child + 1;
+        if (first_grandchild < count)
+        {
+            int last_grandchild = min(first_grandchild + ARITY * ARITY, count) - 1;
+            _mm_prefetch((char const*)(items + first_grandchild), _MM_HINT_T0);
+            _mm_prefetch((char const*)(items + last_grandchild), _MM_HINT_T0);
+        }
+
+        int last_child = min(first_child + ARITY, count);
+        int least_index = first_child;
+        for (int child = first_child + 1; child < last_child; child++)
+        {
+            if (entry_less(heap, items[child], items[least_index]))
+            {
+                least_index = child;
+            }
+        }
+
+        if (!entry_less(heap, items[least_index], entry))
+            break;
+
+        entry_place(&heap, index, items[least_index]);
+        index = least_index;
+    }
+
+    entry_place(&heap, index, entry);
+}
+
+// Fixes an entry whose priority may have moved either way
+template <int ARITY, typename QUEUE, typename ENTRY>
+function void
+sift(QUEUE* queue, int index, ENTRY const& entry)
+{
+    if (sift_up<ARITY>(queue, index, entry) == index)
+    {
+        sift_down<ARITY>(queue, index, entry);
+    }
+}
+
+// Floyd's bottom-up build: sift down every parent, last first. O(n), vs O(n log n) for n inserts.
+template <int ARITY, typename QUEUE>
+function void
+heapify(QUEUE* queue)
+{
+    int count = queue->array.count;
+    for (int index = (count - 2) / ARITY; index >= 0 && count > 1; index--)
+    {
+        auto entry = queue->array.items[index];
+        sift_down<ARITY>(queue, index, entry);
+    }
+}
+
+// Removes the entry at index, filling the hole with the last entry. The last entry was a leaf, so it
+//  almost always belongs near the bottom again: move the hole all the way down first, without comparing
+//  against it, then sift it up from there (Floyd's bottom-up pop). About half the compares of sifting down.
+template <int ARITY, typename QUEUE>
+function void
+remove_at(QUEUE* queue, int index)
+{
+    auto last = queue->array.items[queue->array.count - 1];
+    queue->array.count--;
+
+    QUEUE heap = *queue;
+    auto const* items = heap.array.items;
+    int count = heap.array.count;
+    if (index >= count)
+        return;
+
+    while (true)
+    {
+        int first_child = ARITY * index + 1;
+        if (first_child >= count)
+            break;
+
+        // See sift_down
+        int first_grandchild = ARITY * first_child + 1;
+        if (first_grandchild < count)
+        {
+            int last_grandchild = min(first_grandchild + ARITY * ARITY, count) - 1;
+            _mm_prefetch((char const*)(items + first_grandchild), _MM_HINT_T0);
+            _mm_prefetch((char const*)(items + last_grandchild), _MM_HINT_T0);
+        }
+
+        int last_child = min(first_child + ARITY, count);
+        int least_index = first_child;
+        for (int child = first_child + 1; child < last_child; child++)
+        {
+            if (entry_less(heap, items[child], items[least_index]))
+            {
+                least_index = child;
+            }
+        }
+
+        entry_place(&heap, index, items[least_index]);
+        index = least_index;
+    }
+
+    sift_up<ARITY>(queue, index, last);
+}
+
+} // namespace PRIORITY_QUEUE
+
 template <typename T>
 function Priority_Queue<T>
 priority_queue_create(
@@ -19,40 +259,86 @@ priority_queue_create(
     return result;
 }
 
-template <typename T>
+// Comparator fixed at compile time
+template <typename T, typename COMPARE, int ARITY = 2>
+function Priority_Queue<T, COMPARE, ARITY>
+priority_queue_create(Memory_Region memory)
+{
+    Priority_Queue<T, COMPARE, ARITY> result;
+    result.array = DynArray<T>(memory);
+    result.compare = nullptr;
+    return result;
+}
+
+template <typename T, typename COMPARE, int ARITY>
 function bool
-priority_queue_is_empty(Priority_Queue<T> const& queue)
+priority_queue_is_empty(Priority_Queue<T, COMPARE, ARITY> const& queue)
 {
     bool result = array_is_empty(queue.array);
     return result;
 }
 
-template <typename T>
+template <typename T, typename COMPARE, int ARITY>
+function int
+priority_queue_count(Priority_Queue<T, COMPARE, ARITY> const& queue)
+{
+    return queue.array.count;
+}
+
+// The item pop would return, without removing it
+template <typename T, typename COMPARE, int ARITY>
+function T*
+priority_queue_peek(Priority_Queue<T, COMPARE, ARITY> const& queue)
+{
+    T* result = (queue.array.count > 0) ? queue.array.items : nullptr;
+    return result;
+}
+
+template <typename T, typename COMPARE, int ARITY>
 function void
-priority_queue_insert(Priority_Queue<T>* queue, T const& item)
+priority_queue_insert(Priority_Queue<T, COMPARE, ARITY>* queue, T const& item)
 {
-    DynArray<T>* array = &queue->array;
-    Append(array, item);
+    T copy = item;      // item may point into the array, which Append can move
+    array_append_new(&queue->array);
+    PRIORITY_QUEUE::sift_up<ARITY>(queue, queue->array.count - 1, copy);
+}
 
-    // Heapify "up"
-    int index = array->count - 1;
-    while (index > 0)
-    {
-        int parent_index = (index - 1) / 2;
-        T* inserted = *array + index;
-        T* parent = *array + parent_index;
+// Inserts many items at once. If they're a big part of the result, rebuilds the heap in O(n) instead of
+//  sifting each one up in O(log n).
+template <typename T, typename COMPARE, int ARITY>
+function void
+priority_queue_insert_bulk(Priority_Queue<T, COMPARE, ARITY>* queue, Slice<T> items)
+{
+    int old_count = queue->array.count;
+    EnsureCapacity(&queue->array, old_count + items.count);
+    mem_copy(queue->array.items + old_count, items.items, items.count * sizeof(T));
+    queue->array.count += items.count;
 
-        if (queue->compare(*inserted, *parent) >= 0)
-            break;
+    if (items.count >= old_count / 4)
+    {
+        PRIORITY_QUEUE::heapify<ARITY>(queue);
+        return;
+    }
 
-        mem_swap(inserted, parent);
-        index = parent_index;
+    for (int i = old_count; i < queue->array.count; i++)
+    {
+        T item = queue->array.items[i];
+        PRIORITY_QUEUE::sift_up<ARITY>(queue, i, item);
     }
 }
 
-template <typename T>
+// Replaces the contents of the queue with items, in O(n)
+template <typename T, typename COMPARE, int ARITY>
+function void
+priority_queue_heapify(Priority_Queue<T, COMPARE, ARITY>* queue, Slice<T> items)
+{
+    queue->array.count = 0;
+    priority_queue_insert_bulk(queue, items);
+}
+
+template <typename T, typename COMPARE, int ARITY>
 function T
-priority_queue_pop(Priority_Queue<T>* queue)
+priority_queue_pop(Priority_Queue<T, COMPARE, ARITY>* queue)
 {
     if (queue->array.count <= 0)
     {
@@ -60,41 +346,246 @@ priority_queue_pop(Priority_Queue<T>* queue)
         return T{};
     }
 
-    // Unordered remove
-    DynArray<T>& array = queue->array;
-    T result = RemoveUnorderedAt(&array, 0);
+    T result = queue->array.items[0];
+    PRIORITY_QUEUE::remove_at<ARITY>(queue, 0);
+    return result;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function void
+priority_queue_clear(Priority_Queue<T, COMPARE, ARITY>* queue, bool shouldFreeMemory=false)
+{
+    Clear(&queue->array, shouldFreeMemory);
+}
+
+
+
+// --- Indexed_Priority_Queue
+
+template <typename T>
+function Indexed_Priority_Queue<T>
+indexed_priority_queue_create(
+    Memory_Region memory,
+    int (*compare)(T const& a, T const& b))
+{
+    Indexed_Priority_Queue<T> result;
+    result.array = DynArray<typename Indexed_Priority_Queue<T>::Entry>(memory);
+    result.sparse = DynArray<Slot_Map_Sparse>(memory);
+    result.free_head = SLOT_MAP::NIL_INDEX;
+    result.compare = compare;
+    return result;
+}
+
+// Comparator fixed at compile time
+template <typename T, typename COMPARE, int ARITY = 2>
+function Indexed_Priority_Queue<T, COMPARE, ARITY>
+indexed_priority_queue_create(Memory_Region memory)
+{
+    Indexed_Priority_Queue<T, COMPARE, ARITY> result;
+    result.array = DynArray<typename Indexed_Priority_Queue<T, COMPARE, ARITY>::Entry>(memory);
+    result.sparse = DynArray<Slot_Map_Sparse>(memory);
+    result.free_head = SLOT_MAP::NIL_INDEX;
+    result.compare = nullptr;
+    return result;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function bool
+priority_queue_is_empty(Indexed_Priority_Queue<T, COMPARE, ARITY> const& queue)
+{
+    bool result = array_is_empty(queue.array);
+    return result;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function int
+priority_queue_count(Indexed_Priority_Queue<T, COMPARE, ARITY> const& queue)
+{
+    return queue.array.count;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function T*
+priority_queue_peek(Indexed_Priority_Queue<T, COMPARE, ARITY> const& queue)
+{
+    T* result = (queue.array.count > 0) ? &queue.array.items[0].item : nullptr;
+    return result;
+}
+
+// Returns nullptr if the handle is nil, stale, or its item was popped. Don't change the item's priority
+//  through the pointer, use priority_queue_update(..).
+template <typename T, typename COMPARE, int ARITY>
+function T const*
+priority_queue_get(Indexed_Priority_Queue<T, COMPARE, ARITY> const& queue, Slot_Handle handle)
+{
+    if (handle.index >= (u32)queue.sparse.count)
+        return nullptr;
+
+    Slot_Map_Sparse sparse = queue.sparse[handle.index];
+    if (sparse.generation != handle.generation)
+        return nullptr;
+
+    T const* result = &queue.array.items[sparse.dense_index].item;
+    return result;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function bool
+priority_queue_contains(Indexed_Priority_Queue<T, COMPARE, ARITY> const& queue, Slot_Handle handle)
+{
+    bool result = (priority_queue_get(queue, handle) != nullptr);
+    return result;
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function Slot_Handle
+priority_queue_insert(Indexed_Priority_Queue<T, COMPARE, ARITY>* queue, T const& item)
+{
+    using Entry = typename Indexed_Priority_Queue<T, COMPARE, ARITY>::Entry;
+
+    u32 sparse_index = queue->free_head;
+    if (sparse_index != SLOT_MAP::NIL_INDEX)
+    {
+        queue->free_head = queue->sparse[sparse_index].dense_index;
+    }
+    else
+    {
+        sparse_index = queue->sparse.count;
+
+        Slot_Map_Sparse* sparse = array_append_new(&queue->sparse);
+        sparse->generation = 1;
+    }
+
+    Entry entry = { item, sparse_index };
+    array_append_new(&queue->array);
+    PRIORITY_QUEUE::sift_up<ARITY>(queue, queue->array.count - 1, entry);
 
-    // Heapify "down"
-    if (array.count > 1)
+    Slot_Handle result;
+    result.index = sparse_index;
+    result.generation = queue->sparse[sparse_index].generation;
+    return result;
+}
+
+// Writes a handle per item to handles_out, if it isn't null. Rebuilds the heap in O(n) if the items are a
+//  big part of the result.
+template <typename T, typename COMPARE, int ARITY>
+function void
+priority_queue_insert_bulk(Indexed_Priority_Queue<T, COMPARE, ARITY>* queue, Slice<T> items, Slot_Handle* handles_out=nullptr)
+{
+    using Entry = typename Indexed_Priority_Queue<T, COMPARE, ARITY>::Entry;
+
+    int old_count = queue->array.count;
+    if (items.count < old_count / 4)
     {
-        int index = 0;
-        while (true)
+        for (int i = 0; i < items.count; i++)
         {
-            int left_index = 2 * index + 1;
-            int right_index = 2 * index + 2;
-            int smallest_index = index;
-
-            if (left_index < array.count &&
-                queue->compare(array[left_index], array[smallest_index]) < 0)
+            Slot_Handle handle = priority_queue_insert(queue, items[i]);
+            if (handles_out)
             {
-                smallest_index = left_index;
+                handles_out[i] = handle;
             }
+        }
 
-            if (right_index < array.count &&
-                queue->compare(array[right_index], array[smallest_index]) < 0)
-            {
-                smallest_index = right_index;
-            }
+        return;
+    }
 
-            if (smallest_index == index)
-            {
-                break;
-            }
+    EnsureCapacity(&queue->array, old_count + items.count);
+    for (int i = 0; i < items.count; i++)
+    {
+        u32 sparse_index = queue->free_head;
+        if (sparse_index != SLOT_MAP::NIL_INDEX)
+        {
+            queue->free_head = queue->sparse[sparse_index].dense_index;
+        }
+        else
+        {
+            sparse_index = queue->sparse.count;
 
-            mem_swap(array + index, array + smallest_index);
-            index = smallest_index;
+            Slot_Map_Sparse* sparse = array_append_new(&queue->sparse);
+            sparse->generation = 1;
+        }
+
+        Entry entry = { items[i], sparse_index };
+        queue->array.count++;
+        PRIORITY_QUEUE::entry_place(queue, queue->array.count - 1, entry);
+
+        if (handles_out)
+        {
+            handles_out[i].index = sparse_index;
+            handles_out[i].generation = queue->sparse[sparse_index].generation;
         }
     }
 
+    PRIORITY_QUEUE::heapify<ARITY>(queue);
+}
+
+template <typename T, typename COMPARE, int ARITY>
+function T
+priority_queue_pop(Indexed_Priority_Queue<T, COMPARE, ARITY>* queue)
+{
+    if (queue->array.count <= 0)
+    {
+        ASSERT_FALSE;
+        return T{};
+    }
+
+    T result = queue->array.items[0].item;
+    MEM::slot_map_sparse_free(&queue->sparse, &queue->free_head, queue->array.items[0].sparse_index);
+    PRIORITY_QUEUE::remove_at<ARITY>(queue, 0);
     return result;
 }
+
+// Replaces the handle's item, and moves it to its new place in the heap (e.g. decrease-key). Returns false if
+//  the handle is nil, stale, or its item was popped.
+template <typename T, typename COMPARE, int ARITY>
+function bool
+priority_queue_update(Indexed_Priority_Queue<T, COMPARE, ARITY>* queue, Slot_Handle handle, T const& item)
+{
+    using Entry = typename Indexed_Priority_Queue<T, COMPARE, ARITY>::Entry;
+
+    if (!priority_queue_contains(*queue, handle))
+        return false;
+
+    int index = (int)queue->sparse[handle.index].dense_index;
+    Entry entry = { item, handle.index };
+    PRIORITY_QUEUE::sift<ARITY>(queue, index, entry);
+    return true;
+}
+
+// Returns false if the handle is nil, stale, or its item was popped
+template <typename T, typename COMPARE, int ARITY>
+function bool
+priority_queue_remove(Indexed_Priority_Queue<T, COMPARE, ARITY>* queue, Slot_Handle handle)
+{
+    if (!priority_queue_contains(*queue, handle))
+        return false;
+
+    int index = (int)queue->sparse[handle.index].dense_index;
+    MEM::slot_map_sparse_free(&queue->sparse, &queue->free_head, handle.index);
+    PRIORITY_QUEUE::remove_at<ARITY>(queue, index);
+    return true;
+}
+
+// Removes every item. All outstanding handles become stale.
+//  shouldFreeMemory also frees the sparse index, which resets generations, so old handles can look valid
+//  again once their slots are reused. Only use it when no old handles will be looked up again, e.g. when
+//  you're done with the queue.
+template <typename T, typename COMPARE, int ARITY>
+function void
+priority_queue_clear(Indexed_Priority_Queue<T, COMPARE, ARITY>* queue, bool shouldFreeMemory=false)
+{
+    if (shouldFreeMemory)
+    {
+        Clear(&queue->array, true /* shouldFreeMemory */);
+        Clear(&queue->sparse, true /* shouldFreeMemory */);
+        queue->free_head = SLOT_MAP::NIL_INDEX;
+        return;
+    }
+
+    for (int i = 0; i < queue->array.count; i++)
+    {
+        MEM::slot_map_sparse_free(&queue->sparse, &queue->free_head, queue->array.items[i].sparse_index);
+    }
+
+    Clear(&queue->array);
+}
@@ -0,0 +1,240 @@
+// --- Slot_Map
+//  Pool of items addressed by generational handles instead of pointers.
+//  Items are stored densely, so iterating the live set is a linear walk over an array. A sparse index maps
+//  each handle to its item's dense slot, and a generation counter per sparse slot detects stale handles:
+//  once an item is removed, lookups with any handle to it return nullptr, even after the slot is reused.
+//  Insert, remove, and lookup are all O(1).
+//
+//  Removal moves the last item into the hole, so pointers into the map (and dense order) aren't stable
+//  across removes. Hold on to handles, not pointers.
+//
+//  usage:
+//      Slot_Map<Entity> entities = Slot_Map<Entity>(memory);
+//      Slot_Handle handle = slot_map_insert(&entities, entity);
+//      if (Entity* e = slot_map_get(entities, handle)) { ... }
+//      for (Entity& e : entities) { ... }
+//      slot_map_remove(&entities, handle);
+
+namespace SLOT_MAP
+{
+static constexpr u32 NIL_INDEX = U32::MAX;
+}
+
+struct Slot_Handle
+{
+    u32 index;          // Into the sparse array
+    u32 generation;     // Never 0, so a zeroed handle is nil
+};
+
+function bool
+operator==(Slot_Handle a, Slot_Handle b)
+{
+    bool result = (a.index == b.index && a.generation == b.generation);
+    return result;
+}
+
+function bool
+operator!=(Slot_Handle a, Slot_Handle b)
+{
+    return !(a == b);
+}
+
+function bool
+slot_handle_is_nil(Slot_Handle handle)
+{
+    bool result = (handle.generation == 0);
+    return result;
+}
+
+struct Slot_Map_Sparse
+{
+    u32 generation;     // Bumped on remove, which invalidates every outstanding handle to this slot
+    u32 dense_index;    // ... or the next free sparse slot, when this one is free
+};
+
+template <typename T>
+struct Slot_Map
+{
+    DynArray<T> items;                      // Dense. Only live items.
+    DynArray<u32> dense_to_sparse;          // Parallel to items
+    DynArray<Slot_Map_Sparse> sparse;
+    u32 free_head;                          // Free list through Slot_Map_Sparse::dense_index
+
+    Slot_Map<T>() = default;
+    explicit Slot_Map<T>(Memory_Region memory)
+    {
+        *this = {};
+        items = DynArray<T>(memory);
+        dense_to_sparse = DynArray<u32>(memory);
+        sparse = DynArray<Slot_Map_Sparse>(memory);
+        free_head = SLOT_MAP::NIL_INDEX;
+    }
+
+    T* begin() const { return items.begin(); }
+    T* end() const { return items.end(); }
+};
+
+template <typename T>
+function int
+slot_map_count(Slot_Map<T> const& map)
+{
+    return map.items.count;
+}
+
+template <typename T>
+function void
+slot_map_reserve(Slot_Map<T>* map, int capacity)
+{
+    EnsureCapacity(&map->items, capacity);
+    EnsureCapacity(&map->dense_to_sparse, capacity);
+    EnsureCapacity(&map->sparse, capacity);
+}
+
+// Result is uninitialized
+template <typename T>
+function T*
+slot_map_insert_new(Slot_Map<T>* map, Slot_Handle* handle_out)
+{
+    u32 sparse_index = map->free_head;
+    if (sparse_index != SLOT_MAP::NIL_INDEX)
+    {
+        map->free_head = map->sparse[sparse_index].dense_index;
+    }
+    else
+    {
+        sparse_index = map->sparse.count;
+
+        Slot_Map_Sparse* sparse = array_append_new(&map->sparse);
+        sparse->generation = 1;
+    }
+
+    Slot_Map_Sparse* sparse = map->sparse + sparse_index;
+    sparse->dense_index = map->items.count;
+
+    Append(&map->dense_to_sparse, sparse_index);
+    T* result = array_append_new(&map->items);
+
+    handle_out->index = sparse_index;
+    handle_out->generation = sparse->generation;
+    return result;
+}
+
+template <typename T>
+function Slot_Handle
+slot_map_insert(Slot_Map<T>* map, T const& item)
+{
+    Slot_Handle result;
+    T* slot = slot_map_insert_new(map, &result);
+    *slot = item;
+    return result;
+}
+
+// Returns nullptr if the handle is nil or stale
+template <typename T>
+function T*
+slot_map_get(Slot_Map<T> const& map, Slot_Handle handle)
+{
+    if (handle.index >= (u32)map.sparse.count)
+        return nullptr;
+
+    Slot_Map_Sparse sparse = map.sparse[handle.index];
+    if (sparse.generation != handle.generation)
+        return nullptr;
+
+    T* result = map.items + sparse.dense_index;
+    return result;
+}
+
+template <typename T>
+function bool
+slot_map_contains(Slot_Map<T> const& map, Slot_Handle handle)
+{
+    bool result = (slot_map_get(map, handle) != nullptr);
+    return result;
+}
+
+// Handle of the item at a dense index, for when iterating items needs to know their handles
+template <typename T>
+function Slot_Handle
+slot_map_handle_at(Slot_Map<T> const& map, int dense_index)
+{
+    ASSERT(dense_index >= 0 && dense_index < map.items.count);
+
+    u32 sparse_index = map.dense_to_sparse[dense_index];
+
+    Slot_Handle result;
+    result.index = sparse_index;
+    result.generation = map.sparse[sparse_index].generation;
+    return result;
+}
+
+namespace MEM
+{
+
+function void
+slot_map_sparse_free(DynArray<Slot_Map_Sparse>* sparse, u32* free_head, u32 sparse_index)
+{
+    Slot_Map_Sparse* slot = *sparse + sparse_index;
+
+    slot->generation++;
+    if (slot->generation == 0)
+    {
+        // Wrapped. Skip 0 so nil handles stay invalid.
+        slot->generation = 1;
+    }
+
+    slot->dense_index = *free_head;
+    *free_head = sparse_index;
+}
+
+} // namespace MEM
+
+// Returns false if the handle is nil or stale
+template <typename T>
+function bool
+slot_map_remove(Slot_Map<T>* map, Slot_Handle handle)
+{
+    if (!slot_map_get(*map, handle))
+        return false;
+
+    u32 dense_index = map->sparse[handle.index].dense_index;
+    u32 dense_index_last = map->items.count - 1;
+
+    // Move the last item into the hole, and repoint its sparse slot
+    if (dense_index != dense_index_last)
+    {
+        u32 sparse_index_last = map->dense_to_sparse[dense_index_last];
+        map->sparse[sparse_index_last].dense_index = dense_index;
+    }
+
+    RemoveUnorderedAt(&map->items, dense_index);
+    RemoveUnorderedAt(&map->dense_to_sparse, dense_index);
+
+    MEM::slot_map_sparse_free(&map->sparse, &map->free_head, handle.index);
+    return true;
+}
+
+// Removes every item. All outstanding handles become stale.
+//  shouldFreeMemory also frees the sparse index, which resets generations, so only use it when no old
+//  handles will be looked up again.
+template <typename T>
+function void
+slot_map_clear(Slot_Map<T>* map, bool shouldFreeMemory=false)
+{
+    if (shouldFreeMemory)
+    {
+        Clear(&map->items, true);
+        Clear(&map->dense_to_sparse, true);
+        Clear(&map->sparse, true);
+        map->free_head = SLOT_MAP::NIL_INDEX;
+        return;
+    }
+
+    for (u32 sparse_index : map->dense_to_sparse)
+    {
+        MEM::slot_map_sparse_free(&map->sparse, &map->free_head, sparse_index);
+    }
+
+    Clear(&map->items);
+    Clear(&map->dense_to_sparse);
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+// --- Atomics
+//  Thin wrappers over compiler intrinsics. All read-modify-write operations are full barriers.
+
+#if COMPILER_MSVC
+ #include <intrin.h>
+#endif
+
+inline void
+cpu_pause()
+{
+    _mm_pause();
+}
+
+inline u32
+atomic_load(u32 volatile* value)
+{
+#if COMPILER_MSVC
+    u32 result = *value;
+    _ReadWriteBarrier();
+    return result;
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+inline u64
+atomic_load(u64 volatile* value)
+{
+#if COMPILER_MSVC
+    u64 result = *value;
+    _ReadWriteBarrier();
+    return result;
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+template <typename T>
+inline T*
+atomic_load(T* volatile* value)
+{
+#if COMPILER_MSVC
+    T* result = *value;
+    _ReadWriteBarrier();
+    return result;
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+inline void
+atomic_store(u32 volatile* value, u32 new_value)
+{
+#if COMPILER_MSVC
+    _ReadWriteBarrier();
+    *value = new_value;
+#else
+    __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+inline void
+atomic_store(u64 volatile* value, u64 new_value)
+{
+#if COMPILER_MSVC
+    _ReadWriteBarrier();
+    *value = new_value;
+#else
+    __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+template <typename T>
+inline void
+atomic_store(T* volatile* value, T* new_value)
+{
+#if COMPILER_MSVC
+    _ReadWriteBarrier();
+    *value = new_value;
+#else
+    __atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+// Returns the previous value
+inline u32
+atomic_exchange(u32 volatile* value, u32 new_value)
+{
+#if COMPILER_MSVC
+    return (u32)_InterlockedExchange((long volatile*)value, (long)new_value);
+#else
+    return __atomic_exchange_n(value, new_value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+inline u64
+atomic_exchange(u64 volatile* value, u64 new_value)
+{
+#if COMPILER_MSVC
+    return (u64)_InterlockedExchange64((__int64 volatile*)value, (__int64)new_value);
+#else
+    return __atomic_exchange_n(value, new_value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+template <typename T>
+inline T*
+atomic_exchange(T* volatile* value, T* new_value)
+{
+#if COMPILER_MSVC
+    return (T*)_InterlockedExchangePointer((void* volatile*)value, (void*)new_value);
+#else
+    return __atomic_exchange_n(value, new_value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Returns true if the value was expected, and was replaced with desired
+inline bool
+atomic_compare_exchange(u32 volatile* value, u32 expected, u32 desired)
+{
+#if COMPILER_MSVC
+    return (u32)_InterlockedCompareExchange((long volatile*)value, (long)desired, (long)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+inline bool
+atomic_compare_exchange(u64 volatile* value, u64 expected, u64 desired)
+{
+#if COMPILER_MSVC
+    return (u64)_InterlockedCompareExchange64((__int64 volatile*)value, (__int64)desired, (__int64)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+template <typename T>
+inline bool
+atomic_compare_exchange(T* volatile* value, T* expected, T* desired)
+{
+#if COMPILER_MSVC
+    return (T*)_InterlockedCompareExchangePointer((void* volatile*)value, (void*)desired, (void*)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Returns the previous value
+inline u32
+atomic_add(u32 volatile* value, u32 addend)
+{
+#if COMPILER_MSVC
+    return (u32)_InterlockedExchangeAdd((long volatile*)value, (long)addend);
+#else
+    return __atomic_fetch_add(value, addend, __ATOMIC_SEQ_CST);
+#endif
+}
+
+inline u64
+atomic_add(u64 volatile* value, u64 addend)
+{
+#if COMPILER_MSVC
+    return (u64)_InterlockedExchangeAdd64((__int64 volatile*)value, (__int64)addend);
+#else
+    return __atomic_fetch_add(value, addend, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Loads before the fence can't be reordered after loads that follow it. For seqlock-style readers, which
+//  read some data and then re-check a sequence count to see if it was torn.
+inline void
+atomic_fence_acquire()
+{
+#if COMPILER_MSVC
+    _ReadWriteBarrier();    // x64 never reorders loads with other loads, so only the compiler needs stopping
+#else
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+#endif
+}
+
+
+
+// --- Spin lock
+//  Only suitable for short critical sections.
+
+struct Spin_Lock
+{
+    u32 volatile locked;
+};
+
+inline void
+spin_lock_acquire(Spin_Lock* lock)
+{
+    while (atomic_exchange(&lock->locked, 1u) != 0)
+    {
+        // Spin on a plain load so we aren't hammering the cache line with writes
+        while (atomic_load(&lock->locked) != 0)
+        {
+            cpu_pause();
+        }
+    }
+}
+
+inline bool
+spin_lock_try_acquire(Spin_Lock* lock)
+{
+    bool result = (atomic_exchange(&lock->locked, 1u) == 0);
+    return result;
+}
+
+inline void
+spin_lock_release(Spin_Lock* lock)
+{
+    ASSERT(atomic_load(&lock->locked));
+    atomic_store(&lock->locked, 0u);
+}
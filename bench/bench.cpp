@@ -0,0 +1,81 @@
+// Micro-benchmarks. Build optimized, and compare builds with different compile-time options,
+//  e.g. -DMEM_COMPACT_HEADER_ENABLE=0 vs -DMEM_COMPACT_HEADER_ENABLE=1
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "../core.h"
+#include "../thread_linux.h"
+
+
+//
+// Convenience utilities for benchmarks
+//
+
+double
+BenchSeconds()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration<double>(now).count();
+}
+
+// Cheap deterministic random numbers, so every build sees the same workload
+struct BenchRng
+{
+    u64 state;
+};
+
+u32
+BenchRandom(BenchRng * rng)
+{
+    rng->state = rng->state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (u32)(rng->state >> 33);
+}
+
+#define BenchReport(NAME, SECONDS, COUNT) printf("  %-44s %8.2f ns/op\n", NAME, (SECONDS) * 1e9 / (double)(COUNT))
+
+void* BenchSystemAllocate(uintptr cBytes) { return malloc(cBytes); }
+void* BenchSystemReallocate(void * bytes, uintptr cBytes) { return realloc(bytes, cBytes); }
+void BenchSystemFree(void * bytes) { free(bytes); }
+
+#include "mem.cpp"
+#include "mem_util.cpp"
+#include "dict.cpp"
+#include "hash.cpp"
+#include "sort.cpp"
+
+int main()
+{
+    MEM::system_allocate = BenchSystemAllocate;
+    MEM::system_reallocate = BenchSystemReallocate;
+    MEM::system_free = BenchSystemFree;
+    thread_linux_install();
+
+#define RunBench(BENCH) printf("%s\n", #BENCH); BENCH();
+
+    RunBench(BenchMemoryTrackedOverhead);
+    RunBench(BenchMemoryTrackedThroughput);
+    RunBench(BenchConcurrentRegion);
+    RunBench(BenchMemoryCopySet);
+    RunBench(BenchDictFind);
+    RunBench(BenchDictChurn);
+    RunBench(BenchDictResizeLatency);
+    RunBench(BenchDictFindBatch);
+    RunBench(BenchConcurrentDictRead);
+    RunBench(BenchStaticDictFind);
+    RunBench(BenchHashThroughput);
+    RunBench(BenchHashDistribution);
+    RunBench(BenchSort);
+    RunBench(BenchParallelSort);
+    RunBench(BenchSortedSearch);
+    RunBench(BenchKWayMerge);
+    RunBench(BenchPriorityQueue);
+
+#undef RunBench
+
+    return 0;
+}
@@ -0,0 +1,456 @@
+template <typename DICT>
+void
+BenchDictFindOne(char const * name, DICT * dict, u32 const * keys, int cKey)
+{
+    double secondsStart = BenchSeconds();
+    for (int i = 0; i < cKey; i++)
+    {
+        dict_set(dict, keys[i], (u32)i);
+    }
+    double secondsInsert = BenchSeconds() - secondsStart;
+
+    int const cLookup = 4000000;
+    BenchRng rng = { 7 };
+
+    u32 sum = 0;
+    secondsStart = BenchSeconds();
+    for (int i = 0; i < cLookup; i++)
+    {
+        u32 * value = dict_find_ptr(*dict, keys[BenchRandom(&rng) % cKey]);
+        sum += *value;
+    }
+    double secondsHit = BenchSeconds() - secondsStart;
+
+    // Odd keys were never inserted
+    secondsStart = BenchSeconds();
+    for (int i = 0; i < cLookup; i++)
+    {
+        sum += dict_contains(*dict, BenchRandom(&rng) | 1) ? 1 : 0;
+    }
+    double secondsMiss = BenchSeconds() - secondsStart;
+
+    printf("  %-15s %9d keys: insert %6.2f ns, hit %6.2f ns, miss %6.2f ns (checksum %u)\n",
+        name,
+        cKey,
+        secondsInsert * 1e9 / cKey,
+        secondsHit * 1e9 / cLookup,
+        secondsMiss * 1e9 / cLookup,
+        sum);
+}
+
+void
+BenchDictFind()
+{
+    int const sizes[] = { 1000, 100000, 1000000, 10000000 };
+    for (int cKey : sizes)
+    {
+        u32 * keys = new u32[cKey];
+        BenchRng rng = { 3 };
+        for (int i = 0; i < cKey; i++)
+        {
+            keys[i] = BenchRandom(&rng) & ~1u;
+        }
+
+        {
+            Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+            Dict<u32, u32> dict = dict_create<u32, u32>(memory, u32_hash, u32_eq);
+            BenchDictFindOne("Dict", &dict, keys, cKey);
+            mem_region_end(memory);
+        }
+
+        {
+            // Same table, but hash / eq inline instead of going through function pointers
+            Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+            Dict<u32, u32, U32_Hasher, U32_Eq> dict = dict_create<u32, u32, U32_Hasher, U32_Eq>(memory);
+            BenchDictFindOne("Dict (policy)", &dict, keys, cKey);
+            mem_region_end(memory);
+        }
+
+        {
+            Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+            Swiss_Dict<u32, u32> dict = swiss_dict_create<u32, u32>(memory, u32_hash, u32_eq);
+            BenchDictFindOne("Swiss_Dict", &dict, keys, cKey);
+            mem_region_end(memory);
+        }
+
+        {
+            Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+            Robin_Hood_Dict<u32, u32> dict = robin_hood_dict_create<u32, u32>(memory, u32_hash, u32_eq);
+            BenchDictFindOne("Robin_Hood_Dict", &dict, keys, cKey);
+            mem_region_end(memory);
+        }
+
+        delete[] keys;
+    }
+}
+
+// Sliding window of live keys: every step removes the oldest key and adds a new one. Then looks up every
+//  live key, which is where leftover tombstones hurt.
+template <typename DICT>
+void
+BenchDictChurnOne(char const * name, DICT * dict)
+{
+    int const cLive = 100000;
+    int const cStep = 4000000;
+
+    for (u32 key = 0; key < cLive; key++)
+    {
+        dict_set(dict, key, key);
+    }
+
+    double secondsStart = BenchSeconds();
+    for (u32 key = 0; key < cStep; key++)
+    {
+        dict_remove(dict, key);
+        dict_set(dict, key + cLive, key);
+    }
+    double secondsChurn = BenchSeconds() - secondsStart;
+
+    u32 sum = 0;
+    secondsStart = BenchSeconds();
+    for (int i = 0; i < 20; i++)
+    {
+        for (u32 key = cStep; key < cStep + cLive; key++)
+        {
+            sum += *dict_find_ptr(*dict, key);
+        }
+    }
+    double secondsLookup = BenchSeconds() - secondsStart;
+
+    printf("  %-15s remove + set %6.2f ns, then hit %6.2f ns, capacity %8d (checksum %u)\n",
+        name,
+        secondsChurn * 1e9 / cStep,
+        secondsLookup * 1e9 / (20.0 * cLive),
+        dict->capacity,
+        sum);
+}
+
+void
+BenchDictChurn()
+{
+    {
+        Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+        Dict<u32, u32> dict = dict_create<u32, u32>(memory, u32_hash, u32_eq);
+        BenchDictChurnOne("Dict", &dict);
+        mem_region_end(memory);
+    }
+
+    {
+        Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+        Swiss_Dict<u32, u32> dict = swiss_dict_create<u32, u32>(memory, u32_hash, u32_eq);
+        BenchDictChurnOne("Swiss_Dict", &dict);
+        mem_region_end(memory);
+    }
+
+    {
+        Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+        Robin_Hood_Dict<u32, u32> dict = robin_hood_dict_create<u32, u32>(memory, u32_hash, u32_eq);
+        BenchDictChurnOne("Robin_Hood_Dict", &dict);
+
+        Robin_Hood_Dict_Stats stats = robin_hood_dict_stats(dict);
+        printf("  %-15s probe length mean %.2f, max %d\n", "", stats.probe_length_mean, stats.probe_length_max);
+
+        mem_region_end(memory);
+    }
+}
+
+// Slowest single insert while growing to 4M keys, which is a full resize unless it's spread out
+void
+BenchDictResizeLatency()
+{
+    int const cKey = 4000000;
+    i32 const stepCounts[] = { 0, 16, 64 };
+    for (i32 stepCount : stepCounts)
+    {
+        Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+        Dict<u32, u32> dict = dict_create<u32, u32>(memory, u32_hash, u32_eq);
+        dict.resize_step_count = stepCount;
+
+        double secondsWorst = 0;
+        double secondsStart = BenchSeconds();
+        for (u32 key = 0; key < cKey; key++)
+        {
+            double secondsInsert = BenchSeconds();
+            dict_set(&dict, key, key);
+            secondsWorst = max(secondsWorst, BenchSeconds() - secondsInsert);
+        }
+        double secondsTotal = BenchSeconds() - secondsStart;
+
+        printf("  resize_step_count %2d: insert %6.2f ns avg, slowest %10.0f ns\n",
+            (int)stepCount,
+            secondsTotal * 1e9 / cKey,
+            secondsWorst * 1e9);
+
+        mem_region_end(memory);
+    }
+}
+
+// Resolving many keys at once: a loop of single finds vs. dict_find_batch(..), which overlaps their cache misses.
+//  The biggest table is larger than the last level cache.
+void
+BenchDictFindBatch()
+{
+    int const sizes[] = { 65536, 1000000, 16000000 };
+    int const cLookup = 4000000;
+    int const cBatch = 1024;
+
+    u32 * lookups = new u32[cLookup];
+    u32 ** values = new u32 *[cBatch];
+
+    for (int cKey : sizes)
+    {
+        Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+        Dict<u32, u32> dict = dict_create<u32, u32>(memory, u32_hash, u32_eq);
+        for (int i = 0; i < cKey; i++)
+        {
+            dict_set(&dict, (u32)i * 2, (u32)i);
+        }
+
+        // Three quarters hits
+        BenchRng rng = { 13 };
+        for (int i = 0; i < cLookup; i++)
+        {
+            u32 key = BenchRandom(&rng) % cKey;
+            lookups[i] = key * 2 + ((i % 4 == 3) ? 1 : 0);
+        }
+
+        u32 sum = 0;
+        double secondsStart = BenchSeconds();
+        for (int i = 0; i < cLookup; i++)
+        {
+            u32 * value = dict_find_ptr(dict, lookups[i]);
+            sum += (value) ? *value : 0;
+        }
+        double secondsSingle = BenchSeconds() - secondsStart;
+
+        u32 sumBatch = 0;
+        secondsStart = BenchSeconds();
+        for (int iStart = 0; iStart < cLookup; iStart += cBatch)
+        {
+            dict_find_batch(dict, slice_create(lookups + iStart, cBatch), slice_create(values, cBatch));
+            for (int i = 0; i < cBatch; i++)
+            {
+                sumBatch += (values[i]) ? *values[i] : 0;
+            }
+        }
+        double secondsBatch = BenchSeconds() - secondsStart;
+
+        printf("  %9d keys: single %6.2f ns, batch %6.2f ns (%s)\n",
+            cKey,
+            secondsSingle * 1e9 / cLookup,
+            secondsBatch * 1e9 / cLookup,
+            (sum == sumBatch) ? "match" : "MISMATCH");
+
+        mem_region_end(memory);
+    }
+
+    delete[] lookups;
+    delete[] values;
+}
+
+// Read-mostly sharing: N reader threads doing lookups while one writer keeps overwriting values, for a Dict
+//  behind one Spin_Lock vs. a Concurrent_Dict. Reports total lookups per second across the readers, so
+//  flat means readers scale, and falling means they contend. Only meaningful with as many cores as threads.
+struct BenchConcurrentShared
+{
+    Spin_Lock lock;
+    Dict<u32, u32> dict;
+    Concurrent_Dict<u32, u32, U32_Hasher, U32_Eq> * concurrent;
+    bool useConcurrent;
+    u32 volatile stop;
+    u32 volatile sink;
+};
+
+void
+BenchConcurrentDictReader(BenchConcurrentShared * shared, int cKey, u32 seed, u64 * cLookupOut)
+{
+    Concurrent_Dict_Reader * reader = (shared->useConcurrent) ? concurrent_dict_attach(shared->concurrent) : nullptr;
+
+    BenchRng rng = { seed };
+    u64 cLookup = 0;
+    u32 sum = 0;
+    while (!atomic_load(&shared->stop))
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            u32 key = BenchRandom(&rng) % cKey;
+            u32 value = 0;
+            if (shared->useConcurrent)
+            {
+                concurrent_dict_find(shared->concurrent, reader, key, &value);
+            }
+            else
+            {
+                spin_lock_acquire(&shared->lock);
+                value = dict_find(shared->dict, key);
+                spin_lock_release(&shared->lock);
+            }
+            sum += value;
+        }
+        cLookup += 256;
+    }
+
+    if (reader) concurrent_dict_detach(reader);
+    *cLookupOut = cLookup;
+    shared->sink = sum;     // Keeps the lookups from being optimized out
+}
+
+void
+BenchConcurrentDictWriter(BenchConcurrentShared * shared, int cKey)
+{
+    BenchRng rng = { 17 };
+    while (!atomic_load(&shared->stop))
+    {
+        u32 key = BenchRandom(&rng) % cKey;
+        if (shared->useConcurrent)
+        {
+            concurrent_dict_set(shared->concurrent, key, key + 1);
+        }
+        else
+        {
+            spin_lock_acquire(&shared->lock);
+            dict_set(&shared->dict, key, key + 1);
+            spin_lock_release(&shared->lock);
+        }
+
+        // Read-mostly: roughly one write per thousand reads
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+}
+
+void
+BenchConcurrentDictRead()
+{
+    int const cKey = 1000000;
+    int const threadCounts[] = { 1, 2, 4, 8 };
+    double const seconds = 0.5;
+
+    printf("  hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    for (int iImpl = 0; iImpl < 2; iImpl++)
+    {
+        Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+
+        BenchConcurrentShared shared = {};
+        shared.useConcurrent = (iImpl == 1);
+        if (shared.useConcurrent)
+        {
+            shared.concurrent = concurrent_dict_create<u32, u32, U32_Hasher, U32_Eq>(memory, cKey);
+            for (int i = 0; i < cKey; i++) concurrent_dict_set(shared.concurrent, (u32)i, (u32)i);
+        }
+        else
+        {
+            shared.dict = dict_create<u32, u32>(memory, u32_hash, u32_eq, cKey);
+            for (int i = 0; i < cKey; i++) dict_set(&shared.dict, (u32)i, (u32)i);
+        }
+
+        for (int cThread : threadCounts)
+        {
+            u64 cLookups[8] = {};
+            std::thread readers[8];
+            atomic_store(&shared.stop, 0u);
+
+            std::thread writer(BenchConcurrentDictWriter, &shared, cKey);
+            for (int i = 0; i < cThread; i++)
+            {
+                readers[i] = std::thread(BenchConcurrentDictReader, &shared, cKey, (u32)i + 1, &cLookups[i]);
+            }
+
+            double secondsStart = BenchSeconds();
+            std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+            atomic_store(&shared.stop, 1u);
+            writer.join();
+            for (int i = 0; i < cThread; i++) readers[i].join();
+            double secondsElapsed = BenchSeconds() - secondsStart;
+
+            u64 cLookup = 0;
+            for (int i = 0; i < cThread; i++) cLookup += cLookups[i];
+
+            printf("  %-28s %d readers: %7.2f M lookups/s\n",
+                (shared.useConcurrent) ? "Concurrent_Dict" : "Dict + Spin_Lock",
+                cThread,
+                cLookup / secondsElapsed / 1e6);
+        }
+
+        if (shared.useConcurrent) concurrent_dict_destroy(shared.concurrent);
+        mem_region_end(memory);
+    }
+}
+
+// Built-once tables: Dict lookups vs. a Static_Dict built from it, which reads one slot per lookup. Also
+//  times building the Static_Dict vs. loading a serialized copy, which is just a read.
+void
+BenchStaticDictFind()
+{
+    int const sizes[] = { 65536, 1000000, 8000000 };
+    int const cLookup = 4000000;
+    u32 * lookups = new u32[cLookup];
+
+    using Static_U32 = Static_Dict<u32, u32, U32_Hasher64, U32_Eq>;
+
+    for (int cKey : sizes)
+    {
+        Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+        Dict<u32, u32, U32_Hasher, U32_Eq> dict = dict_create<u32, u32, U32_Hasher, U32_Eq>(memory);
+        for (int i = 0; i < cKey; i++)
+        {
+            dict_set(&dict, (u32)i * 2, (u32)i);
+        }
+
+        double secondsStart = BenchSeconds();
+        Static_U32 table = static_dict_create<u32, u32, U32_Hasher64, U32_Eq>(memory, dict);
+        double secondsBuild = BenchSeconds() - secondsStart;
+
+        Io_Push_Buffer writer = io_pb_create(memory, (int)STATIC_DICT::table_byte_count(sizeof(Static_U32::Kvp), table.count) + 1024);
+        io_static_dict(&writer.vtable, &table, STR("table"));
+        Slice<u8> bytes = slice_create((u8 *)writer.pb.pages + sizeof(Push_Buffer::Page_Header), (int)writer.pb.lengthPushed);
+
+        secondsStart = BenchSeconds();
+        Io_Slice_Reader reader = io_slice_reader_create(bytes, memory);
+        Static_U32 loaded = {};
+        io_static_dict(&reader.vtable, &loaded, STR("table"));
+        double secondsLoad = BenchSeconds() - secondsStart;
+
+        // Three quarters hits
+        BenchRng rng = { 13 };
+        for (int i = 0; i < cLookup; i++)
+        {
+            u32 key = BenchRandom(&rng) % cKey;
+            lookups[i] = key * 2 + ((i % 4 == 3) ? 1 : 0);
+        }
+
+        u32 sum = 0;
+        secondsStart = BenchSeconds();
+        for (int i = 0; i < cLookup; i++)
+        {
+            u32 * value = dict_find_ptr(dict, lookups[i]);
+            sum += (value) ? *value : 0;
+        }
+        double secondsDict = BenchSeconds() - secondsStart;
+
+        u32 sumStatic = 0;
+        secondsStart = BenchSeconds();
+        for (int i = 0; i < cLookup; i++)
+        {
+            u32 * value = dict_find_ptr(loaded, lookups[i]);
+            sumStatic += (value) ? *value : 0;
+        }
+        double secondsStatic = BenchSeconds() - secondsStart;
+
+        printf("  %8d keys: Dict %6.2f ns, Static_Dict %6.2f ns (%s); %5.2f vs %5.2f bytes/key; build %7.2f ms, load %6.2f ms\n",
+            cKey,
+            secondsDict * 1e9 / cLookup,
+            secondsStatic * 1e9 / cLookup,
+            (sum == sumStatic) ? "match" : "MISMATCH",
+            (double)bytes.count / cKey,
+            (double)dict.capacity * sizeof(Dict<u32, u32>::Kvp) / cKey,
+            secondsBuild * 1e3,
+            secondsLoad * 1e3);
+
+        static_dict_destroy(&loaded);
+        static_dict_destroy(&table);
+        mem_region_end(memory);
+    }
+
+    delete[] lookups;
+}
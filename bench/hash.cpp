@@ -0,0 +1,185 @@
+u32
+BenchHashFnv(void const * bytes, uintptr cBytes)
+{
+    return StartHash(bytes, (int)cBytes);
+}
+
+u32
+BenchHash64(void const * bytes, uintptr cBytes)
+{
+    return (u32)hash64(bytes, cBytes);
+}
+
+u32
+BenchHash64Lowercase(void const * bytes, uintptr cBytes)
+{
+    return (u32)hash64_lowercase(bytes, cBytes);
+}
+
+struct BenchHashFn
+{
+    char const * name;
+    u32 (*hash)(void const * bytes, uintptr cBytes);
+};
+
+BenchHashFn const g_benchHashFns[] = {
+    { "fnv-1a (StartHash)", BenchHashFnv },
+    { "hash64", BenchHash64 },
+    { "hash64_lowercase", BenchHash64Lowercase },
+};
+
+void
+BenchHashThroughput()
+{
+#if !HASH_SIMD_ENABLE
+    printf("  scalar long path\n");
+#endif
+
+    uintptr const cBytesMax = 64 * 1024;
+    u8 * bytes = (u8 *)malloc(cBytesMax + 8);
+    BenchRng rng = { 11 };
+    for (uintptr i = 0; i < cBytesMax + 8; i++)
+    {
+        bytes[i] = (u8)BenchRandom(&rng);
+    }
+
+    uintptr const sizes[] = { 4, 8, 16, 32, 64, 128, 256, 1024, cBytesMax };
+    for (BenchHashFn const & fn : g_benchHashFns)
+    {
+        printf("  %s\n", fn.name);
+        for (uintptr cBytes : sizes)
+        {
+            // Roughly the same total bytes for every size. The offset varies with the previous result, so
+            //  hashes can't overlap, which is the latency a lookup sees.
+            int cRep = (int)max((uintptr)2000, (uintptr)MEGABYTES(256) / cBytes);
+
+            u32 hash = 0;
+            double secondsStart = BenchSeconds();
+            for (int i = 0; i < cRep; i++)
+            {
+                hash = fn.hash(bytes + (hash & 7), cBytes);
+            }
+            double seconds = BenchSeconds() - secondsStart;
+
+            printf("    %6d bytes: %8.2f ns/hash, %6.2f GB/s (checksum %u)\n",
+                (int)cBytes,
+                seconds * 1e9 / cRep,
+                (double)cBytes * cRep / seconds / 1e9,
+                hash);
+        }
+    }
+
+    free(bytes);
+}
+
+int
+BenchCompareU32(void const * a, void const * b)
+{
+    u32 lhs = *(u32 const *)a;
+    u32 rhs = *(u32 const *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+// Quality of the low 32 bits, since that's what Dict keeps:
+//  - Chi-squared of bucket counts over the low 16 bits, for similar keys like "key_123". 1.0 is ideal.
+//  - Full 32 bit collisions, vs. the expected count for a random function.
+//  - Avalanche: flipping one input bit should flip each output bit half the time. Reports the mean output
+//    bits flipped (16 is ideal) and the worst input / output bit pair's bias from 50%. hash64_lowercase
+//    scores worse here by design, since flipping the case bit of a letter isn't supposed to change it.
+void
+BenchHashDistribution()
+{
+    int const cKey = 1000000;
+    int const cBucket = 1 << 16;
+    char (* keys)[16] = (char (*)[16])malloc(cKey * 16);
+    int * keyLengths = (int *)malloc(cKey * sizeof(int));
+    u32 * hashes = (u32 *)malloc(cKey * sizeof(u32));
+    int * buckets = (int *)malloc(cBucket * sizeof(int));
+    for (int i = 0; i < cKey; i++)
+    {
+        keyLengths[i] = snprintf(keys[i], 16, "key_%d", i);
+    }
+
+    int const cSample = 2000;
+    int const inputLengths[] = { 8, 40 };
+    int const cInputBitMax = 40 * 8;
+    int * flipCounts = (int *)malloc(cInputBitMax * 32 * sizeof(int));
+
+    for (BenchHashFn const & fn : g_benchHashFns)
+    {
+        for (int i = 0; i < cBucket; i++) buckets[i] = 0;
+        for (int i = 0; i < cKey; i++)
+        {
+            hashes[i] = fn.hash(keys[i], keyLengths[i]);
+            buckets[hashes[i] & (cBucket - 1)]++;
+        }
+
+        double expected = (double)cKey / cBucket;
+        double chiSquared = 0;
+        for (int i = 0; i < cBucket; i++)
+        {
+            double delta = buckets[i] - expected;
+            chiSquared += delta * delta / expected;
+        }
+
+        qsort(hashes, cKey, sizeof(u32), BenchCompareU32);
+        int cCollision = 0;
+        for (int i = 1; i < cKey; i++)
+        {
+            if (hashes[i] == hashes[i - 1]) cCollision++;
+        }
+        double cCollisionExpected = (double)cKey * (cKey - 1) / 2 / 4294967296.0;
+
+        printf("  %-20s chi^2/df %5.2f, collisions %4d (expect %.0f)\n",
+            fn.name,
+            chiSquared / (cBucket - 1),
+            cCollision,
+            cCollisionExpected);
+
+        for (int cByte : inputLengths)
+        {
+            int cInputBit = cByte * 8;
+            for (int i = 0; i < cInputBit * 32; i++) flipCounts[i] = 0;
+
+            BenchRng rng = { 5 };
+            u8 input[40];
+            u64 cFlippedTotal = 0;
+            for (int iSample = 0; iSample < cSample; iSample++)
+            {
+                for (int i = 0; i < cByte; i++) input[i] = (u8)BenchRandom(&rng);
+                u32 hash = fn.hash(input, cByte);
+
+                for (int iBit = 0; iBit < cInputBit; iBit++)
+                {
+                    input[iBit / 8] ^= (1 << (iBit % 8));
+                    u32 flipped = hash ^ fn.hash(input, cByte);
+                    input[iBit / 8] ^= (1 << (iBit % 8));
+
+                    for (int oBit = 0; oBit < 32; oBit++)
+                    {
+                        u32 isFlipped = (flipped >> oBit) & 1;
+                        flipCounts[iBit * 32 + oBit] += isFlipped;
+                        cFlippedTotal += isFlipped;
+                    }
+                }
+            }
+
+            double biasWorst = 0;
+            for (int i = 0; i < cInputBit * 32; i++)
+            {
+                biasWorst = max(biasWorst, Abs((double)flipCounts[i] / cSample - 0.5));
+            }
+
+            printf("    %2d byte inputs: %5.2f bits flipped per input bit, worst bias %4.1f%%\n",
+                cByte,
+                (double)cFlippedTotal / ((double)cSample * cInputBit),
+                biasWorst * 100);
+        }
+    }
+
+    free(keys);
+    free(keyLengths);
+    free(hashes);
+    free(buckets);
+    free(flipCounts);
+}
@@ -0,0 +1,196 @@
+void
+BenchMemoryTrackedOverhead()
+{
+    printf("  sizeof(Tracked_Block_Header) = %d, sizeof(Free_Block_Header) = %d\n",
+        (int)sizeof(MEM::Tracked_Block_Header),
+        (int)sizeof(MEM::Free_Block_Header));
+
+    // Back-to-back tracked allocations are physically adjacent, so their spacing is the real cost of each one
+    int const cAllocation = 100000;
+    uintptr const sizes[] = { 8, 16, 24, 32, 64, 128 };
+    for (uintptr cBytes : sizes)
+    {
+        Memory_Region memory = mem_region_begin(nullptr, cAllocation * (cBytes + 64));
+
+        u8 * first = (u8 *)allocate_tracked(memory, cBytes);
+        u8 * last = first;
+        for (int i = 1; i < cAllocation; i++)
+        {
+            last = (u8 *)allocate_tracked(memory, cBytes);
+        }
+
+        double cBytesPerAllocation = (double)(last - first) / (cAllocation - 1);
+        printf("  %4d byte allocations: %6.1f bytes each (%5.1f overhead)\n",
+            (int)cBytes,
+            cBytesPerAllocation,
+            cBytesPerAllocation - (double)cBytes);
+
+        mem_region_end(memory);
+    }
+}
+
+void
+BenchMemoryTrackedThroughput()
+{
+    int const cSlot = 4096;
+    int const cOp = 4000000;
+
+    Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(4));
+    void ** slots = new void *[cSlot];
+    for (int i = 0; i < cSlot; i++)
+    {
+        slots[i] = nullptr;
+    }
+
+    // --- Random mix of small allocations and frees, like lots of short-lived Buffers
+
+    BenchRng rng = { 1 };
+    double secondsStart = BenchSeconds();
+    for (int i = 0; i < cOp; i++)
+    {
+        u32 random = BenchRandom(&rng);
+        void ** slot = slots + (random % cSlot);
+        if (*slot)
+        {
+            free_tracked_allocation(memory, *slot);
+            *slot = nullptr;
+        }
+        else
+        {
+            *slot = allocate_tracked(memory, 8 + (random >> 16) % 120);
+        }
+    }
+    BenchReport("allocate_tracked / free (8..128 bytes)", BenchSeconds() - secondsStart, cOp);
+
+    // --- Growing arrays by doubling, like Buffer does
+
+    int const cGrow = 20000;
+    secondsStart = BenchSeconds();
+    for (int i = 0; i < cGrow; i++)
+    {
+        void ** slot = slots + (BenchRandom(&rng) % cSlot);
+        for (uintptr cBytes = 16; cBytes <= 1024; cBytes *= 2)
+        {
+            *slot = reallocate_tracked(memory, *slot, cBytes);
+        }
+    }
+    BenchReport("reallocate_tracked 16 -> 1024, doubling", BenchSeconds() - secondsStart, cGrow * 7);
+
+    delete[] slots;
+    mem_region_end(memory);
+}
+
+struct BenchConcurrentRegionWorker
+{
+    Concurrent_Region * shared;         // Allocates from a Thread_Cache if set...
+    Memory_Region locked;               // ...otherwise from this, under lock
+    Spin_Lock * lock;
+    u64 seed;
+};
+
+int const g_cBenchConcurrentSlot = 4096;
+int const g_cBenchConcurrentOp = 2000000;
+
+void
+BenchConcurrentRegionWorkerProc(void * data)
+{
+    BenchConcurrentRegionWorker * worker = (BenchConcurrentRegionWorker *)data;
+    MEM::Thread_Cache * cache = worker->shared ? concurrent_region_attach(worker->shared) : nullptr;
+
+    void ** slots = (void **)calloc(g_cBenchConcurrentSlot, sizeof(void *));
+
+    // Same mix as BenchMemoryTrackedThroughput, on every thread at once
+    BenchRng rng = { worker->seed };
+    for (int i = 0; i < g_cBenchConcurrentOp; i++)
+    {
+        u32 random = BenchRandom(&rng);
+        void ** slot = slots + (random % g_cBenchConcurrentSlot);
+        uintptr cBytes = 8 + (random >> 16) % 120;
+        if (cache)
+        {
+            if (*slot)
+            {
+                free_tracked_allocation(cache, *slot);
+                *slot = nullptr;
+            }
+            else
+            {
+                *slot = allocate(cache, cBytes);
+            }
+        }
+        else
+        {
+            spin_lock_acquire(worker->lock);
+            if (*slot)
+            {
+                free_tracked_allocation(worker->locked, *slot);
+                *slot = nullptr;
+            }
+            else
+            {
+                *slot = allocate_tracked(worker->locked, cBytes);
+            }
+            spin_lock_release(worker->lock);
+        }
+    }
+
+    free(slots);
+    if (cache)
+    {
+        concurrent_region_detach(cache);
+    }
+}
+
+void
+BenchConcurrentRegion()
+{
+    int cThreadHardware = (int)std::thread::hardware_concurrency();
+    printf("  %d hardware threads\n", cThreadHardware);
+
+    int const cThreadMax = max(8, cThreadHardware);
+    BenchConcurrentRegionWorker * workers = new BenchConcurrentRegionWorker[cThreadMax];
+    void ** threads = new void *[cThreadMax];
+
+    for (int iMode = 0; iMode < 2; iMode++)
+    {
+        bool isConcurrent = (iMode == 0);
+        for (int cThread = 1; cThread <= cThreadMax; cThread *= 2)
+        {
+            Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(4));
+            Concurrent_Region * shared = concurrent_region_begin(memory);
+            Spin_Lock lock = {};
+
+            double secondsStart = BenchSeconds();
+            for (int iThread = 0; iThread < cThread; iThread++)
+            {
+                BenchConcurrentRegionWorker * worker = workers + iThread;
+                worker->shared = isConcurrent ? shared : nullptr;
+                worker->locked = memory;
+                worker->lock = &lock;
+                worker->seed = iThread + 1;
+                threads[iThread] = THREAD::system_thread_create(BenchConcurrentRegionWorkerProc, worker);
+            }
+            for (int iThread = 0; iThread < cThread; iThread++)
+            {
+                THREAD::system_thread_join(threads[iThread]);
+            }
+            double seconds = BenchSeconds() - secondsStart;
+
+            // Half the ops are allocations
+            double cAllocation = 0.5 * g_cBenchConcurrentOp * cThread;
+
+            char name[64];
+            snprintf(name, sizeof(name), "%s x%d (%.1fM allocs/s)",
+                isConcurrent ? "Thread_Cache" : "locked region",
+                cThread,
+                cAllocation / seconds * 1e-6);
+            BenchReport(name, seconds, g_cBenchConcurrentOp * cThread);
+
+            concurrent_region_end(shared);
+            mem_region_end(memory);
+        }
+    }
+
+    delete[] threads;
+    delete[] workers;
+}
@@ -0,0 +1,462 @@
+// Sorting u32s in a few input distributions. Sorted and reversed input is where a naive quicksort goes
+//  quadratic, and few-unique input is where one without an equal-items partition does.
+
+enum class BenchSortInput
+{
+    RANDOM,
+    SORTED,
+    REVERSED,
+    NEARLY_SORTED,      // Sorted, with 1% of the items swapped at random
+    FEW_UNIQUE,         // 16 distinct values
+
+    ENUM_COUNT
+};
+
+char const * const g_benchSortInputNames[] = { "random", "sorted", "reversed", "nearly sorted", "few unique" };
+
+void
+BenchSortFill(u32 * items, int cItem, BenchSortInput input)
+{
+    BenchRng rng = { 19 };
+    for (int i = 0; i < cItem; i++)
+    {
+        switch (input)
+        {
+            case BenchSortInput::RANDOM:        items[i] = BenchRandom(&rng); break;
+            case BenchSortInput::SORTED:        items[i] = (u32)i; break;
+            case BenchSortInput::REVERSED:      items[i] = (u32)(cItem - i); break;
+            case BenchSortInput::NEARLY_SORTED: items[i] = (u32)i; break;
+            case BenchSortInput::FEW_UNIQUE:    items[i] = BenchRandom(&rng) % 16; break;
+            default: ASSERT_FALSE_WARN;
+        }
+    }
+
+    if (input == BenchSortInput::NEARLY_SORTED)
+    {
+        for (int i = 0; i < cItem / 100; i++)
+        {
+            u32 a = BenchRandom(&rng) % cItem;
+            u32 b = BenchRandom(&rng) % cItem;
+            u32 temp = items[a];
+            items[a] = items[b];
+            items[b] = temp;
+        }
+    }
+}
+
+int
+BenchSortQsortCompare(void const * lhs, void const * rhs)
+{
+    return u32_compare(*(u32 const *)lhs, *(u32 const *)rhs);
+}
+
+enum class BenchSortAlgorithm
+{
+    BUBBLE,
+    PDQ,
+    MERGE,
+    RADIX,
+    QSORT,
+
+    ENUM_COUNT
+};
+
+char const * const g_benchSortAlgorithmNames[] = { "BubbleSort", "PdqSort", "MergeSort", "RadixSort", "qsort" };
+
+void
+BenchSortRun(u32 * items, int cItem, BenchSortAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+        case BenchSortAlgorithm::BUBBLE: BubbleSort(items, cItem, u32_compare); break;
+        case BenchSortAlgorithm::PDQ:    PdqSort(items, cItem, u32_compare); break;
+        case BenchSortAlgorithm::MERGE:  MergeSort(items, cItem, u32_compare); break;
+        case BenchSortAlgorithm::RADIX:  RadixSort(slice_create(items, cItem)); break;
+        case BenchSortAlgorithm::QSORT:  qsort(items, cItem, sizeof(u32), BenchSortQsortCompare); break;
+        default: ASSERT_FALSE_WARN;
+    }
+}
+
+void
+BenchSort()
+{
+    // BubbleSort only gets a small input, to show where it stops being an option
+    int const cItemBubble = 4 * 1024;
+    int const cItemMax = 1024 * 1024;
+    u32 * items = (u32 *)malloc(cItemMax * sizeof(u32));
+
+    for (int iInput = 0; iInput < (int)BenchSortInput::ENUM_COUNT; iInput++)
+    {
+        printf("  %s\n", g_benchSortInputNames[iInput]);
+        for (int iAlgorithm = 0; iAlgorithm < (int)BenchSortAlgorithm::ENUM_COUNT; iAlgorithm++)
+        {
+            BenchSortAlgorithm algorithm = (BenchSortAlgorithm)iAlgorithm;
+            int cItem = (algorithm == BenchSortAlgorithm::BUBBLE) ? cItemBubble : cItemMax;
+
+            // Best of a few runs, refilling outside the timed part
+            double secondsBest = 1e9;
+            for (int iRep = 0; iRep < 3; iRep++)
+            {
+                BenchSortFill(items, cItem, (BenchSortInput)iInput);
+
+                double secondsStart = BenchSeconds();
+                BenchSortRun(items, cItem, algorithm);
+                secondsBest = min(secondsBest, BenchSeconds() - secondsStart);
+
+                for (int i = 1; i < cItem; i++)
+                {
+                    ASSERT(items[i - 1] <= items[i]);
+                }
+            }
+
+            char name[64];
+            snprintf(name, sizeof(name), "%s (%d items), per item", g_benchSortAlgorithmNames[iAlgorithm], cItem);
+            BenchReport(name, secondsBest, cItem);
+        }
+    }
+
+    free(items);
+}
+
+// Scaling from 1 thread up. The pool always has thread count - 1 workers, since the calling thread helps.
+void
+BenchParallelSort()
+{
+    int const cItem = 8 * 1024 * 1024;
+    u32 * items = (u32 *)malloc(cItem * sizeof(u32));
+
+    int cThreadHardware = (int)std::thread::hardware_concurrency();
+    printf("  %d hardware threads\n", cThreadHardware);
+
+    double secondsSingle = 0;
+    for (int cThread = 1; cThread <= max(8, cThreadHardware); cThread *= 2)
+    {
+        Thread_Pool * pool = thread_pool_create(nullptr, cThread - 1);
+
+        double secondsBest = 1e9;
+        for (int iRep = 0; iRep < 3; iRep++)
+        {
+            BenchSortFill(items, cItem, BenchSortInput::RANDOM);
+
+            double secondsStart = BenchSeconds();
+            ParallelSort(slice_create(items, cItem), u32_compare, pool);
+            secondsBest = min(secondsBest, BenchSeconds() - secondsStart);
+
+            for (int i = 1; i < cItem; i++)
+            {
+                ASSERT(items[i - 1] <= items[i]);
+            }
+        }
+
+        thread_pool_destroy(pool);
+
+        if (cThread == 1)
+        {
+            secondsSingle = secondsBest;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "%d threads (%.2fx), per item", cThread, secondsSingle / secondsBest);
+        BenchReport(name, secondsBest, cItem);
+    }
+
+    free(items);
+}
+
+// Keeps the optimizer from dropping searches whose results are only checked in ASSERTs
+u64 volatile g_benchSearchSink;
+
+// The classic branchy search BinarySearch used to be, for comparison
+int
+BenchBranchySearch(u32 const * sorted, int cItem, u32 item)
+{
+    int iLow = 0;
+    int iHigh = cItem - 1;
+    while (iHigh >= iLow)
+    {
+        int iCandidate = (iLow + iHigh) / 2;
+        int compareResult = u32_compare(item, sorted[iCandidate]);
+        if (compareResult == 0)
+            return iCandidate;
+
+        if (compareResult > 0)
+        {
+            iLow = iCandidate + 1;
+        }
+        else
+        {
+            iHigh = iCandidate - 1;
+        }
+    }
+
+    return ~iLow;
+}
+
+void
+BenchSortedSearch()
+{
+    int const cQuery = 1024 * 1024;
+    int const cItemMax = 16 * 1024 * 1024;
+
+    u32 * sorted = (u32 *)malloc(cItemMax * sizeof(u32));
+    u32 * queries = (u32 *)malloc(cQuery * sizeof(u32));
+    int * results = (int *)malloc(cQuery * sizeof(int));
+
+    int const itemCounts[] = { 4 * 1024, 256 * 1024, cItemMax };
+    for (int cItem : itemCounts)
+    {
+        printf("  %d items (%d kb)\n", cItem, (int)(cItem * sizeof(u32) / 1024));
+
+        // Odd values, so half the queries miss
+        for (int i = 0; i < cItem; i++)
+        {
+            sorted[i] = 2 * (u32)i + 1;
+        }
+
+        BenchRng rng = { 23 };
+        for (int i = 0; i < cQuery; i++)
+        {
+            queries[i] = BenchRandom(&rng) % (2 * (u32)cItem);
+        }
+
+        Slice<u32> slice = slice_create(sorted, cItem);
+        Eytzinger<u32> eytzinger = eytzinger_create(nullptr, slice);
+
+        u64 sum = 0;
+        double secondsStart = BenchSeconds();
+        for (int i = 0; i < cQuery; i++)
+        {
+            sum += (u32)BenchBranchySearch(sorted, cItem, queries[i]);
+        }
+        BenchReport("branchy binary search", BenchSeconds() - secondsStart, cQuery);
+
+        u64 sumCheck = sum;
+        g_benchSearchSink = sum;
+        sum = 0;
+        secondsStart = BenchSeconds();
+        for (int i = 0; i < cQuery; i++)
+        {
+            sum += (u32)BinarySearch(slice, queries[i], u32_compare);
+        }
+        BenchReport("BinarySearch", BenchSeconds() - secondsStart, cQuery);
+        ASSERT(sum == sumCheck);
+        g_benchSearchSink = sum;
+
+        sum = 0;
+        secondsStart = BenchSeconds();
+        for (int i = 0; i < cQuery; i++)
+        {
+            sum += LowerBound(slice, queries[i], u32_compare);
+        }
+        BenchReport("LowerBound", BenchSeconds() - secondsStart, cQuery);
+
+        sumCheck = sum;
+        secondsStart = BenchSeconds();
+        LowerBoundBatch(slice, slice_create(queries, cQuery), slice_create(results, cQuery), u32_compare);
+        BenchReport("LowerBoundBatch", BenchSeconds() - secondsStart, cQuery);
+
+        sum = 0;
+        for (int i = 0; i < cQuery; i++)
+        {
+            sum += results[i];
+        }
+        ASSERT(sum == sumCheck);
+
+        sum = 0;
+        secondsStart = BenchSeconds();
+        for (int i = 0; i < cQuery; i++)
+        {
+            u32 * found = eytzinger_lower_bound(eytzinger, queries[i], u32_compare);
+            sum += (found) ? *found : 0;
+        }
+        BenchReport("eytzinger_lower_bound", BenchSeconds() - secondsStart, cQuery);
+        g_benchSearchSink = sum;
+
+        eytzinger_destroy(&eytzinger);
+        g_benchSearchSink = sumCheck;
+    }
+
+    free(sorted);
+    free(queries);
+    free(results);
+}
+
+struct BenchMergeHead
+{
+    u32 value;
+    int iInput;
+};
+
+int
+BenchMergeHeadCompare(BenchMergeHead const & lhs, BenchMergeHead const & rhs)
+{
+    int result = u32_compare(lhs.value, rhs.value);
+    return (result != 0) ? result : i32_compare(lhs.iInput, rhs.iInput);
+}
+
+// Merging k sorted runs: loser tree vs. a Priority_Queue holding the head of each run
+void
+BenchKWayMerge()
+{
+    int const cItem = 4 * 1024 * 1024;
+    u32 * items = (u32 *)malloc(cItem * sizeof(u32));
+
+    Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+    DynArray<u32> out = DynArray<u32>(memory);
+    EnsureCapacity(&out, cItem);
+
+    int const inputCounts[] = { 2, 8, 64, 512 };
+    for (int cInput : inputCounts)
+    {
+        printf("  %d inputs\n", cInput);
+
+        BenchSortFill(items, cItem, BenchSortInput::RANDOM);
+        Slice<u32> inputs[512];
+        for (int i = 0; i < cInput; i++)
+        {
+            int begin = (int)((i64)cItem * i / cInput);
+            int end = (int)((i64)cItem * (i + 1) / cInput);
+            inputs[i] = slice_create(items + begin, end - begin);
+            RadixSort(inputs[i]);
+        }
+
+        out.count = 0;
+        double secondsStart = BenchSeconds();
+        MergeSorted(slice_create(inputs, cInput), u32_compare, &out);
+        BenchReport("MergeSorted (loser tree), per item", BenchSeconds() - secondsStart, cItem);
+
+        for (int i = 1; i < out.count; i++)
+        {
+            ASSERT(out[i - 1] <= out[i]);
+        }
+
+        Priority_Queue<BenchMergeHead> queue = priority_queue_create<BenchMergeHead>(memory, BenchMergeHeadCompare);
+        int positions[512] = {};
+
+        out.count = 0;
+        secondsStart = BenchSeconds();
+        for (int i = 0; i < cInput; i++)
+        {
+            priority_queue_insert(&queue, BenchMergeHead{ inputs[i][0], i });
+            positions[i] = 1;
+        }
+
+        while (!priority_queue_is_empty(queue))
+        {
+            BenchMergeHead head = priority_queue_pop(&queue);
+            out.items[out.count++] = head.value;
+
+            Slice<u32> input = inputs[head.iInput];
+            if (positions[head.iInput] < input.count)
+            {
+                priority_queue_insert(&queue, BenchMergeHead{ input[positions[head.iInput]++], head.iInput });
+            }
+        }
+        BenchReport("Priority_Queue, per item", BenchSeconds() - secondsStart, cItem);
+
+        ASSERT(out.count == cItem);
+        Clear(&queue.array, true /* shouldFreeMemory */);
+    }
+
+    mem_region_end(memory);
+    free(items);
+}
+
+template <typename QUEUE>
+void
+BenchPriorityQueueRun(char const * name, QUEUE * queue, u32 const * items, int cItem)
+{
+    double secondsStart = BenchSeconds();
+    for (int i = 0; i < cItem; i++)
+    {
+        priority_queue_insert(queue, items[i]);
+    }
+
+    u32 prev = 0;
+    for (int i = 0; i < cItem; i++)
+    {
+        u32 item = priority_queue_pop(queue);
+        ASSERT(item >= prev);
+        prev = item;
+    }
+    BenchReport(name, BenchSeconds() - secondsStart, cItem);
+    g_benchSearchSink = prev;
+
+    priority_queue_clear(queue, true /* shouldFreeMemory */);
+}
+
+// Insert everything, then pop everything, at a size that fits in cache and one that doesn't. Then a Dijkstra-
+//  style workload on the indexed queue, where most operations are decrease-key.
+void
+BenchPriorityQueue()
+{
+    using Compare = Priority_Queue_Compare<u32, u32_compare>;
+
+    int const cItemMax = 4 * 1024 * 1024;
+    u32 * items = (u32 *)malloc(cItemMax * sizeof(u32));
+    BenchSortFill(items, cItemMax, BenchSortInput::RANDOM);
+
+    Memory_Region memory = mem_region_begin(nullptr, MEGABYTES(1));
+
+    int const itemCounts[] = { 4 * 1024, cItemMax };
+    for (int cItem : itemCounts)
+    {
+        printf("  %d items, insert + pop, per item\n", cItem);
+
+        Priority_Queue<u32> queueRuntime = priority_queue_create<u32>(memory, u32_compare);
+        BenchPriorityQueueRun("binary, function pointer", &queueRuntime, items, cItem);
+
+        auto queue2 = priority_queue_create<u32, Compare, 2>(memory);
+        BenchPriorityQueueRun("binary, Priority_Queue_Compare", &queue2, items, cItem);
+
+        auto queue4 = priority_queue_create<u32, Compare, 4>(memory);
+        BenchPriorityQueueRun("4-ary, Priority_Queue_Compare", &queue4, items, cItem);
+
+        auto queue8 = priority_queue_create<u32, Compare, 8>(memory);
+        BenchPriorityQueueRun("8-ary, Priority_Queue_Compare", &queue8, items, cItem);
+    }
+
+    {
+        int const cNode = 1024 * 1024;
+        printf("  %d nodes, decrease-key heavy, per operation\n", cNode);
+
+        auto queue = indexed_priority_queue_create<u32, Compare, 4>(memory);
+        Slot_Handle * handles = (Slot_Handle *)malloc(cNode * sizeof(Slot_Handle));
+        u32 * keys = (u32 *)malloc(cNode * sizeof(u32));
+        for (int i = 0; i < cNode; i++)
+        {
+            keys[i] = items[i] | 0x80000000;
+        }
+
+        double secondsStart = BenchSeconds();
+        priority_queue_insert_bulk(&queue, slice_create(keys, cNode), handles);
+
+        // Each pop relaxes 4 random nodes that are still queued
+        BenchRng rng = { 29 };
+        int cOp = cNode;
+        while (!priority_queue_is_empty(queue))
+        {
+            u32 popped = priority_queue_pop(&queue);
+            for (int i = 0; i < 4; i++)
+            {
+                u32 iNode = BenchRandom(&rng) % cNode;
+                u32 const * key = priority_queue_get(queue, handles[iNode]);
+                u32 relaxed = popped + (BenchRandom(&rng) & 0xFFFF);
+                if (key && relaxed < *key)
+                {
+                    priority_queue_update(&queue, handles[iNode], relaxed);
+                    cOp++;
+                }
+            }
+            cOp++;
+        }
+        BenchReport("4-ary indexed: pop + update", BenchSeconds() - secondsStart, cOp);
+
+        priority_queue_clear(&queue, true /* shouldFreeMemory */);
+        free(keys);
+        free(handles);
+    }
+
+    mem_region_end(memory);
+    free(items);
+}
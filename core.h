@@ -192,15 +192,26 @@ f32 constexpr MAX = 3.402823466e38f;
 #include "enum.h"
 #include "math/math.h"
 #include "mem_util.h"
+#include "atomic.h"
 #include "mem_alloc.h"
+#include "mem_concurrent.h"
+#include "mem_scratch.h"
+#include "thread_pool.h"
 #include "string/string.h"
+#include "mem_stats.h"
 #include "array/array.h"
 #include "sort.h"
+#include "hash.h"
 #include "dict.h"
+#include "dict_swiss.h"
+#include "dict_robin_hood.h"
+#include "dict_concurrent.h"
 #include "string/string_hash.h"
+#include "string/string_intern.h"
 #include "string/string_parse.h"
 #include "math/extra/geometry2d.h"
 #include "io/io_visit.h"
+#include "dict_static.h"     // After io_visit.h, for io_static_dict(..)
 #include "io/io_file.h"
 #include "io/io_file.cpp"
 #include "tree.h"
@@ -138,8 +138,44 @@ CombineHash(unsigned int hash0, unsigned int hash1)
 
 
 // --- Simple dictionary with linear probing
+//  Keys are hashed and compared through HASHER::hash(key) and EQ::eq(key0, key1). Those are known at compile
+//  time, so they inline into the probe loop. The default policy, DICT::Fn_Ptr, instead calls through the
+//  key_hash / key_eq pointers given to dict_create(..), which costs an indirect call per probe but doesn't
+//  bake the functions into the type.
+//
+//  usage:
+//      Dict<u32, Foo, U32_Hasher, U32_Eq> dict = dict_create<u32, Foo, U32_Hasher, U32_Eq>(memory);
+//      Dict<u32, Foo> dict = dict_create<u32, Foo>(memory, u32_hash, u32_eq);
+
+namespace DICT
+{
+// Policy that calls through the function pointers stored in the dict
+struct Fn_Ptr {};
+}
 
-template <typename K, typename V>
+// Policies are plain structs with a static hash(..) or eq(..). Not templates over the function itself, since
+//  the functions have internal linkage, and a type built from one would be different in every translation unit.
+struct U32_Hasher
+{
+    static u32 hash(u32 const& key) { return u32_hash(key); }
+};
+
+struct U32_Eq
+{
+    static bool eq(u32 const& key0, u32 const& key1) { return u32_eq(key0, key1); }
+};
+
+struct U64_Hasher
+{
+    static u32 hash(u64 const& key) { return u64_hash(key); }
+};
+
+struct U64_Eq
+{
+    static bool eq(u64 const& key0, u64 const& key1) { return u64_eq(key0, key1); }
+};
+
+template <typename K, typename V, typename HASHER=DICT::Fn_Ptr, typename EQ=DICT::Fn_Ptr>
 struct Dict
 {
     struct Kvp
@@ -158,71 +194,133 @@ struct Dict
     i32 count_filled;       // Valid + removed item count. Need to remember removed items when linear probing.
     i32 capacity;           // Size of backing array. Grows when max_load_factor is exceeded.
 
-    // User provided functions
+    // User provided functions. Only used with the DICT::Fn_Ptr policy.
     u32 (*key_hash)(K const& key);
     bool (*key_eq)(K const& key0, K const& key1);
 
     Memory_Region memory;
     Kvp* items;
 
-    struct Iter
+    // Incremental resize. If resize_step_count > 0, growing is spread over the following inserts and removes,
+    //  instead of being one big latency spike:
+    //  1. The new table is allocated, and cleared a chunk at a time. Meanwhile the current table keeps taking
+    //     inserts, past its load factor if need be.
+    //  2. The new table becomes current, and each insert or remove moves the next resize_step_count slots of
+    //     the old table over. Lookups check both tables until that's done.
+    i32 resize_step_count;
+
+    Kvp* next_items;        // 1. Being cleared
+    i32 next_capacity;
+    i32 next_cleared_count;
+
+    Kvp* old_items;         // 2. Being moved out of
+    i32 old_capacity;
+    i32 old_count;          // Valid items still in the old table. Included in count.
+    i32 resize_cursor;      // Next old slot to move
+
+    // Visits the current table, then the old one if a resize is in progress
+    template <typename KVP>
+    struct Iter_Base
     {
-        Kvp* cursor;
-        Kvp* end;
-        bool operator!=(Iter const& other) const { return cursor != other.cursor; }
-        Kvp& operator*() { return *cursor; }
-        Kvp* operator->() { return cursor; }
-        Iter& operator++()
+        KVP* cursor;
+        KVP* end;
+        KVP* old_cursor;
+        KVP* old_end;
+        bool operator!=(Iter_Base const& other) const { return cursor != other.cursor; }
+        KVP& operator*() const { return *cursor; }
+        KVP* operator->() const { return cursor; }
+        Iter_Base& operator++()
         {
             cursor++;
-            while (cursor < end && cursor->hash < Kvp::HASH_VALID_MIN) cursor++;
+            skip_to_valid();
             return *this;
         }
-    };
-    struct Const_Iter
-    {
-        Kvp const* cursor;
-        Kvp const* end;
-        bool operator!=(Const_Iter const& other) const { return cursor != other.cursor; }
-        Kvp const& operator*() const { return *cursor; }
-        Kvp const* operator->() const { return cursor; }
-        Const_Iter& operator++()
+        void skip_to_valid()
         {
-            cursor++;
-            while (cursor < end && cursor->hash < Kvp::HASH_VALID_MIN) cursor++;
-            return *this;
+            while (true)
+            {
+                while (cursor < end && cursor->hash < Kvp::HASH_VALID_MIN) cursor++;
+                if (cursor < end || old_cursor == old_end)
+                    break;
+
+                cursor = old_cursor;
+                end = old_end;
+                old_cursor = old_end;
+            }
         }
     };
+    using Iter = Iter_Base<Kvp>;
+    using Const_Iter = Iter_Base<Kvp const>;
 
-    Iter end() { return Iter{ items + capacity, items + capacity }; }
+    Iter end() { Kvp* last = (old_items) ? old_items + old_capacity : items + capacity; return Iter{ last, last, last, last }; }
     Iter begin()
     {
         if (count == 0) return end();
-        Iter result = Iter{ items, items + capacity };
-        if (items[0].hash < Kvp::HASH_VALID_MIN) ++result; // overloaded ++ iterates until valid 
+        Iter result = Iter{ items, items + capacity, old_items, old_items + old_capacity };
+        result.skip_to_valid();
         return result;
     }
-    Const_Iter end() const { return Const_Iter{ items + capacity, items + capacity }; }
+    Const_Iter end() const { Kvp* last = (old_items) ? old_items + old_capacity : items + capacity; return Const_Iter{ last, last, last, last }; }
     Const_Iter begin() const
     {
         if (count == 0) return end();
-        Const_Iter result = Const_Iter{ items, items + capacity };
-        if (items[0].hash < Kvp::HASH_VALID_MIN) ++result; // overloaded ++ iterates until valid 
+        Const_Iter result = Const_Iter{ items, items + capacity, old_items, old_items + old_capacity };
+        result.skip_to_valid();
         return result;
     }
 };
 
-// This function has no qualms about adding a duplicate key. Use wisely!
-template <typename K, typename V>
-function typename Dict<K, V>::Kvp*
-dict_add_key_unchecked(Dict<K, V>* dict, K const& key)
+namespace DICT
+{
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function u32
+key_hash_policy(Dict<K, V, HASHER, EQ> const& dict, K const& key)
+{
+    return HASHER::hash(key);
+}
+
+template <typename K, typename V, typename EQ>
+function u32
+key_hash_policy(Dict<K, V, Fn_Ptr, EQ> const& dict, K const& key)
 {
-    using Kvp = Dict<K, V>::Kvp;
+    return dict.key_hash(key);
+}
 
-    dict_ensure_capacity(dict, dict->count_filled + 1);
+template <typename K, typename V, typename HASHER, typename EQ>
+function bool
+key_eq_policy(Dict<K, V, HASHER, EQ> const& dict, K const& key0, K const& key1)
+{
+    return EQ::eq(key0, key1);
+}
 
-    u32 hash = dict->key_hash(key);
-    if (hash < Kvp::HASH_VALID_MIN) hash += Kvp::HASH_VALID_MIN;
+template <typename K, typename V, typename HASHER>
+function bool
+key_eq_policy(Dict<K, V, HASHER, Fn_Ptr> const& dict, K const& key0, K const& key1)
+{
+    return dict.key_eq(key0, key1);
+}
+
+// Never collides with HASH_UNOCCUPIED / HASH_REMOVED
+template <typename K, typename V, typename HASHER, typename EQ>
+function u32
+key_hash(Dict<K, V, HASHER, EQ> const& dict, K const& key)
+{
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
+
+    u32 result = key_hash_policy(dict, key);
+    if (result < Kvp::HASH_VALID_MIN) result += Kvp::HASH_VALID_MIN;
+    return result;
+}
+
+} // namespace DICT
+
+// Adds to the current table, with a precomputed hash. Doesn't check for duplicates or capacity.
+template <typename K, typename V, typename HASHER, typename EQ>
+function typename Dict<K, V, HASHER, EQ>::Kvp*
+dict_add_hashed(Dict<K, V, HASHER, EQ>* dict, u32 hash, K const& key)
+{
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
 
     u32 mask = dict->capacity - 1;
     i32 index = hash & mask;
@@ -240,7 +338,6 @@ dict_add_key_unchecked(Dict<K, V>* dict, K const& key)
 
         // HMM - consider quadratic probing with "triangular numbers"
         // https://fgiesen.wordpress.com/2015/02/22/triangular-numbers-mod-2n/
-        // TODO - enforce power of 2 capacity and use & instead of %
         index = (index + 1) & mask;
     }
 
@@ -253,27 +350,126 @@ dict_add_key_unchecked(Dict<K, V>* dict, K const& key)
     return result;
 }
 
+// Advances an incremental resize, if one is in progress. Moves up to step_count old slots, and clears at
+//  least that many new ones.
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+dict_resize_step(Dict<K, V, HASHER, EQ>* dict, i32 step_count)
+{
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
+
+    if (dict->next_items)
+    {
+        // Clear fast enough to be done before the current table runs out of empty slots
+        i32 remaining = dict->next_capacity - dict->next_cleared_count;
+        i32 insert_count_left = max(1, (dict->capacity - dict->count_filled - 1) / 2);
+        i32 clear_count = max(step_count, (remaining + insert_count_left - 1) / insert_count_left);
+        clear_count = min(clear_count, remaining);
+
+        for (i32 i = 0; i < clear_count; i++)
+        {
+            dict->next_items[dict->next_cleared_count + i].hash = Kvp::HASH_UNOCCUPIED;
+        }
+        dict->next_cleared_count += clear_count;
+
+        if (dict->next_cleared_count == dict->next_capacity)
+        {
+            // Swap in the new table. The current one becomes the old one.
+            dict->old_items = dict->items;
+            dict->old_capacity = dict->capacity;
+            dict->old_count = dict->count;
+            dict->resize_cursor = 0;
+
+            dict->items = dict->next_items;
+            dict->capacity = dict->next_capacity;
+            dict->count_filled = 0;
+
+            dict->next_items = nullptr;
+            dict->next_capacity = 0;
+            dict->next_cleared_count = 0;
+        }
+
+        return;
+    }
+
+    if (!dict->old_items)
+        return;
+
+    i32 cursor_end = min(dict->resize_cursor + step_count, dict->old_capacity);
+    for (i32 i = dict->resize_cursor; i < cursor_end; i++)
+    {
+        Kvp* kvp = dict->old_items + i;
+        if (kvp->hash < Kvp::HASH_VALID_MIN)
+            continue;
+
+        Kvp* moved = dict_add_hashed(dict, kvp->hash, kvp->key);
+        moved->value = kvp->value;
+        dict->count--;
+        dict->old_count--;
+
+        // Not HASH_UNOCCUPIED, since old items later on might have probed past this slot
+        kvp->hash = Kvp::HASH_REMOVED;
+    }
+
+    dict->resize_cursor = cursor_end;
+    if (dict->resize_cursor == dict->old_capacity)
+    {
+        ASSERT(dict->old_count == 0);
+        free_tracked_allocation(dict->memory, dict->old_items);
+
+        dict->old_items = nullptr;
+        dict->old_capacity = 0;
+        dict->old_count = 0;
+        dict->resize_cursor = 0;
+    }
+}
+
+// Finishes an incremental resize, if one is in progress
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+dict_resize_finish(Dict<K, V, HASHER, EQ>* dict)
+{
+    dict_resize_step(dict, dict->next_capacity);
+    dict_resize_step(dict, dict->old_capacity);
+}
+
 // This function has no qualms about adding a duplicate key. Use wisely!
-template <typename K, typename V>
+template <typename K, typename V, typename HASHER, typename EQ>
+function typename Dict<K, V, HASHER, EQ>::Kvp*
+dict_add_key_unchecked(Dict<K, V, HASHER, EQ>* dict, K const& key)
+{
+    dict_resize_step(dict, dict->resize_step_count);
+
+    // Old items are headed for the current table, so they count toward its load
+    dict_ensure_capacity(dict, dict->count_filled + dict->old_count + 1);
+
+    u32 hash = DICT::key_hash(*dict, key);
+
+    auto* result = dict_add_hashed(dict, hash, key);
+    return result;
+}
+
+// This function has no qualms about adding a duplicate key. Use wisely!
+template <typename K, typename V, typename HASHER, typename EQ>
 function void
-dict_add_unchecked(Dict<K, V>* dict, K const& key, V const& value)
+dict_add_unchecked(Dict<K, V, HASHER, EQ>* dict, K const& key, V const& value)
 {
-    using Kvp = Dict<K, V>::Kvp;
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
     Kvp* kvp = dict_add_key_unchecked(dict, key);
     kvp->value = value;
 }
 
 // Grows the table so that it can store at least this many items within its load factor
-template <typename K, typename V>
+template <typename K, typename V, typename HASHER, typename EQ>
 function void
-dict_ensure_capacity(Dict<K, V>* dict, i32 capacity)
+dict_ensure_capacity(Dict<K, V, HASHER, EQ>* dict, i32 capacity)
 {
-    using Kvp = Dict<K, V>::Kvp;
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
 
-    // Save a handle to the old memory
-    Slice<Kvp> old_items = slice_create(dict->items, dict->capacity);
+    // During an incremental resize, the items are headed for the next table
+    i32 target_capacity = (dict->next_items) ? dict->next_capacity : dict->capacity;
 
-    i32 new_capacity = max(dict->capacity, capacity);
+    i32 new_capacity = max(target_capacity, capacity);
     new_capacity = u32_ceil_power_of_2(new_capacity);
 
     while (new_capacity * dict->max_load_factor < capacity * 100)
@@ -281,8 +477,23 @@ dict_ensure_capacity(Dict<K, V>* dict, i32 capacity)
         new_capacity *= 2;
     }
 
-    if (dict->capacity >= new_capacity)
+    if (target_capacity >= new_capacity)
+        return;
+
+    // Only one resize at a time
+    dict_resize_finish(dict);
+
+    if (dict->resize_step_count > 0 && dict->count > 0)
+    {
+        // Inserts and removes will clear the new table, then move the items over
+        dict->next_items = (Kvp*)allocate_tracked(dict->memory, new_capacity * sizeof(Kvp));
+        dict->next_capacity = new_capacity;
+        dict->next_cleared_count = 0;
         return;
+    }
+
+    // Save a handle to the old memory
+    Slice<Kvp> old_items = slice_create(dict->items, dict->capacity);
 
     // Reset with bigger memory
     dict->items = (Kvp*)allocate_tracked(dict->memory, new_capacity * sizeof(Kvp));
@@ -301,7 +512,8 @@ dict_ensure_capacity(Dict<K, V>* dict, i32 capacity)
     {
         if (kvp.hash >= Kvp::HASH_VALID_MIN)
         {
-            dict_add_unchecked(dict, kvp.key, kvp.value);
+            Kvp* added = dict_add_hashed(dict, kvp.hash, kvp.key);
+            added->value = kvp.value;
         }
     }
 
@@ -313,51 +525,65 @@ dict_ensure_capacity(Dict<K, V>* dict, i32 capacity)
     }
 }
 
-template <typename K, typename V>
-function typename Dict<K, V>::Kvp*
-dict_find_kvp_ptr(Dict<K, V> const& dict, K const& key)
+template <typename K, typename V, typename HASHER, typename EQ>
+function typename Dict<K, V, HASHER, EQ>::Kvp*
+dict_find_kvp_ptr_hashed(
+    Dict<K, V, HASHER, EQ> const& dict,
+    typename Dict<K, V, HASHER, EQ>::Kvp* items,
+    i32 capacity,
+    u32 hash,
+    K const& key)
 {
-    using Kvp = Dict<K, V>::Kvp;
-
-    if (dict.capacity <= 0)
-    {
-        ASSERT_FALSE_WARN;
-        return nullptr;
-    }
-
-    u32 hash = dict.key_hash(key);
-    if (hash < Kvp::HASH_VALID_MIN) hash += Kvp::HASH_VALID_MIN;
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
 
-    u32 mask = dict.capacity - 1;
+    u32 mask = capacity - 1;
     i32 index = hash & mask;
 
-    Kvp* result = nullptr;
     while (true)
     {
-        if (dict.items[index].hash == Kvp::HASH_UNOCCUPIED)
-            break;
+        if (items[index].hash == Kvp::HASH_UNOCCUPIED)
+            return nullptr;
 
-        if (dict.items[index].hash == hash &&
-            dict.key_eq(dict.items[index].key, key))
+        if (items[index].hash == hash &&
+            DICT::key_eq_policy(dict, items[index].key, key))
         {
-            result = dict.items + index;
-            break;
+            return items + index;
         }
 
         // HMM - consider quadratic probing with "triangular numbers"
         // https://fgiesen.wordpress.com/2015/02/22/triangular-numbers-mod-2n/
-        // TODO - enforce power of 2 capacity and use & instead of %
         index = (index + 1) & mask;
     }
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function typename Dict<K, V, HASHER, EQ>::Kvp*
+dict_find_kvp_ptr(Dict<K, V, HASHER, EQ> const& dict, K const& key)
+{
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
+
+    if (dict.capacity <= 0)
+    {
+        ASSERT_FALSE_WARN;
+        return nullptr;
+    }
+
+    u32 hash = DICT::key_hash(dict, key);
+
+    Kvp* result = dict_find_kvp_ptr_hashed(dict, dict.items, dict.capacity, hash, key);
+    if (!result && dict.old_items)
+    {
+        result = dict_find_kvp_ptr_hashed(dict, dict.old_items, dict.old_capacity, hash, key);
+    }
 
     return result;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename HASHER, typename EQ>
 function V*
-dict_find_ptr(Dict<K, V> const& dict, K const& key)
+dict_find_ptr(Dict<K, V, HASHER, EQ> const& dict, K const& key)
 {
-    using Kvp = Dict<K, V>::Kvp;
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
 
     V* result = nullptr;
     if (Kvp* kvp = dict_find_kvp_ptr(dict, key))
@@ -367,9 +593,9 @@ dict_find_ptr(Dict<K, V> const& dict, K const& key)
     return result;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename HASHER, typename EQ>
 function V
-dict_find(Dict<K, V> const& dict, K const& key, bool* success=nullptr)
+dict_find(Dict<K, V, HASHER, EQ> const& dict, K const& key, bool* success=nullptr)
 {
     if (V* result = dict_find_ptr(dict, key))
     {
@@ -381,9 +607,64 @@ dict_find(Dict<K, V> const& dict, K const& key, bool* success=nullptr)
     return V{};
 }
 
-template <typename K, typename V>
+namespace DICT
+{
+static constexpr int BATCH_CHUNK_COUNT = 32;    // Keys in flight. Enough to cover a trip to DRAM, few enough to stay in L1.
+}
+
+// Looks up many keys at once. Sets out[i] to keys[i]'s value, or nullptr if it's missing. Returns how many were found.
+//  Hashes a chunk of keys and prefetches all of their home slots before probing any of them, so the cache misses
+//  overlap instead of happening one after another. Pays off once the table doesn't fit in cache.
+template <typename K, typename V, typename HASHER, typename EQ>
+function int
+dict_find_batch(Dict<K, V, HASHER, EQ> const& dict, Slice<K> keys, Slice<V*> out)
+{
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
+
+    ASSERT(out.count >= keys.count);
+
+    if (dict.capacity <= 0)
+    {
+        ASSERT_FALSE_WARN;
+        for (int i = 0; i < keys.count; i++) out[i] = nullptr;
+        return 0;
+    }
+
+    u32 mask = dict.capacity - 1;
+    u32 hashes[DICT::BATCH_CHUNK_COUNT];
+
+    int result = 0;
+    for (int chunk_start = 0; chunk_start < keys.count; chunk_start += DICT::BATCH_CHUNK_COUNT)
+    {
+        int chunk_count = min(DICT::BATCH_CHUNK_COUNT, keys.count - chunk_start);
+
+        for (int i = 0; i < chunk_count; i++)
+        {
+            hashes[i] = DICT::key_hash(dict, keys[chunk_start + i]);
+            _mm_prefetch((char const*)(dict.items + (hashes[i] & mask)), _MM_HINT_T0);
+        }
+
+        for (int i = 0; i < chunk_count; i++)
+        {
+            K const& key = keys[chunk_start + i];
+
+            Kvp* kvp = dict_find_kvp_ptr_hashed(dict, dict.items, dict.capacity, hashes[i], key);
+            if (!kvp && dict.old_items)
+            {
+                kvp = dict_find_kvp_ptr_hashed(dict, dict.old_items, dict.old_capacity, hashes[i], key);
+            }
+
+            out[chunk_start + i] = (kvp) ? &kvp->value : nullptr;
+            result += (kvp) ? 1 : 0;
+        }
+    }
+
+    return result;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
 function V*
-dict_find_or_new(Dict<K, V>* dict, K const& key)
+dict_find_or_new(Dict<K, V, HASHER, EQ>* dict, K const& key)
 {
     if (V* value_ptr = dict_find_ptr(*dict, key))
     {
@@ -395,17 +676,17 @@ dict_find_or_new(Dict<K, V>* dict, K const& key)
     }
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename HASHER, typename EQ>
 function bool
-dict_contains(Dict<K, V> const& dict, K const& key)
+dict_contains(Dict<K, V, HASHER, EQ> const& dict, K const& key)
 {
     bool result = (dict_find_ptr(dict, key) != nullptr);
     return result;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename HASHER, typename EQ>
 function void
-dict_set(Dict<K, V>* dict, K const& key, V const& value)
+dict_set(Dict<K, V, HASHER, EQ>* dict, K const& key, V const& value)
 {
     if (V* value_ptr = dict_find_ptr(*dict, key))
     {
@@ -417,16 +698,25 @@ dict_set(Dict<K, V>* dict, K const& key, V const& value)
     }
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename HASHER, typename EQ>
 function bool
-dict_remove(Dict<K, V>* dict, K const& key)
+dict_remove(Dict<K, V, HASHER, EQ>* dict, K const& key)
 {
-    using Kvp = Dict<K, V>::Kvp;
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
 
     if (Kvp* kvp_ptr = dict_find_kvp_ptr(*dict, key))
     {
+        bool is_old = (kvp_ptr >= dict->old_items && kvp_ptr < dict->old_items + dict->old_capacity);
+        if (is_old)
+        {
+            dict->old_count--;
+        }
+
         kvp_ptr->hash = Kvp::HASH_REMOVED;
         dict->count--;
+
+        dict_resize_step(dict, dict->resize_step_count);
+
         // HMM - should we return the removed value?
         return true;
     }
@@ -434,6 +724,21 @@ dict_remove(Dict<K, V>* dict, K const& key)
     return false;
 }
 
+// For dicts with compile-time HASHER / EQ policies
+template <typename K, typename V, typename HASHER, typename EQ>
+function Dict<K, V, HASHER, EQ>
+dict_create(Memory_Region memory, i32 starting_capacity=16)
+{
+    starting_capacity = max(starting_capacity, 16);
+
+    Dict<K, V, HASHER, EQ> result = {};
+    result.max_load_factor = 70;
+    result.memory = memory;
+    // HMM - maybe we shouldn't allocate in create(..). Wait until we have an item instead?
+    dict_ensure_capacity(&result, starting_capacity);
+    return result;
+}
+
 template <typename K, typename V>
 function Dict<K, V>
 dict_create(
@@ -442,23 +747,17 @@ dict_create(
     bool (*key_eq)(K const& key0, K const& key1),
     i32 starting_capacity=16)
 {
-    starting_capacity = max(starting_capacity, 16);
-
-    Dict<K, V> result = {};
-    result.max_load_factor = 70;
+    Dict<K, V> result = dict_create<K, V, DICT::Fn_Ptr, DICT::Fn_Ptr>(memory, starting_capacity);
     result.key_hash = key_hash;
     result.key_eq = key_eq;
-    result.memory = memory;
-    // HMM - maybe we shouldn't allocate in create(..). Wait until we have an item instead?
-    dict_ensure_capacity(&result, starting_capacity);
     return result;
 }
 
-template <typename K, typename V>
+template <typename K, typename V, typename HASHER, typename EQ>
 function void
-dict_reset(Dict<K, V>* dict)
+dict_reset(Dict<K, V, HASHER, EQ>* dict)
 {
-    using Kvp = Dict<K, V>::Kvp;
+    using Kvp = typename Dict<K, V, HASHER, EQ>::Kvp;
 
     dict->count = 0;
     dict->count_filled = 0;
@@ -466,6 +765,26 @@ dict_reset(Dict<K, V>* dict)
     {
         dict->items[i].hash = Kvp::HASH_UNOCCUPIED;
     }
+
+    // Nothing left to move
+    if (dict->next_items)
+    {
+        free_tracked_allocation(dict->memory, dict->next_items);
+
+        dict->next_items = nullptr;
+        dict->next_capacity = 0;
+        dict->next_cleared_count = 0;
+    }
+
+    if (dict->old_items)
+    {
+        free_tracked_allocation(dict->memory, dict->old_items);
+
+        dict->old_items = nullptr;
+        dict->old_capacity = 0;
+        dict->old_count = 0;
+        dict->resize_cursor = 0;
+    }
 }
 
 //  --- Bi-directional dict (all values are unique)
@@ -0,0 +1,498 @@
+#pragma once
+
+// --- Concurrent dictionary
+//  Read-mostly hash map that many threads can use at once. Same linear probing layout as Dict, but keys are
+//  hashed and compared with compile-time HASHER / EQ policies (e.g. U32_Hasher / U32_Eq).
+//
+//  Lookups never take a lock, and never write to memory shared with other threads. A slot's key is written
+//  before its hash is published, and never changes afterwards (removing only tombstones the hash), so a
+//  reader just needs the slot's version count to get an untorn copy of the value. Values are returned by
+//  copy, since another thread could overwrite them at any time.
+//
+//  Writers lock one of STRIPE_COUNT spin locks, picked by the key's hash, so writers of different keys
+//  rarely contend. Empty slots are claimed with a compare-exchange, since writers in different stripes can
+//  probe the same slots.
+//
+//  Growing takes every stripe, builds a new table, and swaps it in with one pointer store. Readers keep using
+//  whichever table they started with, so they're never blocked. The old table is retired, and freed once
+//  every reader that could still be looking at it has finished (epoch-based reclamation). Each reading thread
+//  attaches a Concurrent_Dict_Reader, so it can announce its epoch on its own cache line.
+//
+//  Relies on x64 ordering: locked instructions are full fences, and loads aren't reordered with other loads.
+//
+//  usage:
+//      auto* dict = concurrent_dict_create<u32, Foo, U32_Hasher, U32_Eq>(parent);
+//      ... on each thread that reads:
+//      Concurrent_Dict_Reader* reader = concurrent_dict_attach(dict);
+//      Foo foo;
+//      if (concurrent_dict_find(dict, reader, key, &foo)) { ... }
+//      ... on any thread:
+//      concurrent_dict_set(dict, key, foo);
+//      concurrent_dict_remove(dict, key);
+//      ... once all threads are done:
+//      concurrent_dict_destroy(dict);
+
+namespace CONCURRENT_DICT
+{
+static constexpr int STRIPE_COUNT = 64;
+static constexpr i32 CAPACITY_MIN = 16;
+static constexpr i32 MAX_LOAD_FACTOR = 70;
+static constexpr uintptr CACHE_LINE = 64;
+
+static constexpr u32 HASH_UNOCCUPIED = 0;
+static constexpr u32 HASH_REMOVED = 1;
+static constexpr u32 HASH_CLAIMED = 2;      // A writer is filling in the key. Readers skip it, like a tombstone.
+static constexpr u32 HASH_VALID_MIN = 3;
+}
+
+struct Concurrent_Dict_Reader
+{
+    u64 volatile epoch;                 // Epoch this reader entered a lookup in, or 0 when it isn't in one
+    Concurrent_Dict_Reader* next;       // Guarded by the dict's lock
+    u32 volatile attached;
+    u8 pad[CONCURRENT_DICT::CACHE_LINE - sizeof(u64) - sizeof(void*) - sizeof(u32)];
+};
+
+struct Concurrent_Dict_Stripe
+{
+    Spin_Lock lock;
+    u8 pad[CONCURRENT_DICT::CACHE_LINE - sizeof(Spin_Lock)];
+};
+
+template <typename K, typename V, typename HASHER, typename EQ>
+struct Concurrent_Dict
+{
+    struct Kvp
+    {
+        u32 volatile hash;
+        u32 volatile version;   // Odd while a writer is changing the value
+        K key;
+        V value;
+    };
+
+    struct Table
+    {
+        Kvp* items;
+        i32 capacity;           // Power of 2
+        u64 retire_epoch;
+        Table* next_retired;
+    };
+
+    Concurrent_Dict_Stripe stripes[CONCURRENT_DICT::STRIPE_COUNT];
+
+    // Read by every lookup, written only when growing
+    Table* volatile table;
+    u64 volatile epoch;
+    u8 pad0[CONCURRENT_DICT::CACHE_LINE - sizeof(void*) - sizeof(u64)];
+
+    // Written by every insert and remove
+    u32 volatile count;         // Valid items
+    u32 volatile count_filled;  // Valid + removed + claimed slots in the current table
+    u8 pad1[CONCURRENT_DICT::CACHE_LINE - 2 * sizeof(u32)];
+
+    Spin_Lock lock;             // Guards everything below
+    Memory_Region memory;
+    Concurrent_Dict_Reader* readers;
+    Table* retired;
+};
+
+namespace CONCURRENT_DICT
+{
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function u32
+key_hash(K const& key)
+{
+    u32 result = HASHER::hash(key);
+    if (result < HASH_VALID_MIN) result += HASH_VALID_MIN;
+    return result;
+}
+
+// Picks the stripe from the top bits, since the bottom ones pick the slot
+template <typename K, typename V, typename HASHER, typename EQ>
+function Spin_Lock*
+stripe_lock(Concurrent_Dict<K, V, HASHER, EQ>* dict, u32 hash)
+{
+    Spin_Lock* result = &dict->stripes[hash >> 26].lock;
+    return result;
+}
+
+// Caller must hold the dict's lock
+template <typename K, typename V, typename HASHER, typename EQ>
+function typename Concurrent_Dict<K, V, HASHER, EQ>::Table*
+table_create(Concurrent_Dict<K, V, HASHER, EQ>* dict, i32 capacity)
+{
+    using Table = typename Concurrent_Dict<K, V, HASHER, EQ>::Table;
+    using Kvp = typename Concurrent_Dict<K, V, HASHER, EQ>::Kvp;
+
+    Table* result = (Table*)allocate_tracked(dict->memory, sizeof(Table), alignof(Table), CTZ::YES);
+    result->items = (Kvp*)allocate_tracked(dict->memory, capacity * sizeof(Kvp), CACHE_LINE, CTZ::YES);
+    result->capacity = capacity;
+    return result;
+}
+
+// Caller must hold the dict's lock
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+table_free(Concurrent_Dict<K, V, HASHER, EQ>* dict, typename Concurrent_Dict<K, V, HASHER, EQ>::Table* table)
+{
+    free_tracked_allocation(dict->memory, table->items);
+    free_tracked_allocation(dict->memory, table);
+}
+
+// Frees retired tables that no reader can still be looking at. Caller must hold the dict's lock.
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+reclaim(Concurrent_Dict<K, V, HASHER, EQ>* dict)
+{
+    using Table = typename Concurrent_Dict<K, V, HASHER, EQ>::Table;
+
+    // Readers that entered after a table's retire epoch loaded the table pointer after it was replaced
+    u64 epoch_oldest = U64::MAX;
+    for (Concurrent_Dict_Reader* reader = dict->readers; reader; reader = reader->next)
+    {
+        u64 epoch = atomic_load(&reader->epoch);
+        if (epoch != 0) epoch_oldest = min(epoch_oldest, epoch);
+    }
+
+    Table** link = &dict->retired;
+    while (*link)
+    {
+        Table* table = *link;
+        if (table->retire_epoch < epoch_oldest)
+        {
+            *link = table->next_retired;
+            table_free(dict, table);
+        }
+        else
+        {
+            link = &table->next_retired;
+        }
+    }
+}
+
+// Rebuilds the table, dropping tombstones, and growing it if it's more than half full of live items.
+//  seen is the table the caller found to be full. If it's already been replaced, there's nothing to do.
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+grow(Concurrent_Dict<K, V, HASHER, EQ>* dict, typename Concurrent_Dict<K, V, HASHER, EQ>::Table* seen)
+{
+    using Table = typename Concurrent_Dict<K, V, HASHER, EQ>::Table;
+    using Kvp = typename Concurrent_Dict<K, V, HASHER, EQ>::Kvp;
+
+    // Stops every writer. Always in the same order, so two growing threads can't deadlock.
+    for (int i = 0; i < STRIPE_COUNT; i++)
+    {
+        spin_lock_acquire(&dict->stripes[i].lock);
+    }
+
+    Table* table = dict->table;
+    if (table == seen)
+    {
+        i32 count = (i32)dict->count;
+
+        i32 capacity = CAPACITY_MIN;
+        while ((i64)capacity * MAX_LOAD_FACTOR < ((i64)count + 1) * 100 * 2)
+        {
+            capacity *= 2;
+        }
+
+        spin_lock_acquire(&dict->lock);
+        Table* table_new = table_create(dict, capacity);
+        spin_lock_release(&dict->lock);
+
+        // No writers, and readers only read, so the old table holds still while we copy it
+        u32 mask = capacity - 1;
+        for (i32 i = 0; i < table->capacity; i++)
+        {
+            Kvp* kvp = table->items + i;
+            if (kvp->hash < HASH_VALID_MIN)
+                continue;
+
+            u32 index = kvp->hash & mask;
+            while (table_new->items[index].hash != HASH_UNOCCUPIED)
+            {
+                index = (index + 1) & mask;
+            }
+
+            Kvp* kvp_new = table_new->items + index;
+            kvp_new->key = kvp->key;
+            kvp_new->value = kvp->value;
+            kvp_new->hash = kvp->hash;
+        }
+
+        dict->count_filled = count;
+        atomic_exchange(&dict->table, table_new);
+
+        spin_lock_acquire(&dict->lock);
+        table->retire_epoch = atomic_add(&dict->epoch, 1ull);
+        table->next_retired = dict->retired;
+        dict->retired = table;
+        reclaim(dict);
+        spin_lock_release(&dict->lock);
+    }
+
+    for (int i = STRIPE_COUNT - 1; i >= 0; i--)
+    {
+        spin_lock_release(&dict->stripes[i].lock);
+    }
+}
+
+} // namespace CONCURRENT_DICT
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function Concurrent_Dict<K, V, HASHER, EQ>*
+concurrent_dict_create(Memory_Region parent, i32 starting_capacity=16)
+{
+    using namespace CONCURRENT_DICT;
+    using Concurrent = Concurrent_Dict<K, V, HASHER, EQ>;
+
+    i32 capacity = (i32)u32_ceil_power_of_2(max(starting_capacity, CAPACITY_MIN));
+    Memory_Region memory = mem_region_begin(parent, sizeof(Concurrent) + capacity * sizeof(typename Concurrent::Kvp) * 2);
+
+    Concurrent* result = (Concurrent*)allocate(memory, sizeof(Concurrent), CACHE_LINE, CTZ::YES);
+    result->memory = memory;
+    result->epoch = 1;
+    result->table = table_create(result, capacity);
+    return result;
+}
+
+// Frees everything. No thread may use the dict, or a reader attached to it, afterwards.
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+concurrent_dict_destroy(Concurrent_Dict<K, V, HASHER, EQ>* dict)
+{
+    mem_region_end(dict->memory);
+}
+
+// Must be called by each thread that wants to look things up. The returned reader should only be used by
+//  the calling thread, until it's detached.
+template <typename K, typename V, typename HASHER, typename EQ>
+function Concurrent_Dict_Reader*
+concurrent_dict_attach(Concurrent_Dict<K, V, HASHER, EQ>* dict)
+{
+    spin_lock_acquire(&dict->lock);
+
+    Concurrent_Dict_Reader* result = dict->readers;
+    while (result && result->attached)
+    {
+        result = result->next;
+    }
+
+    if (!result)
+    {
+        result = (Concurrent_Dict_Reader*)allocate(dict->memory, sizeof(Concurrent_Dict_Reader), CONCURRENT_DICT::CACHE_LINE, CTZ::YES);
+        result->next = dict->readers;
+        dict->readers = result;
+    }
+
+    result->attached = 1;
+    spin_lock_release(&dict->lock);
+    return result;
+}
+
+// Lets another thread reuse the reader. It stays on its dict's list, so the dict isn't needed.
+function void
+concurrent_dict_detach(Concurrent_Dict_Reader* reader)
+{
+    ASSERT(reader->attached && reader->epoch == 0);
+    atomic_store(&reader->attached, 0u);
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function bool
+concurrent_dict_find(Concurrent_Dict<K, V, HASHER, EQ>* dict, Concurrent_Dict_Reader* reader, K const& key, V* value_out)
+{
+    using namespace CONCURRENT_DICT;
+    using Table = typename Concurrent_Dict<K, V, HASHER, EQ>::Table;
+    using Kvp = typename Concurrent_Dict<K, V, HASHER, EQ>::Kvp;
+
+    ASSERT(reader->attached);
+
+    u32 hash = key_hash<K, V, HASHER, EQ>(key);
+
+    // Announce our epoch before loading the table. The exchange is a full fence, so a grow either sees us
+    //  in reclaim(..), or swapped the table before we load it.
+    atomic_exchange(&reader->epoch, atomic_load(&dict->epoch));
+    Table* table = atomic_load(&dict->table);
+
+    bool result = false;
+    u32 mask = table->capacity - 1;
+    u32 index = hash & mask;
+    while (true)
+    {
+        Kvp* kvp = table->items + index;
+
+        u32 slot_hash = atomic_load(&kvp->hash);
+        if (slot_hash == HASH_UNOCCUPIED)
+            break;
+
+        if (slot_hash == hash && EQ::eq(kvp->key, key))
+        {
+            // Retry until we copy the value without a writer changing it mid-copy
+            while (true)
+            {
+                u32 version = atomic_load(&kvp->version);
+                if (version & 1)
+                {
+                    cpu_pause();
+                    continue;
+                }
+
+                V value = kvp->value;
+                atomic_fence_acquire();
+
+                if (atomic_load(&kvp->version) == version)
+                {
+                    *value_out = value;
+                    break;
+                }
+            }
+
+            result = true;
+            break;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    atomic_store(&reader->epoch, 0ull);
+    return result;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function bool
+concurrent_dict_contains(Concurrent_Dict<K, V, HASHER, EQ>* dict, Concurrent_Dict_Reader* reader, K const& key)
+{
+    V value;
+    bool result = concurrent_dict_find(dict, reader, key, &value);
+    return result;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+concurrent_dict_set(Concurrent_Dict<K, V, HASHER, EQ>* dict, K const& key, V const& value)
+{
+    using namespace CONCURRENT_DICT;
+    using Table = typename Concurrent_Dict<K, V, HASHER, EQ>::Table;
+    using Kvp = typename Concurrent_Dict<K, V, HASHER, EQ>::Kvp;
+
+    u32 hash = key_hash<K, V, HASHER, EQ>(key);
+    Spin_Lock* lock = stripe_lock(dict, hash);
+
+    while (true)
+    {
+        spin_lock_acquire(lock);
+
+        // Can't be swapped out while we hold a stripe
+        Table* table = dict->table;
+        u32 mask = table->capacity - 1;
+
+        // Only writers holding our stripe write slots with our hash, so if the key is here, we'll see it
+        u32 index = hash & mask;
+        while (true)
+        {
+            Kvp* kvp = table->items + index;
+
+            u32 slot_hash = atomic_load(&kvp->hash);
+            if (slot_hash == HASH_UNOCCUPIED)
+                break;
+
+            if (slot_hash == hash && EQ::eq(kvp->key, key))
+            {
+                atomic_add(&kvp->version, 1u);
+                kvp->value = value;
+                atomic_add(&kvp->version, 1u);
+
+                spin_lock_release(lock);
+                return;
+            }
+
+            index = (index + 1) & mask;
+        }
+
+        // Reserve a slot, unless that would put the table over its load factor
+        u32 count_filled = atomic_add(&dict->count_filled, 1u);
+        if ((i64)(count_filled + 1) * 100 > (i64)table->capacity * MAX_LOAD_FACTOR)
+        {
+            atomic_add(&dict->count_filled, (u32)-1);
+            spin_lock_release(lock);
+
+            grow(dict, table);
+            continue;
+        }
+
+        // Writers in other stripes might be after the same empty slot
+        index = hash & mask;
+        Kvp* kvp;
+        while (true)
+        {
+            kvp = table->items + index;
+            if (atomic_load(&kvp->hash) == HASH_UNOCCUPIED &&
+                atomic_compare_exchange(&kvp->hash, HASH_UNOCCUPIED, HASH_CLAIMED))
+            {
+                break;
+            }
+
+            index = (index + 1) & mask;
+        }
+
+        kvp->key = key;
+        kvp->value = value;
+        atomic_store(&kvp->hash, hash);     // Publishes the key and value
+        atomic_add(&dict->count, 1u);
+
+        spin_lock_release(lock);
+        return;
+    }
+}
+
+// Returns false if the key wasn't there
+template <typename K, typename V, typename HASHER, typename EQ>
+function bool
+concurrent_dict_remove(Concurrent_Dict<K, V, HASHER, EQ>* dict, K const& key)
+{
+    using namespace CONCURRENT_DICT;
+    using Table = typename Concurrent_Dict<K, V, HASHER, EQ>::Table;
+    using Kvp = typename Concurrent_Dict<K, V, HASHER, EQ>::Kvp;
+
+    u32 hash = key_hash<K, V, HASHER, EQ>(key);
+    Spin_Lock* lock = stripe_lock(dict, hash);
+    spin_lock_acquire(lock);
+
+    Table* table = dict->table;
+    u32 mask = table->capacity - 1;
+
+    bool result = false;
+    u32 index = hash & mask;
+    while (true)
+    {
+        Kvp* kvp = table->items + index;
+
+        u32 slot_hash = atomic_load(&kvp->hash);
+        if (slot_hash == HASH_UNOCCUPIED)
+            break;
+
+        if (slot_hash == hash && EQ::eq(kvp->key, key))
+        {
+            // The slot isn't reused until the next grow, so readers comparing its key are safe
+            atomic_store(&kvp->hash, HASH_REMOVED);
+            atomic_add(&dict->count, (u32)-1);
+            result = true;
+            break;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    spin_lock_release(lock);
+    return result;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function i32
+concurrent_dict_count(Concurrent_Dict<K, V, HASHER, EQ>* dict)
+{
+    i32 result = (i32)atomic_load(&dict->count);
+    return result;
+}
@@ -0,0 +1,409 @@
+#pragma once
+
+// --- Robin Hood dictionary
+//  Drop-in alternative to Dict for remove-heavy tables. Same API (dict_find_ptr, dict_set, dict_remove, ...),
+//  but created with robin_hood_dict_create(..).
+//
+//  Linear probing, but an insert takes the slot of any item that's closer to its home slot than the new
+//  item would be ("steals from the rich"). That keeps probe lengths short and even, and lets a lookup stop
+//  as soon as it reaches an item closer to home than the key would be. Removes shift the following items
+//  back a slot instead of leaving a tombstone, so churn never fills the table with dead slots.
+//
+//  An item's probe length is derived from its stored hash and its slot, so it costs no extra memory.
+
+namespace ROBIN_HOOD
+{
+static constexpr i32 CAPACITY_MIN = 16;
+static constexpr i32 MAX_LOAD_FACTOR_DEFAULT = 85;
+static constexpr int PROBE_LENGTH_HISTOGRAM_COUNT = 16;
+}
+
+template <typename K, typename V>
+struct Robin_Hood_Dict
+{
+    struct Kvp
+    {
+        static u32 constexpr HASH_UNOCCUPIED = 0;
+
+        u32 hash;
+        K key;
+        V value;
+    };
+
+    i32 max_load_factor;    // Percentage, 1-99
+    i32 count;              // Valid item count. No tombstones, so this is also the filled count.
+    i32 capacity;           // Power of 2. Grows when max_load_factor is exceeded.
+
+    // User provided functions
+    u32 (*key_hash)(K const& key);
+    bool (*key_eq)(K const& key0, K const& key1);
+
+    Memory_Region memory;
+    Kvp* items;
+
+    struct Iter
+    {
+        Kvp* cursor;
+        Kvp* end;
+        bool operator!=(Iter const& other) const { return cursor != other.cursor; }
+        Kvp& operator*() const { return *cursor; }
+        Kvp* operator->() const { return cursor; }
+        Iter& operator++()
+        {
+            cursor++;
+            while (cursor < end && cursor->hash == Kvp::HASH_UNOCCUPIED) cursor++;
+            return *this;
+        }
+    };
+
+    Iter end() const { return Iter{ items + capacity, items + capacity }; }
+    Iter begin() const
+    {
+        if (count == 0) return end();
+        Iter result = Iter{ items, items + capacity };
+        if (items[0].hash == Kvp::HASH_UNOCCUPIED) ++result; // overloaded ++ iterates until valid
+        return result;
+    }
+};
+
+// Probe length is the number of slots a successful lookup visits, so an item in its home slot has 1
+struct Robin_Hood_Dict_Stats
+{
+    i32 count;
+    i32 capacity;
+    i32 probe_length_max;
+    f32 probe_length_mean;
+    i32 probe_length_histogram[ROBIN_HOOD::PROBE_LENGTH_HISTOGRAM_COUNT];   // Last bucket counts everything longer
+};
+
+namespace ROBIN_HOOD
+{
+
+function u32
+hash_valid(u32 hash)
+{
+    // Hash 0 marks an unoccupied slot
+    u32 result = (hash == 0) ? 1 : hash;
+    return result;
+}
+
+// How far an item in this slot is from its home slot
+function u32
+distance_from_home(u32 hash, u32 index, u32 mask)
+{
+    u32 result = (index - hash) & mask;
+    return result;
+}
+
+// Places an item that's known not to be in the table yet. Returns where it landed. The table must have room.
+template <typename K, typename V>
+function typename Robin_Hood_Dict<K, V>::Kvp*
+insert(Robin_Hood_Dict<K, V>* dict, typename Robin_Hood_Dict<K, V>::Kvp const& kvp)
+{
+    using Kvp = typename Robin_Hood_Dict<K, V>::Kvp;
+
+    Kvp carry = kvp;
+
+    u32 mask = dict->capacity - 1;
+    u32 index = carry.hash & mask;
+    u32 distance = 0;
+
+    Kvp* result = nullptr;
+    while (true)
+    {
+        Kvp* slot = dict->items + index;
+        if (slot->hash == Kvp::HASH_UNOCCUPIED)
+        {
+            *slot = carry;
+            if (!result) result = slot;
+            break;
+        }
+
+        // Whoever is closer to home gives up the slot, and carries on probing
+        u32 slot_distance = distance_from_home(slot->hash, index, mask);
+        if (slot_distance < distance)
+        {
+            mem_swap(slot, &carry);
+            if (!result) result = slot;
+            distance = slot_distance;
+        }
+
+        index = (index + 1) & mask;
+        distance++;
+    }
+
+    dict->count++;
+    return result;
+}
+
+template <typename K, typename V>
+function void
+rehash(Robin_Hood_Dict<K, V>* dict, i32 new_capacity)
+{
+    using Kvp = typename Robin_Hood_Dict<K, V>::Kvp;
+
+    Slice<Kvp> old_items = slice_create(dict->items, dict->capacity);
+
+    dict->items = (Kvp*)allocate_tracked(dict->memory, new_capacity * sizeof(Kvp));
+    dict->count = 0;
+    dict->capacity = new_capacity;
+
+    for (Kvp* kvp: ByPtr(slice_create(dict->items, dict->capacity)))
+    {
+        kvp->hash = Kvp::HASH_UNOCCUPIED;
+    }
+
+    // Re-add old items. Their hashes are stored, so no need to recompute them.
+    for (Kvp const& kvp: old_items)
+    {
+        if (kvp.hash != Kvp::HASH_UNOCCUPIED)
+        {
+            insert(dict, kvp);
+        }
+    }
+
+    if (old_items.items)
+    {
+        free_tracked_allocation(dict->memory, old_items.items);
+    }
+}
+
+} // namespace ROBIN_HOOD
+
+// Grows the table so that it can store at least this many items within its load factor
+template <typename K, typename V>
+function void
+dict_ensure_capacity(Robin_Hood_Dict<K, V>* dict, i32 capacity)
+{
+    i32 new_capacity = max(dict->capacity, ROBIN_HOOD::CAPACITY_MIN);
+    new_capacity = u32_ceil_power_of_2(new_capacity);
+
+    while ((i64)new_capacity * dict->max_load_factor < (i64)capacity * 100)
+    {
+        new_capacity *= 2;
+    }
+
+    if (dict->capacity >= new_capacity)
+        return;
+
+    ROBIN_HOOD::rehash(dict, new_capacity);
+}
+
+// This function has no qualms about adding a duplicate key. Use wisely!
+template <typename K, typename V>
+function typename Robin_Hood_Dict<K, V>::Kvp*
+dict_add_key_unchecked(Robin_Hood_Dict<K, V>* dict, K const& key)
+{
+    using namespace ROBIN_HOOD;
+    using Kvp = typename Robin_Hood_Dict<K, V>::Kvp;
+
+    dict_ensure_capacity(dict, dict->count + 1);
+
+    Kvp kvp;
+    kvp.hash = hash_valid(dict->key_hash(key));
+    kvp.key = key;
+
+    Kvp* result = insert(dict, kvp);
+    return result;
+}
+
+// This function has no qualms about adding a duplicate key. Use wisely!
+template <typename K, typename V>
+function void
+dict_add_unchecked(Robin_Hood_Dict<K, V>* dict, K const& key, V const& value)
+{
+    auto* kvp = dict_add_key_unchecked(dict, key);
+    kvp->value = value;
+}
+
+template <typename K, typename V>
+function typename Robin_Hood_Dict<K, V>::Kvp*
+dict_find_kvp_ptr(Robin_Hood_Dict<K, V> const& dict, K const& key)
+{
+    using namespace ROBIN_HOOD;
+    using Kvp = typename Robin_Hood_Dict<K, V>::Kvp;
+
+    if (dict.count == 0)
+        return nullptr;
+
+    u32 hash = hash_valid(dict.key_hash(key));
+
+    u32 mask = dict.capacity - 1;
+    u32 index = hash & mask;
+    u32 distance = 0;
+
+    while (true)
+    {
+        Kvp* slot = dict.items + index;
+        if (slot->hash == hash && dict.key_eq(slot->key, key))
+            return slot;
+
+        if (slot->hash == Kvp::HASH_UNOCCUPIED)
+            return nullptr;
+
+        // If the key were here, it would have taken this slot when it was inserted
+        if (distance_from_home(slot->hash, index, mask) < distance)
+            return nullptr;
+
+        index = (index + 1) & mask;
+        distance++;
+    }
+}
+
+template <typename K, typename V>
+function V*
+dict_find_ptr(Robin_Hood_Dict<K, V> const& dict, K const& key)
+{
+    V* result = nullptr;
+    if (auto* kvp = dict_find_kvp_ptr(dict, key))
+    {
+        result = &kvp->value;
+    }
+    return result;
+}
+
+template <typename K, typename V>
+function V
+dict_find(Robin_Hood_Dict<K, V> const& dict, K const& key, bool* success=nullptr)
+{
+    if (V* result = dict_find_ptr(dict, key))
+    {
+        if (success) *success = true;
+        return *result;
+    }
+
+    if (success) *success = false;
+    return V{};
+}
+
+template <typename K, typename V>
+function V*
+dict_find_or_new(Robin_Hood_Dict<K, V>* dict, K const& key)
+{
+    if (V* value_ptr = dict_find_ptr(*dict, key))
+        return value_ptr;
+
+    V* result = &dict_add_key_unchecked(dict, key)->value;
+    return result;
+}
+
+template <typename K, typename V>
+function bool
+dict_contains(Robin_Hood_Dict<K, V> const& dict, K const& key)
+{
+    bool result = (dict_find_ptr(dict, key) != nullptr);
+    return result;
+}
+
+template <typename K, typename V>
+function void
+dict_set(Robin_Hood_Dict<K, V>* dict, K const& key, V const& value)
+{
+    if (V* value_ptr = dict_find_ptr(*dict, key))
+    {
+        *value_ptr = value;
+    }
+    else
+    {
+        dict_add_unchecked(dict, key, value);
+    }
+}
+
+template <typename K, typename V>
+function bool
+dict_remove(Robin_Hood_Dict<K, V>* dict, K const& key)
+{
+    using namespace ROBIN_HOOD;
+    using Kvp = typename Robin_Hood_Dict<K, V>::Kvp;
+
+    Kvp* kvp = dict_find_kvp_ptr(*dict, key);
+    if (!kvp)
+        return false;
+
+    u32 mask = dict->capacity - 1;
+    u32 index = (u32)(kvp - dict->items);
+
+    // Backward shift: pull each following item one slot closer to home, until reaching an empty slot or an
+    //  item that's already home. Leaves the table exactly as if the removed key was never inserted.
+    while (true)
+    {
+        u32 index_next = (index + 1) & mask;
+        Kvp* next = dict->items + index_next;
+
+        if (next->hash == Kvp::HASH_UNOCCUPIED ||
+            distance_from_home(next->hash, index_next, mask) == 0)
+        {
+            break;
+        }
+
+        dict->items[index] = *next;
+        index = index_next;
+    }
+
+    dict->items[index].hash = Kvp::HASH_UNOCCUPIED;
+    dict->count--;
+    return true;
+}
+
+template <typename K, typename V>
+function Robin_Hood_Dict<K, V>
+robin_hood_dict_create(
+    Memory_Region memory,
+    u32 (*key_hash)(K const& key),
+    bool (*key_eq)(K const& key0, K const& key1),
+    i32 starting_capacity=16)
+{
+    Robin_Hood_Dict<K, V> result = {};
+    result.max_load_factor = ROBIN_HOOD::MAX_LOAD_FACTOR_DEFAULT;
+    result.key_hash = key_hash;
+    result.key_eq = key_eq;
+    result.memory = memory;
+    dict_ensure_capacity(&result, starting_capacity);
+    return result;
+}
+
+template <typename K, typename V>
+function void
+dict_reset(Robin_Hood_Dict<K, V>* dict)
+{
+    using Kvp = typename Robin_Hood_Dict<K, V>::Kvp;
+
+    dict->count = 0;
+    for (int i = 0; i < dict->capacity; i++)
+    {
+        dict->items[i].hash = Kvp::HASH_UNOCCUPIED;
+    }
+}
+
+// Walks the whole table. Meant for tuning and diagnostics, not hot paths.
+template <typename K, typename V>
+function Robin_Hood_Dict_Stats
+robin_hood_dict_stats(Robin_Hood_Dict<K, V> const& dict)
+{
+    using namespace ROBIN_HOOD;
+
+    Robin_Hood_Dict_Stats result = {};
+    result.count = dict.count;
+    result.capacity = dict.capacity;
+
+    u32 mask = dict.capacity - 1;
+    u64 probe_length_sum = 0;
+    for (i32 i = 0; i < dict.capacity; i++)
+    {
+        u32 hash = dict.items[i].hash;
+        if (hash == Robin_Hood_Dict<K, V>::Kvp::HASH_UNOCCUPIED)
+            continue;
+
+        i32 probe_length = (i32)distance_from_home(hash, i, mask) + 1;
+        probe_length_sum += probe_length;
+        result.probe_length_max = max(result.probe_length_max, probe_length);
+        result.probe_length_histogram[min(probe_length, PROBE_LENGTH_HISTOGRAM_COUNT) - 1]++;
+    }
+
+    if (dict.count > 0)
+    {
+        result.probe_length_mean = (f32)((f64)probe_length_sum / dict.count);
+    }
+
+    return result;
+}
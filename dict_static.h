@@ -0,0 +1,534 @@
+#pragma once
+
+// --- Static dictionary
+//  Immutable table for data that's built once and then only read. Built from a finished Dict, or from slices
+//  of keys and values, with static_dict_create(..). Read-only subset of the Dict API (dict_find_ptr,
+//  dict_find, dict_contains, iteration).
+//
+//  Minimal perfect hashing, CHD / PTHash style: keys are hashed into small buckets (~3 keys each), and each
+//  bucket stores a "pilot" that was searched for at build time, such that every key lands in its own slot.
+//  There are exactly as many slots as keys, and a lookup reads one pilot and one slot, with no probing. A
+//  missing key still lands on some slot, so the key is compared to confirm a hit.
+//
+//  Finding a free slot for the last few keys gets slow as the table fills up, so the search runs over ~1%
+//  more slots than there are keys. Keys that land past the end are remapped to the slots that are left over,
+//  at the cost of one more read for those ~1% of lookups.
+//
+//  Keys are hashed to 64 bits with a HASHER policy (e.g. U32_Hasher64), then mixed with the table's seed. If a build
+//  gets unlucky, it retries with another seed. Keys with identical 64 bit hashes can never be separated, so
+//  the hashes for integer keys are the identity, and the seeded mix does the scrambling.
+//
+//  Pilots are 16 bits, so on top of the items, the table costs under a byte per key. The items, remap and
+//  pilots live in one allocation, so io_static_dict(..) (de)serializes a few header atoms and one blob.
+//  Loading is a single read into place, with no rebuild. That requires K and V to be trivially copyable,
+//  without pointers, e.g. not String. (A String keyed table can still be built in memory.)
+
+namespace STATIC_DICT
+{
+static constexpr i32 BUCKET_SIZE_TARGET = 3;    // Fewer, bigger buckets take less memory, but longer to build
+static constexpr i32 SEARCH_LOAD_FACTOR = 99;   // Percentage, see above
+static constexpr u32 PILOT_TRY_MAX = U16::MAX + 1;  // Pilots average ~35 tries, and stay in the low thousands
+static constexpr int SEED_TRY_MAX = 8;
+static constexpr uintptr ALIGNMENT = 64;
+}
+
+// 64 bit hash policies, plain structs like U32_Hasher. Identity for integers, see above.
+struct U32_Hasher64
+{
+    static u64 hash(u32 const& key) { return key; }
+};
+
+struct U64_Hasher64
+{
+    static u64 hash(u64 const& key) { return key; }
+};
+
+struct String_Hasher64
+{
+    static u64 hash(String const& key) { return string_hash64(key); }
+};
+
+template <typename K, typename V, typename HASHER, typename EQ>
+struct Static_Dict
+{
+    struct Kvp
+    {
+        K key;
+        V value;
+    };
+
+    i32 count;              // Also the slot count, since every slot holds an item
+    i32 bucket_count;
+    i32 search_slot_count;  // Slots that pilots pick from. Derived from count.
+    u64 seed;
+
+    // One allocation, in this order
+    Kvp* items;             // Indexed by slot
+    u32* remap;             // Indexed by search slot - count. Where keys that landed past the end went.
+    u16* pilots;            // Indexed by bucket
+    Memory_Region memory;
+
+    Kvp* begin() const { return items; }
+    Kvp* end() const { return items + count; }
+};
+
+namespace STATIC_DICT
+{
+
+// Maps a 32 bit value into [0, range) with a multiply instead of a divide
+function u32
+reduce(u32 value, u32 range)
+{
+    u32 result = (u32)(((u64)value * range) >> 32);
+    return result;
+}
+
+template <typename K, typename HASHER>
+function u64
+key_hash(K const& key, u64 seed)
+{
+    u64 result = HASH::mix(HASH::mix(HASHER::hash(key) ^ seed, HASH::P1), HASH::P2);
+    return result;
+}
+
+function u32
+bucket_from_hash(u64 hash, i32 bucket_count)
+{
+    u32 result = reduce((u32)(hash >> 32), (u32)bucket_count);
+    return result;
+}
+
+function u32
+slot_from_hash(u64 hash, u32 pilot, i32 slot_count)
+{
+    // Multiplying carries every bit of (hash ^ pilot) into the high half, so keys that share a bucket (and
+    //  so the high half of their hash) still scatter independently for each pilot
+    u64 mixed = (hash ^ (pilot * HASH::P2)) * HASH::P3;
+    u32 result = reduce((u32)(mixed >> 32), (u32)slot_count);
+    return result;
+}
+
+function i32
+bucket_count_from_count(i32 count)
+{
+    i32 result = (count + BUCKET_SIZE_TARGET - 1) / BUCKET_SIZE_TARGET;
+    return result;
+}
+
+function i32
+search_slot_count_from_count(i32 count)
+{
+    i32 result = (i32)((i64)count * 100 / SEARCH_LOAD_FACTOR) + 1;
+    return result;
+}
+
+function uintptr
+items_byte_count(uintptr kvp_byte_count, i32 count)
+{
+    // Rounded up, so what follows is aligned
+    uintptr result = kvp_byte_count * count;
+    result += mem_align_offset(result, sizeof(u64));
+    return result;
+}
+
+function uintptr
+table_byte_count(uintptr kvp_byte_count, i32 count)
+{
+    uintptr result = items_byte_count(kvp_byte_count, count);
+    result += sizeof(u32) * (search_slot_count_from_count(count) - count);
+    result += sizeof(u16) * bucket_count_from_count(count);
+    return result;
+}
+
+// Points dict into a table allocation, laid out for dict->count
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+set_table(Static_Dict<K, V, HASHER, EQ>* dict, u8* table)
+{
+    using Kvp = typename Static_Dict<K, V, HASHER, EQ>::Kvp;
+
+    dict->bucket_count = bucket_count_from_count(dict->count);
+    dict->search_slot_count = search_slot_count_from_count(dict->count);
+    dict->items = (Kvp*)table;
+    dict->remap = (u32*)(table + items_byte_count(sizeof(Kvp), dict->count));
+    dict->pilots = (u16*)(dict->remap + (dict->search_slot_count - dict->count));
+}
+
+// Searches for a pilot per bucket, such that every hash lands in its own search slot. Buckets are placed
+//  biggest first, while there's plenty of room. Then fills in remap, and the final slot for each key.
+//  Returns false if some bucket can't be placed, and the caller should retry with another seed.
+function bool
+place_buckets(Slice<u64> hashes, u16* pilots, u32* remap, u32* key_slots)
+{
+    i32 count = (i32)hashes.count;
+    i32 bucket_count = bucket_count_from_count(count);
+    i32 search_slot_count = search_slot_count_from_count(count);
+    Scratch scratch = scratch_begin((count + 2 * (bucket_count + 1)) * sizeof(u32) + search_slot_count);
+
+    // --- Sort keys by bucket (counting sort)
+    u32* bucket_starts = allocate_array<u32>(scratch.memory, bucket_count + 1, CTZ::YES);
+    for (u64 hash : hashes)
+    {
+        bucket_starts[bucket_from_hash(hash, bucket_count) + 1]++;
+    }
+
+    i32 bucket_size_max = 0;
+    for (i32 i = 0; i < bucket_count; i++)
+    {
+        bucket_size_max = max(bucket_size_max, (i32)bucket_starts[i + 1]);
+        bucket_starts[i + 1] += bucket_starts[i];
+    }
+
+    u32* keys_by_bucket = allocate_array<u32>(scratch.memory, count);
+    {
+        u32* cursors = allocate_array<u32>(scratch.memory, bucket_count);
+        mem_copy(cursors, bucket_starts, sizeof(u32) * bucket_count);
+        for (i32 i = 0; i < count; i++)
+        {
+            keys_by_bucket[cursors[bucket_from_hash(hashes[i], bucket_count)]++] = i;
+        }
+    }
+
+    // --- Order buckets biggest first (counting sort on size)
+    u32* size_starts = allocate_array<u32>(scratch.memory, bucket_size_max + 2, CTZ::YES);
+    for (i32 i = 0; i < bucket_count; i++)
+    {
+        i32 size = bucket_starts[i + 1] - bucket_starts[i];
+        size_starts[bucket_size_max - size + 1]++;
+    }
+
+    for (i32 i = 0; i <= bucket_size_max; i++)
+    {
+        size_starts[i + 1] += size_starts[i];
+    }
+
+    u32* bucket_order = allocate_array<u32>(scratch.memory, bucket_count);
+    for (i32 i = 0; i < bucket_count; i++)
+    {
+        i32 size = bucket_starts[i + 1] - bucket_starts[i];
+        bucket_order[size_starts[bucket_size_max - size]++] = i;
+    }
+
+    // --- Place each bucket
+    u8* taken = allocate_array<u8>(scratch.memory, search_slot_count, CTZ::YES);
+    u32* bucket_slots = allocate_array<u32>(scratch.memory, bucket_size_max);
+
+    bool result = true;
+    for (i32 i = 0; i < bucket_count && result; i++)
+    {
+        u32 bucket = bucket_order[i];
+        u32* bucket_keys = keys_by_bucket + bucket_starts[bucket];
+        i32 size = bucket_starts[bucket + 1] - bucket_starts[bucket];
+
+        pilots[bucket] = 0;
+        if (size == 0)
+            continue;
+
+        // Identical hashes land together for every pilot
+        for (i32 a = 0; a < size && result; a++)
+        {
+            for (i32 b = a + 1; b < size; b++)
+            {
+                if (hashes[bucket_keys[a]] == hashes[bucket_keys[b]])
+                {
+                    result = false;
+                    break;
+                }
+            }
+        }
+
+        for (u32 pilot = 0; result; pilot++)
+        {
+            if (pilot == STATIC_DICT::PILOT_TRY_MAX)
+            {
+                result = false;
+                break;
+            }
+
+            i32 placed = 0;
+            while (placed < size)
+            {
+                u32 slot = slot_from_hash(hashes[bucket_keys[placed]], pilot, search_slot_count);
+                if (taken[slot])
+                    break;
+
+                taken[slot] = 1;
+                bucket_slots[placed] = slot;
+                placed++;
+            }
+
+            if (placed == size)
+            {
+                pilots[bucket] = (u16)pilot;
+                for (i32 k = 0; k < size; k++)
+                {
+                    key_slots[bucket_keys[k]] = bucket_slots[k];
+                }
+                break;
+            }
+
+            // Undo the partial placement
+            for (i32 k = 0; k < placed; k++)
+            {
+                taken[bucket_slots[k]] = 0;
+            }
+        }
+    }
+
+    // --- Send keys that landed past the end to the slots left free before it. There are exactly as many.
+    if (result)
+    {
+        i32 free_cursor = 0;
+        for (i32 slot = count; slot < search_slot_count; slot++)
+        {
+            // Only misses land on a free search slot, and whatever key they're sent to will reject them
+            u32 target = 0;
+            if (taken[slot])
+            {
+                while (taken[free_cursor]) free_cursor++;
+                target = free_cursor++;
+            }
+
+            remap[slot - count] = target;
+        }
+
+        for (i32 k = 0; k < count; k++)
+        {
+            if (key_slots[k] >= (u32)count)
+            {
+                key_slots[k] = remap[key_slots[k] - count];
+            }
+        }
+    }
+
+    scratch_end(scratch);
+    return result;
+}
+
+} // namespace STATIC_DICT
+
+// Keys must be unique. On failure (duplicate keys, or no seed worked out) returns an empty table, which finds
+//  nothing.
+template <typename K, typename V, typename HASHER, typename EQ>
+function Static_Dict<K, V, HASHER, EQ>
+static_dict_create(Memory_Region memory, Slice<K> keys, Slice<V> values, bool* success=nullptr)
+{
+    using namespace STATIC_DICT;
+    using Kvp = typename Static_Dict<K, V, HASHER, EQ>::Kvp;
+
+    ASSERT(keys.count == values.count);
+
+    Static_Dict<K, V, HASHER, EQ> result = {};
+    result.memory = memory;
+
+    i32 count = (i32)keys.count;
+    if (count == 0)
+    {
+        if (success) *success = true;
+        return result;
+    }
+
+    Scratch scratch = scratch_begin(memory, count * (sizeof(u64) + sizeof(u32)));
+    u64* hashes = allocate_array<u64>(scratch.memory, count);
+    u32* key_slots = allocate_array<u32>(scratch.memory, count);
+
+    result.count = count;
+    set_table(&result, (u8*)allocate_tracked(memory, table_byte_count(sizeof(Kvp), count), ALIGNMENT));
+
+    bool placed = false;
+    u64 seed = HASH::P0;
+    for (int i = 0; i < SEED_TRY_MAX && !placed; i++)
+    {
+        seed = HASH::mix(seed, HASH::P3 + i);
+        for (i32 k = 0; k < count; k++)
+        {
+            hashes[k] = key_hash<K, HASHER>(keys[k], seed);
+        }
+
+        placed = place_buckets(slice_create(hashes, count), result.pilots, result.remap, key_slots);
+    }
+
+    if (placed)
+    {
+        result.seed = seed;
+        for (i32 k = 0; k < count; k++)
+        {
+            Kvp* kvp = result.items + key_slots[k];
+            kvp->key = keys[k];
+            kvp->value = values[k];
+        }
+    }
+    else
+    {
+        free_tracked_allocation(memory, result.items);
+        result = {};
+        result.memory = memory;
+    }
+
+    scratch_end(scratch);
+
+    if (success) *success = placed;
+    return result;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ, typename DICT_HASHER, typename DICT_EQ>
+function Static_Dict<K, V, HASHER, EQ>
+static_dict_create(Memory_Region memory, Dict<K, V, DICT_HASHER, DICT_EQ> const& dict, bool* success=nullptr)
+{
+    Scratch scratch = scratch_begin(memory, dict.count * (sizeof(K) + sizeof(V)));
+    K* keys = allocate_array<K>(scratch.memory, dict.count);
+    V* values = allocate_array<V>(scratch.memory, dict.count);
+
+    i32 count = 0;
+    for (auto const& kvp : dict)
+    {
+        keys[count] = kvp.key;
+        values[count] = kvp.value;
+        count++;
+    }
+    ASSERT(count == dict.count);
+
+    Static_Dict<K, V, HASHER, EQ> result = static_dict_create<K, V, HASHER, EQ>(
+        memory,
+        slice_create(keys, count),
+        slice_create(values, count),
+        success);
+
+    scratch_end(scratch);
+    return result;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function void
+static_dict_destroy(Static_Dict<K, V, HASHER, EQ>* dict)
+{
+    if (dict->items)
+    {
+        free_tracked_allocation(dict->memory, dict->items);
+    }
+
+    Memory_Region memory = dict->memory;
+    *dict = {};
+    dict->memory = memory;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function typename Static_Dict<K, V, HASHER, EQ>::Kvp*
+dict_find_kvp_ptr(Static_Dict<K, V, HASHER, EQ> const& dict, K const& key)
+{
+    using namespace STATIC_DICT;
+
+    if (dict.count == 0)
+        return nullptr;
+
+    u64 hash = key_hash<K, HASHER>(key, dict.seed);
+    u32 pilot = dict.pilots[bucket_from_hash(hash, dict.bucket_count)];
+
+    u32 slot = slot_from_hash(hash, pilot, dict.search_slot_count);
+    if (slot >= (u32)dict.count)
+    {
+        slot = dict.remap[slot - dict.count];
+    }
+
+    auto* result = dict.items + slot;
+    if (!EQ::eq(result->key, key))
+        return nullptr;
+
+    return result;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function V*
+dict_find_ptr(Static_Dict<K, V, HASHER, EQ> const& dict, K const& key)
+{
+    V* result = nullptr;
+    if (auto* kvp = dict_find_kvp_ptr(dict, key))
+    {
+        result = &kvp->value;
+    }
+    return result;
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function V
+dict_find(Static_Dict<K, V, HASHER, EQ> const& dict, K const& key, bool* success=nullptr)
+{
+    if (V* result = dict_find_ptr(dict, key))
+    {
+        if (success) *success = true;
+        return *result;
+    }
+
+    if (success) *success = false;
+    return V{};
+}
+
+template <typename K, typename V, typename HASHER, typename EQ>
+function bool
+dict_contains(Static_Dict<K, V, HASHER, EQ> const& dict, K const& key)
+{
+    bool result = (dict_find_kvp_ptr(dict, key) != nullptr);
+    return result;
+}
+
+// When deserializing, *dict is replaced by a table allocated from io->memory. The visitor must support blobs.
+//  Returns false if the stored table doesn't match this Static_Dict type.
+template <typename K, typename V, typename HASHER, typename EQ>
+function bool
+io_static_dict(Io_Vtable* io, Static_Dict<K, V, HASHER, EQ>* dict, String name)
+{
+    using namespace STATIC_DICT;
+    using Kvp = typename Static_Dict<K, V, HASHER, EQ>::Kvp;
+
+    STATIC_ASSERT(__is_trivially_copyable(Kvp));
+
+    if (!io_supports_blob(io))
+    {
+        ASSERT_FALSE_WARN;
+        return false;
+    }
+
+    io->object_begin(io, name, Io_Ctx_Flags::NIL);
+
+    // Everything else about the layout follows from count
+    u32 kvp_byte_count = sizeof(Kvp);
+    i32 count = dict->count;
+    u64 seed = dict->seed;
+
+    io->atom_u32(io, &kvp_byte_count, STR("kvp_byte_count"));
+    io->atom_i32(io, &count, STR("count"));
+    io->atom_u64(io, &seed, STR("seed"));
+
+    bool result = (kvp_byte_count == sizeof(Kvp));
+    if (result)
+    {
+        Slice<u8> table;
+        table.count = (count > 0) ? (i32)table_byte_count(sizeof(Kvp), count) : 0;
+
+        if (io_is_deserializing(io))
+        {
+            static_dict_destroy(dict);
+
+            dict->memory = io->memory;
+            dict->count = count;
+            dict->seed = seed;
+
+            table.items = nullptr;
+            if (count > 0)
+            {
+                table.items = (u8*)allocate_tracked(io->memory, table.count, ALIGNMENT);
+                set_table(dict, table.items);
+            }
+        }
+        else
+        {
+            table.items = (u8*)dict->items;
+        }
+
+        // The whole table, in one read
+        io->atom_blob(io, table, STR("table"));
+    }
+
+    io->object_end(io);
+    return result;
+}
@@ -0,0 +1,441 @@
+#pragma once
+
+// --- Swiss table dictionary
+//  Drop-in alternative to Dict for big tables. Same API (dict_find_ptr, dict_set, dict_remove, ...), but
+//  created with swiss_dict_create(..).
+//
+//  Each slot has a control byte in a separate array, holding 7 bits of the key's hash (or EMPTY / DELETED).
+//  Probing compares a group of 16 control bytes at once with SSE2, and only touches a slot's key when its
+//  hash fragment matches, so a lookup usually reads one cache line of control bytes plus the one key it's
+//  looking for. Keys and values live in their own array, out of the probe path.
+//
+//  A remove only leaves a DELETED tombstone if some probe may have passed over the slot. Otherwise the slot
+//  goes straight back to EMPTY. When tombstones do pile up, the table is rehashed at the same capacity
+//  instead of growing.
+//
+//  Based on Abseil's flat_hash_map: https://abseil.io/about/design/swisstables
+
+namespace SWISS
+{
+static constexpr u32 GROUP_WIDTH = 16;
+
+// Full slots are 0b0xxxxxxx, where x is 7 bits of the hash. Both of these have the high bit set.
+static constexpr i8 CTRL_EMPTY = (i8)0b10000000;
+static constexpr i8 CTRL_DELETED = (i8)0b11111110;
+
+static constexpr i32 CAPACITY_MIN = GROUP_WIDTH;
+static constexpr i32 MAX_LOAD_FACTOR_DEFAULT = 87;
+
+struct Hash
+{
+    u32 h1;     // Picks the starting slot. 25 bits, so it never shares bits with h2.
+    i8 h2;      // Stored in the control byte
+};
+
+function Hash
+hash_split(u32 hash)
+{
+    // Mix first, so weak hashes (e.g. u32_identity) still spread over both parts. The low bits of a plain
+    //  product only depend on the low bits of the hash, so fold the high half of a widening multiply back
+    //  in. Otherwise keys that only differ in their high bits (aligned pointers, i << 16) would all start
+    //  probing at the same group.
+    u64 product = (u64)hash * 0x9E3779B97F4A7C15ull;
+    u32 mixed = (u32)product ^ (u32)(product >> 32);
+
+    Hash result;
+    result.h1 = mixed >> 7;
+    result.h2 = (i8)(mixed & 0x7F);
+    return result;
+}
+
+// Bit i is set if control byte i of the group matches
+function u32
+group_match(i8 const* group, i8 h2)
+{
+    __m128i ctrl = _mm_loadu_si128((__m128i const*)group);
+    u32 result = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+    return result;
+}
+
+function u32
+group_match_empty(i8 const* group)
+{
+    u32 result = group_match(group, CTRL_EMPTY);
+    return result;
+}
+
+function u32
+group_match_empty_or_deleted(i8 const* group)
+{
+    // Only EMPTY and DELETED have the high bit set
+    __m128i ctrl = _mm_loadu_si128((__m128i const*)group);
+    u32 result = (u32)_mm_movemask_epi8(ctrl);
+    return result;
+}
+
+// The first GROUP_WIDTH control bytes are mirrored past the end, so a group can be loaded at any slot.
+function void
+ctrl_set(i8* ctrl, u32 mask, u32 index, i8 value)
+{
+    ctrl[index] = value;
+    ctrl[((index - GROUP_WIDTH) & mask) + GROUP_WIDTH] = value;
+}
+
+// Probes visit groups at triangular offsets, which reaches every group when the capacity is a power of 2
+function u32
+probe_next(u32 position, u32* stride, u32 mask)
+{
+    *stride += GROUP_WIDTH;
+    u32 result = (position + *stride) & mask;
+    return result;
+}
+
+} // namespace SWISS
+
+template <typename K, typename V>
+struct Swiss_Dict
+{
+    struct Kvp
+    {
+        K key;
+        V value;
+    };
+
+    i32 max_load_factor;    // Percentage, 1-99
+    i32 count;              // Valid item count
+    i32 count_deleted;      // Tombstones. Count against the load factor like valid items do.
+    i32 capacity;           // Power of 2, at least SWISS::CAPACITY_MIN
+
+    // User provided functions
+    u32 (*key_hash)(K const& key);
+    bool (*key_eq)(K const& key0, K const& key1);
+
+    Memory_Region memory;
+    Kvp* items;
+    i8* ctrl;               // capacity + GROUP_WIDTH bytes, in the same allocation as items
+
+    struct Iter
+    {
+        Swiss_Dict const* dict;
+        i32 index;
+        bool operator!=(Iter const& other) const { return index != other.index; }
+        Kvp& operator*() const { return dict->items[index]; }
+        Kvp* operator->() const { return dict->items + index; }
+        Iter& operator++()
+        {
+            index++;
+            while (index < dict->capacity && dict->ctrl[index] < 0) index++;
+            return *this;
+        }
+    };
+
+    Iter end() const { return Iter{ this, capacity }; }
+    Iter begin() const
+    {
+        Iter result = Iter{ this, -1 };
+        ++result;
+        return result;
+    }
+};
+
+namespace SWISS
+{
+
+template <typename K, typename V>
+function i32
+growth_limit(Swiss_Dict<K, V> const& dict)
+{
+    i32 result = (i32)((i64)dict.capacity * dict.max_load_factor / 100);
+    return result;
+}
+
+// Index of the first EMPTY or DELETED slot on the hash's probe sequence
+template <typename K, typename V>
+function u32
+find_first_non_full(Swiss_Dict<K, V> const& dict, Hash hash)
+{
+    u32 mask = dict.capacity - 1;
+    u32 position = hash.h1 & mask;
+    u32 stride = 0;
+
+    while (true)
+    {
+        int bit;
+        if (bitscan_lsb_index(group_match_empty_or_deleted(dict.ctrl + position), &bit))
+        {
+            u32 result = (position + bit) & mask;
+            return result;
+        }
+
+        position = probe_next(position, &stride, mask);
+    }
+}
+
+template <typename K, typename V>
+function void
+rehash(Swiss_Dict<K, V>* dict, i32 new_capacity)
+{
+    using Kvp = typename Swiss_Dict<K, V>::Kvp;
+
+    ASSERT(new_capacity >= CAPACITY_MIN);
+    ASSERT(u32_ceil_power_of_2(new_capacity) == (u32)new_capacity);
+
+    Kvp* old_items = dict->items;
+    i8* old_ctrl = dict->ctrl;
+    i32 old_capacity = dict->capacity;
+
+    uintptr items_byte_count = new_capacity * sizeof(Kvp);
+    uintptr ctrl_byte_count = new_capacity + GROUP_WIDTH;
+    u8* bytes = (u8*)allocate_tracked(dict->memory, items_byte_count + ctrl_byte_count, alignof(Kvp));
+
+    dict->items = (Kvp*)bytes;
+    dict->ctrl = (i8*)(bytes + items_byte_count);
+    dict->capacity = new_capacity;
+    dict->count_deleted = 0;
+    mem_set(dict->ctrl, (u8)CTRL_EMPTY, ctrl_byte_count);
+
+    // Re-add old items. Keys are known to be unique, so no need to compare them.
+    u32 mask = new_capacity - 1;
+    for (i32 i = 0; i < old_capacity; i++)
+    {
+        if (old_ctrl[i] < 0)
+            continue;
+
+        Hash hash = hash_split(dict->key_hash(old_items[i].key));
+        u32 index = find_first_non_full(*dict, hash);
+        ctrl_set(dict->ctrl, mask, index, hash.h2);
+        dict->items[index] = old_items[i];
+    }
+
+    if (old_items)
+    {
+        free_tracked_allocation(dict->memory, old_items);
+    }
+}
+
+} // namespace SWISS
+
+// Grows the table so that it can store at least this many items within its load factor
+template <typename K, typename V>
+function void
+dict_ensure_capacity(Swiss_Dict<K, V>* dict, i32 capacity)
+{
+    i32 new_capacity = max(dict->capacity, SWISS::CAPACITY_MIN);
+    new_capacity = u32_ceil_power_of_2(new_capacity);
+
+    while ((i64)new_capacity * dict->max_load_factor < (i64)capacity * 100)
+    {
+        new_capacity *= 2;
+    }
+
+    if (dict->capacity >= new_capacity)
+        return;
+
+    SWISS::rehash(dict, new_capacity);
+}
+
+// This function has no qualms about adding a duplicate key. Use wisely!
+template <typename K, typename V>
+function typename Swiss_Dict<K, V>::Kvp*
+dict_add_key_unchecked(Swiss_Dict<K, V>* dict, K const& key)
+{
+    using namespace SWISS;
+
+    if (dict->count + dict->count_deleted + 1 > growth_limit(*dict))
+    {
+        // If a good share of the limit is tombstones, clean them out instead of growing. Leaves at least 1/8
+        //  of the limit free, so these rehashes are amortized over that many inserts.
+        bool should_grow = ((i64)(dict->count + 1) * 8 > (i64)growth_limit(*dict) * 7);
+        rehash(dict, should_grow ? dict->capacity * 2 : dict->capacity);
+    }
+
+    Hash hash = hash_split(dict->key_hash(key));
+    u32 index = find_first_non_full(*dict, hash);
+
+    if (dict->ctrl[index] == CTRL_DELETED)
+    {
+        dict->count_deleted--;
+    }
+
+    ctrl_set(dict->ctrl, dict->capacity - 1, index, hash.h2);
+    dict->count++;
+
+    auto* result = dict->items + index;
+    result->key = key;
+    return result;
+}
+
+// This function has no qualms about adding a duplicate key. Use wisely!
+template <typename K, typename V>
+function void
+dict_add_unchecked(Swiss_Dict<K, V>* dict, K const& key, V const& value)
+{
+    auto* kvp = dict_add_key_unchecked(dict, key);
+    kvp->value = value;
+}
+
+template <typename K, typename V>
+function typename Swiss_Dict<K, V>::Kvp*
+dict_find_kvp_ptr(Swiss_Dict<K, V> const& dict, K const& key)
+{
+    using namespace SWISS;
+
+    if (dict.count == 0)
+        return nullptr;
+
+    Hash hash = hash_split(dict.key_hash(key));
+
+    u32 mask = dict.capacity - 1;
+    u32 position = hash.h1 & mask;
+    u32 stride = 0;
+
+    // Most keys are within a few slots of their home slot. Start pulling in their items while the control
+    //  bytes load, so big tables pay for one cache miss instead of two in a row.
+    _mm_prefetch((char const*)(dict.items + position), _MM_HINT_T0);
+
+    while (true)
+    {
+        i8 const* group = dict.ctrl + position;
+
+        u32 matches = group_match(group, hash.h2);
+        int bit;
+        while (bitscan_lsb_index(matches, &bit))
+        {
+            u32 index = (position + bit) & mask;
+            if (dict.key_eq(dict.items[index].key, key))
+                return dict.items + index;
+
+            matches &= matches - 1;
+        }
+
+        // An EMPTY slot ends the probe sequence. The table always has one, since the load factor is < 100%.
+        if (group_match_empty(group))
+            return nullptr;
+
+        position = probe_next(position, &stride, mask);
+    }
+}
+
+template <typename K, typename V>
+function V*
+dict_find_ptr(Swiss_Dict<K, V> const& dict, K const& key)
+{
+    V* result = nullptr;
+    if (auto* kvp = dict_find_kvp_ptr(dict, key))
+    {
+        result = &kvp->value;
+    }
+    return result;
+}
+
+template <typename K, typename V>
+function V
+dict_find(Swiss_Dict<K, V> const& dict, K const& key, bool* success=nullptr)
+{
+    if (V* result = dict_find_ptr(dict, key))
+    {
+        if (success) *success = true;
+        return *result;
+    }
+
+    if (success) *success = false;
+    return V{};
+}
+
+template <typename K, typename V>
+function V*
+dict_find_or_new(Swiss_Dict<K, V>* dict, K const& key)
+{
+    if (V* value_ptr = dict_find_ptr(*dict, key))
+        return value_ptr;
+
+    V* result = &dict_add_key_unchecked(dict, key)->value;
+    return result;
+}
+
+template <typename K, typename V>
+function bool
+dict_contains(Swiss_Dict<K, V> const& dict, K const& key)
+{
+    bool result = (dict_find_ptr(dict, key) != nullptr);
+    return result;
+}
+
+template <typename K, typename V>
+function void
+dict_set(Swiss_Dict<K, V>* dict, K const& key, V const& value)
+{
+    if (V* value_ptr = dict_find_ptr(*dict, key))
+    {
+        *value_ptr = value;
+    }
+    else
+    {
+        dict_add_unchecked(dict, key, value);
+    }
+}
+
+template <typename K, typename V>
+function bool
+dict_remove(Swiss_Dict<K, V>* dict, K const& key)
+{
+    using namespace SWISS;
+
+    auto* kvp = dict_find_kvp_ptr(*dict, key);
+    if (!kvp)
+        return false;
+
+    u32 mask = dict->capacity - 1;
+    u32 index = (u32)(kvp - dict->items);
+
+    // If every 16-slot window containing this slot also has an EMPTY, then no probe ever saw this group as
+    //  full, so no probe continued past it. The slot can go straight back to EMPTY.
+    u32 empty_after = group_match_empty(dict->ctrl + index);
+    u32 empty_before = group_match_empty(dict->ctrl + ((index - GROUP_WIDTH) & mask));
+
+    int first_empty_after;
+    int last_empty_before;
+    bool was_never_full =
+        bitscan_lsb_index(empty_after, &first_empty_after) &&
+        bitscan_msb_index(empty_before, &last_empty_before) &&
+        (first_empty_after + (int)(GROUP_WIDTH - 1 - last_empty_before)) < (int)GROUP_WIDTH;
+
+    if (was_never_full)
+    {
+        ctrl_set(dict->ctrl, mask, index, CTRL_EMPTY);
+    }
+    else
+    {
+        ctrl_set(dict->ctrl, mask, index, CTRL_DELETED);
+        dict->count_deleted++;
+    }
+
+    dict->count--;
+    return true;
+}
+
+template <typename K, typename V>
+function Swiss_Dict<K, V>
+swiss_dict_create(
+    Memory_Region memory,
+    u32 (*key_hash)(K const& key),
+    bool (*key_eq)(K const& key0, K const& key1),
+    i32 starting_capacity=16)
+{
+    Swiss_Dict<K, V> result = {};
+    result.max_load_factor = SWISS::MAX_LOAD_FACTOR_DEFAULT;
+    result.key_hash = key_hash;
+    result.key_eq = key_eq;
+    result.memory = memory;
+    dict_ensure_capacity(&result, starting_capacity);
+    return result;
+}
+
+template <typename K, typename V>
+function void
+dict_reset(Swiss_Dict<K, V>* dict)
+{
+    dict->count = 0;
+    dict->count_deleted = 0;
+    mem_set(dict->ctrl, (u8)SWISS::CTRL_EMPTY, dict->capacity + SWISS::GROUP_WIDTH);
+}
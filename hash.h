@@ -0,0 +1,413 @@
+#pragma once
+
+// --- 64-bit byte hashing
+//  wyhash-style. Reads 8 bytes at a time and mixes with a 64x64 -> 128 bit multiply. Up to 16 bytes is a
+//  couple of loads and one mix, with no loop. Long inputs run 8 independent lanes over 64 byte stripes
+//  (xxh3-style), so the multiplies overlap instead of forming one long dependency chain. AVX2 does four
+//  lanes per instruction, SSE2 two. Every path computes the same result, so hashes don't depend on the CPU.
+//
+//  hash64_lowercase(..) hashes as if ASCII A-Z were a-z, so it agrees with string_eq_lowercase(..).
+//
+//  Not cryptographic! Don't use on untrusted keys where engineered collisions are a concern.
+
+#ifndef HASH_SIMD_ENABLE
+ #define HASH_SIMD_ENABLE MEM_SIMD_ENABLE   // Shares its AVX2 detection
+#endif
+
+#if HASH_SIMD_ENABLE && !MEM_SIMD_ENABLE
+ #error "HASH_SIMD_ENABLE needs MEM_SIMD_ENABLE, which detects the CPU's SIMD level (MEM::simd_level)"
+#endif
+
+namespace HASH
+{
+
+static constexpr u64 P0 = 0xA0761D6478BD642Full;
+static constexpr u64 P1 = 0xE7037ED1A0B428DBull;
+static constexpr u64 P2 = 0x8EBC6AF09C88C6E3ull;
+static constexpr u64 P3 = 0x589965CC75374CC3ull;
+
+static constexpr uintptr LONG_MIN_BYTE_COUNT = 512;     // Below this, setting up and merging lanes costs more than it saves
+static constexpr uintptr STRIPE_BYTE_COUNT = 64;
+static constexpr int LANE_COUNT = 8;
+static constexpr int STRIPES_PER_SCRAMBLE = 16;
+static constexpr u32 SCRAMBLE_PRIME = 0x9E3779B1;
+
+// [0, 8) are lane keys, [8, 16) are scramble and merge keys
+static constexpr u64 SECRET[16] = {
+    0x2CB0F69F4ABEA221ull, 0x9417034723148989ull, 0xDD555950609DFE03ull, 0xDBAFB150DEB12800ull,
+    0x7E789B2E6C442CB6ull, 0xF41E5636C7E4F8C4ull, 0x0959D150F8FBA7E4ull, 0xA97316F13CDB9EEAull,
+    0x74CD8258F9520068ull, 0x55C74A62E116868Bull, 0xD2F4C799A2023CBDull, 0xDF98CB79A37B51B9ull,
+    0x396F5885524F3905ull, 0xAF1D56386CA3B276ull, 0xA9FFBE6B5104E85Aull, 0x6BD0C51B9FD533B3ull,
+};
+
+// Full 128 bit product. Low half in *a, high half in *b.
+function void
+mum(u64* a, u64* b)
+{
+#if COMPILER_MSVC
+    u64 hi;
+    u64 lo = _umul128(*a, *b, &hi);
+#else
+    __uint128_t product = (__uint128_t)*a * *b;
+    u64 lo = (u64)product;
+    u64 hi = (u64)(product >> 64);
+#endif
+
+    *a = lo;
+    *b = hi;
+}
+
+function u64
+mix(u64 a, u64 b)
+{
+    mum(&a, &b);
+    return a ^ b;
+}
+
+// Lowercases the ASCII letters in all 8 bytes at once. Bytes >= 0x80 are left alone.
+function u64
+fold_ascii_lower(u64 word)
+{
+    u64 constexpr ONES = 0x0101010101010101ull;
+    u64 constexpr HIGH_BITS = 0x8080808080808080ull;
+
+    // Clear the high bits so the adds below can't carry into the next byte. The high bit of each byte of
+    //  ge_a is then set iff the byte >= 'A', and likewise for gt_z and 'Z'.
+    u64 low_bits = word & ~HIGH_BITS;
+    u64 ge_a = low_bits + (0x80 - 'A') * ONES;
+    u64 gt_z = low_bits + (0x80 - 'Z' - 1) * ONES;
+    u64 is_upper = (ge_a ^ gt_z) & ~word & HIGH_BITS;
+
+    // 0x80 >> 2 == 'a' - 'A'
+    return word | (is_upper >> 2);
+}
+
+template <bool FOLD>
+function u64
+read64(u8 const* bytes)
+{
+    u64 result = (u64)_mm_cvtsi128_si64(_mm_loadl_epi64((__m128i const*)bytes));
+    if (FOLD) result = fold_ascii_lower(result);
+    return result;
+}
+
+function u64
+read32(u8 const* bytes)
+{
+    u64 result = (u64)bytes[0] | ((u64)bytes[1] << 8) | ((u64)bytes[2] << 16) | ((u64)bytes[3] << 24);
+    return result;
+}
+
+#if HASH_SIMD_ENABLE
+
+template <bool FOLD>
+function __m128i
+load128(u8 const* bytes)
+{
+    __m128i result = _mm_loadu_si128((__m128i const*)bytes);
+    if (FOLD)
+    {
+        // Signed compares, so bytes >= 0x80 are never in range
+        __m128i is_upper = _mm_and_si128(
+            _mm_cmpgt_epi8(result, _mm_set1_epi8('A' - 1)),
+            _mm_cmplt_epi8(result, _mm_set1_epi8('Z' + 1)));
+
+        result = _mm_or_si128(result, _mm_and_si128(is_upper, _mm_set1_epi8('a' - 'A')));
+    }
+    return result;
+}
+
+// Each lane: acc += (the other lane's data) + lo32(data ^ key) * hi32(data ^ key)
+template <bool FOLD>
+function void
+accumulate_stripe(__m128i* acc, u8 const* stripe, __m128i const* keys)
+{
+    for (int i = 0; i < LANE_COUNT / 2; i++)
+    {
+        __m128i data = load128<FOLD>(stripe + 16 * i);
+        __m128i keyed = _mm_xor_si128(data, keys[i]);
+        __m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+        __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(swapped, product));
+    }
+}
+
+// Each lane: acc = ((acc ^ (acc >> 47)) ^ key) * SCRAMBLE_PRIME
+function void
+scramble(__m128i* acc)
+{
+    __m128i prime = _mm_set1_epi32((int)SCRAMBLE_PRIME);
+    for (int i = 0; i < LANE_COUNT / 2; i++)
+    {
+        __m128i key = _mm_loadu_si128((__m128i const*)(SECRET + 8 + 2 * i));
+        __m128i value = _mm_xor_si128(_mm_xor_si128(acc[i], _mm_srli_epi64(acc[i], 47)), key);
+
+        // 64 x 32 bit multiply, from two 32 x 32 -> 64 bit ones
+        __m128i lo = _mm_mul_epu32(value, prime);
+        __m128i hi = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+        acc[i] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+    }
+}
+
+template <bool FOLD>
+MEM_TARGET_AVX2 function __m256i
+load256(u8 const* bytes)
+{
+    __m256i result = _mm256_loadu_si256((__m256i const*)bytes);
+    if (FOLD)
+    {
+        __m256i is_upper = _mm256_and_si256(
+            _mm256_cmpgt_epi8(result, _mm256_set1_epi8('A' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), result));
+
+        result = _mm256_or_si256(result, _mm256_and_si256(is_upper, _mm256_set1_epi8('a' - 'A')));
+    }
+    return result;
+}
+
+template <bool FOLD>
+MEM_TARGET_AVX2 function void
+accumulate_stripe_avx2(__m256i* acc, u8 const* stripe, __m256i const* keys)
+{
+    for (int i = 0; i < LANE_COUNT / 4; i++)
+    {
+        __m256i data = load256<FOLD>(stripe + 32 * i);
+        __m256i keyed = _mm256_xor_si256(data, keys[i]);
+        __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+        __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        acc[i] = _mm256_add_epi64(acc[i], _mm256_add_epi64(swapped, product));
+    }
+}
+
+MEM_TARGET_AVX2 function void
+scramble_avx2(__m256i* acc)
+{
+    __m256i prime = _mm256_set1_epi32((int)SCRAMBLE_PRIME);
+    for (int i = 0; i < LANE_COUNT / 4; i++)
+    {
+        __m256i key = _mm256_loadu_si256((__m256i const*)(SECRET + 8 + 4 * i));
+        __m256i value = _mm256_xor_si256(_mm256_xor_si256(acc[i], _mm256_srli_epi64(acc[i], 47)), key);
+
+        __m256i lo = _mm256_mul_epu32(value, prime);
+        __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+        acc[i] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+    }
+}
+
+template <bool FOLD>
+MEM_TARGET_AVX2 function void
+accumulate_long_avx2(u64* lanes, u8 const* bytes, uintptr byte_count, u64 seed)
+{
+    __m256i acc[LANE_COUNT / 4];
+    __m256i keys[LANE_COUNT / 4];
+    for (int i = 0; i < LANE_COUNT / 4; i++)
+    {
+        acc[i] = _mm256_loadu_si256((__m256i const*)(SECRET + 8 + 4 * i));
+        keys[i] = _mm256_xor_si256(_mm256_loadu_si256((__m256i const*)(SECRET + 4 * i)), _mm256_set1_epi64x((i64)seed));
+    }
+
+    uintptr stripe_count = (byte_count - 1) / STRIPE_BYTE_COUNT;
+    for (uintptr i = 0; i < stripe_count; i++)
+    {
+        accumulate_stripe_avx2<FOLD>(acc, bytes + i * STRIPE_BYTE_COUNT, keys);
+        if ((i + 1) % STRIPES_PER_SCRAMBLE == 0)
+        {
+            scramble_avx2(acc);
+        }
+    }
+    accumulate_stripe_avx2<FOLD>(acc, bytes + byte_count - STRIPE_BYTE_COUNT, keys);
+
+    _mm256_storeu_si256((__m256i*)lanes, acc[0]);
+    _mm256_storeu_si256((__m256i*)(lanes + 4), acc[1]);
+}
+
+template <bool FOLD>
+function void
+accumulate_long(u64* lanes, u8 const* bytes, uintptr byte_count, u64 seed)
+{
+    if (MEM::simd_level == MEM::Simd_Level::AVX2)
+    {
+        accumulate_long_avx2<FOLD>(lanes, bytes, byte_count, seed);
+        return;
+    }
+
+    __m128i acc[LANE_COUNT / 2];
+    __m128i keys[LANE_COUNT / 2];
+    for (int i = 0; i < LANE_COUNT / 2; i++)
+    {
+        acc[i] = _mm_loadu_si128((__m128i const*)(SECRET + 8 + 2 * i));
+        keys[i] = _mm_xor_si128(_mm_loadu_si128((__m128i const*)(SECRET + 2 * i)), _mm_set1_epi64x((i64)seed));
+    }
+
+    // The last stripe is always done separately below, overlapping whatever came before it
+    uintptr stripe_count = (byte_count - 1) / STRIPE_BYTE_COUNT;
+    for (uintptr i = 0; i < stripe_count; i++)
+    {
+        accumulate_stripe<FOLD>(acc, bytes + i * STRIPE_BYTE_COUNT, keys);
+        if ((i + 1) % STRIPES_PER_SCRAMBLE == 0)
+        {
+            scramble(acc);
+        }
+    }
+    accumulate_stripe<FOLD>(acc, bytes + byte_count - STRIPE_BYTE_COUNT, keys);
+
+    mem_copy(lanes, acc, sizeof(acc));
+}
+
+#else // !HASH_SIMD_ENABLE
+
+template <bool FOLD>
+function void
+accumulate_stripe(u64* acc, u8 const* stripe, u64 const* keys)
+{
+    for (int i = 0; i < LANE_COUNT; i++)
+    {
+        u64 keyed = read64<FOLD>(stripe + 8 * i) ^ keys[i];
+        acc[i] += read64<FOLD>(stripe + 8 * (i ^ 1)) + (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+}
+
+function void
+scramble(u64* acc)
+{
+    for (int i = 0; i < LANE_COUNT; i++)
+    {
+        acc[i] = (acc[i] ^ (acc[i] >> 47) ^ SECRET[8 + i]) * SCRAMBLE_PRIME;
+    }
+}
+
+template <bool FOLD>
+function void
+accumulate_long(u64* lanes, u8 const* bytes, uintptr byte_count, u64 seed)
+{
+    u64 keys[LANE_COUNT];
+    for (int i = 0; i < LANE_COUNT; i++)
+    {
+        lanes[i] = SECRET[8 + i];
+        keys[i] = SECRET[i] ^ seed;
+    }
+
+    // The last stripe is always done separately below, overlapping whatever came before it
+    uintptr stripe_count = (byte_count - 1) / STRIPE_BYTE_COUNT;
+    for (uintptr i = 0; i < stripe_count; i++)
+    {
+        accumulate_stripe<FOLD>(lanes, bytes + i * STRIPE_BYTE_COUNT, keys);
+        if ((i + 1) % STRIPES_PER_SCRAMBLE == 0)
+        {
+            scramble(lanes);
+        }
+    }
+    accumulate_stripe<FOLD>(lanes, bytes + byte_count - STRIPE_BYTE_COUNT, keys);
+}
+
+#endif // !HASH_SIMD_ENABLE
+
+template <bool FOLD>
+function u64
+hash64_long(u8 const* bytes, uintptr byte_count, u64 seed)
+{
+    u64 lanes[LANE_COUNT];
+    accumulate_long<FOLD>(lanes, bytes, byte_count, seed);
+
+    u64 result = byte_count * P0;
+    for (int i = 0; i < LANE_COUNT; i += 2)
+    {
+        result += mix(lanes[i] ^ SECRET[8 + i], lanes[i + 1] ^ SECRET[9 + i]);
+    }
+
+    // Avalanche
+    result ^= result >> 37;
+    result *= 0x165667919E3779F9ull;
+    result ^= result >> 32;
+    return result;
+}
+
+template <bool FOLD>
+function u64
+hash64(u8 const* bytes, uintptr byte_count, u64 seed)
+{
+    if (byte_count >= LONG_MIN_BYTE_COUNT)
+        return hash64_long<FOLD>(bytes, byte_count, seed);
+
+    seed ^= mix(seed ^ P0, P1);
+
+    u64 a;
+    u64 b;
+    if (byte_count <= 16)
+    {
+        if (byte_count >= 4)
+        {
+            // Two overlapping pairs of 4 byte reads cover 4-16 bytes
+            uintptr mid = (byte_count >> 3) << 2;
+            a = (read32(bytes) << 32) | read32(bytes + mid);
+            b = (read32(bytes + byte_count - 4) << 32) | read32(bytes + byte_count - 4 - mid);
+        }
+        else if (byte_count > 0)
+        {
+            a = ((u64)bytes[0] << 16) | ((u64)bytes[byte_count >> 1] << 8) | bytes[byte_count - 1];
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+
+        if (FOLD)
+        {
+            a = fold_ascii_lower(a);
+            b = fold_ascii_lower(b);
+        }
+    }
+    else
+    {
+        u8 const* cursor = bytes;
+        uintptr remaining = byte_count;
+        if (remaining > 48)
+        {
+            u64 seed1 = seed;
+            u64 seed2 = seed;
+            do
+            {
+                seed = mix(read64<FOLD>(cursor) ^ P1, read64<FOLD>(cursor + 8) ^ seed);
+                seed1 = mix(read64<FOLD>(cursor + 16) ^ P2, read64<FOLD>(cursor + 24) ^ seed1);
+                seed2 = mix(read64<FOLD>(cursor + 32) ^ P3, read64<FOLD>(cursor + 40) ^ seed2);
+                cursor += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remaining > 16)
+        {
+            seed = mix(read64<FOLD>(cursor) ^ P1, read64<FOLD>(cursor + 8) ^ seed);
+            cursor += 16;
+            remaining -= 16;
+        }
+
+        // The last 16 bytes, overlapping whatever came before them
+        a = read64<FOLD>(cursor + remaining - 16);
+        b = read64<FOLD>(cursor + remaining - 8);
+    }
+
+    a ^= P1;
+    b ^= seed;
+    mum(&a, &b);
+    return mix(a ^ P0 ^ byte_count, b ^ P1);
+}
+
+} // namespace HASH
+
+function u64
+hash64(void const* bytes, uintptr byte_count, u64 seed=0)
+{
+    return HASH::hash64<false>((u8 const*)bytes, byte_count, seed);
+}
+
+// Same as hash64(..) of the bytes with ASCII A-Z lowercased
+function u64
+hash64_lowercase(void const* bytes, uintptr byte_count, u64 seed=0)
+{
+    return HASH::hash64<true>((u8 const*)bytes, byte_count, seed);
+}
@@ -1098,23 +1098,10 @@ io_json_reader_find_array_item(Io_Json_Reader* io_json, int index)
         return {};
     }
 
-    // Copy the index raw bytes into a string for the dictionary key. Little endian.
-    // String hash/eq can handle 0 bytes since String is length-based, not 0-terminated.
-    u8 index_string_buffer[4] = {
-        (u8)(index >> 0),
-        (u8)(index >> 8),
-        (u8)(index >> 16),
-        (u8)(index >> 24)
-    };
-
-    String index_string;
-    index_string.data = index_string_buffer;
-    index_string.length = 4;
-
     // --- Early out if we've already parsed over this index
     if (index < ctx->values.count)
     {
-        if (Io_Json_Value* found = dict_find_ptr(ctx->values, index_string))
+        if (Io_Json_Value* found = dict_find_ptr(ctx->values, (u32)index))
         {
             return *found;
         }
@@ -1132,7 +1119,7 @@ io_json_reader_find_array_item(Io_Json_Reader* io_json, int index)
         if (io_json_reader_match_and_consume(io_json, STR("]")))
         {
             // --- Pop context. We didn't find the index.
-            mem_region_end(ctx->memory);
+            scratch_end(ctx->scratch);
             array_remove_last(&io_json->ctx_stack);
             return {};
         }
@@ -1144,20 +1131,11 @@ io_json_reader_find_array_item(Io_Json_Reader* io_json, int index)
             VERIFY(io_json_reader_match_and_consume(io_json, STR(",")));
         }
 
-        u8 item_index_string_buffer[4] = {
-            (u8)(ctx->values.count >> 0),
-            (u8)(ctx->values.count >> 8),
-            (u8)(ctx->values.count >> 16),
-            (u8)(ctx->values.count >> 24)
-        };
-
-        String item_index_string;
-        item_index_string.data = item_index_string_buffer;
-        item_index_string.length = 4;
+        u32 item_index = (u32)ctx->values.count;
 
         // Parse value
         Io_Json_Value item = io_json_reader_parse_and_consume_value(io_json);
-        if (Io_Json_Value* found = dict_find_ptr(ctx->values, item_index_string))
+        if (Io_Json_Value* found = dict_find_ptr(ctx->values, item_index))
         {
             // We're trying to parse an index we've already parsed through.
             // This shouldn't be possible.
@@ -1165,12 +1143,10 @@ io_json_reader_find_array_item(Io_Json_Reader* io_json, int index)
         }
         else
         {
-            // Copy the "index as string" into longer term memory before storing it as the dict key.
-            String index_key = string_create(item_index_string, ctx->values.memory);
-            dict_set(&ctx->values, index_key, item);
+            dict_set(&ctx->values, item_index, item);
         }
 
-        if (string_eq(item_index_string, index_string))
+        if (item_index == (u32)index)
         {
             // Found it!
             return item;
@@ -1196,7 +1172,7 @@ io_json_reader_consume_next_property(Io_Json_Reader* io_json)
     if (io_json_reader_match_and_consume(io_json, STR("}")))
     {
         // --- Pop context. We didn't find a next property.
-        mem_region_end(ctx->memory);
+        scratch_end(ctx->scratch);
         array_remove_last(&io_json->ctx_stack);
         return {};
     }
@@ -1214,6 +1190,7 @@ io_json_reader_consume_next_property(Io_Json_Reader* io_json)
     // TODO - this name doesn't get un-escaped... it probably should...
     //  but it's not the end of the world if we don't support escape characters in property names... probably.
     String prop_name = io_json_reader_parse_and_consume_string(io_json);
+    u32 prop_name_id = string_intern(&io_json->names, prop_name);
 
     io_json_reader_consume_whitespace(io_json);
     VERIFY(io_json_reader_match_and_consume(io_json, STR(":")));
@@ -1221,7 +1198,7 @@ io_json_reader_consume_next_property(Io_Json_Reader* io_json)
     // Parse value
     Io_Json_Value value = io_json_reader_parse_and_consume_value(io_json);
 
-    if (Io_Json_Value* found = dict_find_ptr(ctx->values, prop_name))
+    if (Io_Json_Value* found = dict_find_ptr(ctx->values, prop_name_id))
     {
         // There are two properties with the same name!
         // Let's always use the first value for a given prop name.
@@ -1230,13 +1207,12 @@ io_json_reader_consume_next_property(Io_Json_Reader* io_json)
     }
     else
     {
-        // Dict key string points directly into file memory.
-        //  It's valid as long as the file is valid.
-        dict_set(&ctx->values, prop_name, value);
+        dict_set(&ctx->values, prop_name_id, value);
     }
 
     Io_Json_Property result;
     result.name = prop_name;
+    result.name_id = prop_name_id;
     result.value = value;
     return result;
 }
@@ -1251,15 +1227,18 @@ io_json_reader_find_property(Io_Json_Reader* io_json, String name)
         return {};
     }
 
+    // Names come from the visitor's fields, so interning them adds a handful of strings at most
+    u32 name_id = string_intern(&io_json->names, name);
+
     // --- Early out if we've already parsed over this property
-    if (Io_Json_Value* found = dict_find_ptr(ctx->values, name))
+    if (Io_Json_Value* found = dict_find_ptr(ctx->values, name_id))
         return *found;
 
     // --- Parse forward (validating the JSON as we go) until we find this property
     while (!slice_reader_is_finished(io_json->io_slice.reader))
     {
         Io_Json_Property prop = io_json_reader_consume_next_property(io_json);
-        if (prop.name.data && string_eq(prop.name, name))
+        if (prop.name.data && prop.name_id == name_id)
         {
             // Found it!
             return prop.value;
@@ -1317,6 +1296,19 @@ io_json_reader_parse_array_f32(Io_Json_Reader* io_json, Io_Json_Value array_valu
     return result_slice;
 }
 
+// Names are only interned for the file being read. Ids from an earlier file mean nothing in the next one.
+function void
+io_json_reader_reset_names(Io_Json_Reader* io_json)
+{
+    if (io_json->names_memory)
+    {
+        mem_region_end(io_json->names_memory);
+    }
+
+    io_json->names_memory = mem_region_begin(io_json->memory, KILOBYTES(4));
+    io_json->names = string_interner_create(io_json->names_memory);
+}
+
 inline void
 io_json_reader_begin(Io_Vtable* io, String name)
 {
@@ -1335,6 +1327,8 @@ io_json_reader_begin(Io_Vtable* io, String name)
     io_json->io_slice.reader = dummy.reader;
     io_json->file_loaded = (io_json->io_slice.reader.buffer.count > 0);
     ASSERT_WARN(io_json->file_loaded);
+
+    io_json_reader_reset_names(io_json);
 }
 
 inline void
@@ -1346,6 +1340,10 @@ io_json_reader_end(Io_Vtable* io)
     ASSERT(io_json->file_loaded);
     ASSERT(io_json->ctx_stack.count == 0);
 
+    mem_region_end(io_json->names_memory);
+    io_json->names_memory = nullptr;
+    io_json->names = {};
+
     io_slice_reader_end(io);
 }
 
@@ -1390,8 +1388,8 @@ io_json_reader_object_begin(Io_Vtable* io, String name, Io_Ctx_Flags ctx_flags)
     ctx->type = Io_Json_Ctx::OBJECT;
     ctx->start_index = object.start_index;
     ctx->length = object.length;
-    ctx->memory = mem_region_begin(io_json->memory, 64 * sizeof(Dict<String,i32>::Kvp));
-    ctx->values = dict_create<String, Io_Json_Value>(ctx->memory, string_hash, string_eq);
+    ctx->scratch = scratch_begin(io_json->memory, 64 * sizeof(Io_Json_Values::Kvp));
+    ctx->values = dict_create<u32, Io_Json_Value, U32_Hasher, U32_Eq>(ctx->scratch.memory);
 
     // Reset slice reader for the new context
     Slice_Reader* slice_reader = &io_json->io_slice.reader;
@@ -1414,7 +1412,7 @@ io_json_reader_object_end(Io_Vtable* io)
             ASSERT(ctx->length > 0);
 
             // Pop context
-            mem_region_end(ctx->memory);
+            scratch_end(ctx->scratch);
             array_remove_last(&io_json->ctx_stack);
         }
         else
@@ -1474,11 +1472,8 @@ io_json_reader_array_begin_i32(Io_Vtable* io, i32* length, String name, Io_Ctx_F
     ctx->type = Io_Json_Ctx::ARRAY;
     ctx->start_index = arr.start_index;
     ctx->length = arr.length;
-    ctx->memory = mem_region_begin(io_json->memory, 64 * sizeof(Dict<String,i32>::Kvp));
-    ctx->values = dict_create<String, Io_Json_Value>(
-                    ctx->memory,
-                    string_hash,
-                    string_eq);
+    ctx->scratch = scratch_begin(io_json->memory, 64 * sizeof(Io_Json_Values::Kvp));
+    ctx->values = dict_create<u32, Io_Json_Value, U32_Hasher, U32_Eq>(ctx->scratch.memory);
 
     // Reset slice reader for the new context
     Slice_Reader* slice_reader = &io_json->io_slice.reader;
@@ -1509,7 +1504,7 @@ io_json_reader_array_end(Io_Vtable* io)
             ASSERT(ctx->length > 0);
 
             // Pop context
-            mem_region_end(ctx->memory);
+            scratch_end(ctx->scratch);
             array_remove_last(&io_json->ctx_stack);
         }
         else
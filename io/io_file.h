@@ -89,17 +89,20 @@ struct Io_Json_Value
 struct Io_Json_Property
 {
     String name;
+    u32 name_id;            // name, interned in Io_Json_Reader::names
     Io_Json_Value value;
 };
 
+using Io_Json_Values = Dict<u32, Io_Json_Value, U32_Hasher, U32_Eq>;
+
 struct Io_Json_Reader_Ctx : Io_Json_Ctx
 {
-    Memory_Region memory;
+    Scratch scratch;                // Contexts are strictly nested, so their memory comes from the scratch arena
     int start_index;
     int length;
 
-    // Keys are property names for objects, and 4-byte index strings for arrays.
-    Dict<String, Io_Json_Value> values;
+    // Keys are interned property names for objects, and item indices for arrays.
+    Io_Json_Values values;
 };
 
 // --- I/O visitor that reads from a json file.
@@ -111,6 +114,8 @@ struct Io_Json_Reader
     Io_Slice_Reader io_slice;
     Memory_Region memory;
     DynArray<Io_Json_Reader_Ctx> ctx_stack;
+    String_Interner names;          // Property names, so each is hashed and compared once, not on every lookup
+    Memory_Region names_memory;     // Child of memory that holds names. Recreated for each file, so names don't pile up.
     Io_Fn_File_Read file_read_all;
     bool file_loaded;
 };
@@ -40,10 +40,10 @@ triangulate(Slice<Vec2> positions, Memory_Region memory)
     if (!VERIFY(positions.count > 2))
         return Slice<i32>{};
 
-    Memory_Region temp_memory = mem_region_begin(memory, KILOBYTES(1));
-
     int indices_to_clip_count = positions.count;
-    i32* indices_to_clip = (i32*)allocate(temp_memory, sizeof(i32) * indices_to_clip_count);
+
+    Scratch scratch = scratch_begin(memory, sizeof(i32) * indices_to_clip_count + KILOBYTES(1));
+    i32* indices_to_clip = (i32*)allocate(scratch.memory, sizeof(i32) * indices_to_clip_count);
 
     // Ensure ccw winding
     if (area_compute_signed_ccw(positions) >= 0)
@@ -132,7 +132,7 @@ triangulate(Slice<Vec2> positions, Memory_Region memory)
         }
     }
 
-    mem_region_end(temp_memory);
+    scratch_end(scratch);
     return slice_create(result, result_count);
 }
 
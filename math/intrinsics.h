@@ -340,6 +340,8 @@ u64_floor_power_of_2(u64 x)
 #if COMPILER_MSVC
 #pragma intrinsic(_BitScanReverse)
 #pragma intrinsic(_BitScanReverse64)
+#pragma intrinsic(_BitScanForward)
+#pragma intrinsic(_BitScanForward64)
 #endif
 
 inline bool
@@ -355,7 +357,12 @@ bitscan_msb_index(u32 value, int* out)
 
     return false;
 #else
-    ASSERT_TODO;
+    if (value)
+    {
+        *out = 31 - __builtin_clz(value);
+        return true;
+    }
+
     return false;
 #endif
 }
@@ -373,7 +380,58 @@ bitscan_msb_index(u64 value, int* out)
 
     return false;
 #else
-    ASSERT_TODO;
+    if (value)
+    {
+        *out = 63 - __builtin_clzll(value);
+        return true;
+    }
+
+    return false;
+#endif
+}
+
+inline bool
+bitscan_lsb_index(u32 value, int* out)
+{
+#if COMPILER_MSVC
+    unsigned long result;
+    if (_BitScanForward(&result, value))
+    {
+        *out = (int)result;
+        return true;
+    }
+
+    return false;
+#else
+    if (value)
+    {
+        *out = __builtin_ctz(value);
+        return true;
+    }
+
+    return false;
+#endif
+}
+
+inline bool
+bitscan_lsb_index(u64 value, int* out)
+{
+#if COMPILER_MSVC
+    unsigned long result;
+    if (_BitScanForward64(&result, value))
+    {
+        *out = (int)result;
+        return true;
+    }
+
+    return false;
+#else
+    if (value)
+    {
+        *out = __builtin_ctzll(value);
+        return true;
+    }
+
     return false;
 #endif
 }
@@ -1,9 +1,4 @@
-// IDEAS:
-// - Make headers smaller by having a u32 offset for left/right instead of pointers. This limits allocations to 8gb per (mul u32 by 4 and enforce 4-byte alignment)
-//
 // TODO:
-// - Alignment
-// - Re-alloc in place
 // - Audit for degenerate cases where things like overflow allocations are somehow too small to store an overflow + free header
 
 namespace MEM
@@ -17,6 +12,15 @@ Fn_System_allocate system_allocate = {};
 Fn_System_Reallocate system_reallocate = {};
 Fn_System_Free system_free = {};
 
+// Virtual memory. Only needed by regions created with mem_region_begin_virtual(..)
+using Fn_System_Reserve = void* (*) (uintptr);
+using Fn_System_Commit = bool (*) (void*, uintptr);
+using Fn_System_Release = void (*) (void*, uintptr);
+
+Fn_System_Reserve system_reserve = {};
+Fn_System_Commit system_commit = {};
+Fn_System_Release system_release = {};
+
 enum class Tracked_State : u8
 {
     FREE_UNSHARED,
@@ -24,6 +28,23 @@ enum class Tracked_State : u8
     ALLOCATED,
 };
 
+// Compact headers: tracked block headers store their size and neighbors as u32 counts of 8-byte units instead
+//  of pointers, which halves the per-allocation overhead (16 byte header, 32 byte minimum block, instead of 32
+//  and 48). Blocks are then limited to 32 gb, and are kept 8-byte aligned and sized. Free list links stay
+//  pointers, since a free list spans overflow blocks that can be anywhere in the address space.
+#ifndef MEM_COMPACT_HEADER_ENABLE
+ #define MEM_COMPACT_HEADER_ENABLE 0
+#endif
+
+#if MEM_COMPACT_HEADER_ENABLE
+struct Tracked_Block_Header
+{
+    u32 byte_count_units;           // Includes header. Use block_byte_count(..) and friends to access these.
+    u32 left_units;                 // Distance back to the physically adjacent block to our left. 0 if none.
+    u32 right_units;                // Distance forward to the block to our right. 0 if none.
+    Tracked_State state;
+};
+#else
 struct Tracked_Block_Header
 {
     uintptr byte_count;             // Includes header
@@ -31,6 +52,7 @@ struct Tracked_Block_Header
     Tracked_Block_Header* right;    // ...
     Tracked_State state;
 };
+#endif
 
 struct Free_Block_Header : Tracked_Block_Header
 {
@@ -46,6 +68,35 @@ struct Overflow_Header
 
 #define MEM_DEBUG_NAMES_ENABLE 1
 
+// Segregated fit: free unshared blocks are kept in unsorted power-of-2 size class bins, with a bitmap of
+//  non-empty bins. Finding, adding, and removing a free block are all O(1). When disabled, they are kept
+//  in a single list sorted by size, which is O(n) to add to.
+#ifndef MEM_SEGREGATED_FIT_ENABLE
+ #define MEM_SEGREGATED_FIT_ENABLE 1
+#endif
+
+// Stats: each region counts live/peak bytes, overflows, and reallocations. See mem_region_stats(..).
+//  Cheap enough to turn on in release builds when sizing regions.
+#ifndef MEM_STATS_ENABLE
+ #define MEM_STATS_ENABLE BUILD_DEBUG
+#endif
+
+namespace TRACKED_BIN
+{
+static constexpr int COUNT = 32;
+static constexpr int MIN_LOG2 = 5;      // Smallest tracked block is sizeof(Free_Block_Header), which is >= 2^5. Last bin holds everything >= 2^(MIN_LOG2 + COUNT - 1)
+}
+
+struct Region_Stats
+{
+    uintptr live_byte_count;            // Bytes handed out and not yet freed. Includes headers and alignment padding.
+    uintptr live_byte_count_peak;
+    u64 overflow_count;                 // total # of overflow blocks ever allocated. Not reset by mem_region_reset(..)
+    uintptr overflow_byte_count;        // ... and their total size
+    u64 reallocate_grow_count;          // total # of reallocate_tracked(..) calls that needed to grow
+    u64 reallocate_in_place_count;      // total # of those serviced in place, without a copy
+};
+
 struct Region_Header
 {
 #if MEM_DEBUG_NAMES_ENABLE
@@ -54,22 +105,113 @@ struct Region_Header
 #endif
 
     uintptr byte_budget;
+    uintptr reserved_byte_count;    // Non-zero if backed by reserved virtual memory. The first byte_budget bytes of it are committed.
 
     Region_Header* parent;
     Region_Header* first_child;
     Region_Header* next_sibling;
     Region_Header* prev_sibling;
     Overflow_Header* overflow;
+#if MEM_SEGREGATED_FIT_ENABLE
+    u32 tracked_bin_mask;                                       // Bit i is set iff tracked_bins[i] is non-empty
+    Free_Block_Header* tracked_bins[TRACKED_BIN::COUNT];        // Bin i holds blocks with byte_count in [2^(i + MIN_LOG2), 2^(i + MIN_LOG2 + 1))
+#else
     Free_Block_Header* tracked_list;
+#endif
     Free_Block_Header* shared_list;
+
+#if MEM_STATS_ENABLE
+    Region_Stats stats;
+#endif
 };
 
 namespace BYTE_COUNT
 {
 static constexpr uintptr TOO_SMALL_TO_BOTHER_TRACKING = sizeof(Free_Block_Header) + 63;
 static constexpr uintptr MINIMUM_REGION = sizeof(Region_Header) + 256;
+static constexpr uintptr VIRTUAL_COMMIT_GRANULARITY = KILOBYTES(64);
+static constexpr uintptr BLOCK_GRANULARITY = alignof(Free_Block_Header);     // Block addresses and sizes are multiples of this, so headers are always aligned
+}
+
+#if MEM_COMPACT_HEADER_ENABLE
+STATIC_ASSERT(sizeof(Tracked_Block_Header) == 16);
+#endif
+STATIC_ASSERT(sizeof(Tracked_Block_Header) % BYTE_COUNT::BLOCK_GRANULARITY == 0);
+STATIC_ASSERT(sizeof(Region_Header) % BYTE_COUNT::BLOCK_GRANULARITY == 0);
+STATIC_ASSERT(sizeof(Overflow_Header) % BYTE_COUNT::BLOCK_GRANULARITY == 0);
+
+// --- Tracked block header accessors. Free list links (next/prev) and state are accessed directly in either layout.
+
+#if MEM_COMPACT_HEADER_ENABLE
+
+function u32
+block_units_from_byte_count(uintptr byte_count)
+{
+    ASSERT(byte_count % BYTE_COUNT::BLOCK_GRANULARITY == 0);
+    ASSERT(byte_count / BYTE_COUNT::BLOCK_GRANULARITY <= U32::MAX);
+
+    u32 result = (u32)(byte_count / BYTE_COUNT::BLOCK_GRANULARITY);
+    return result;
+}
+
+function uintptr
+block_byte_count(Tracked_Block_Header* block)
+{
+    uintptr result = (uintptr)block->byte_count_units * BYTE_COUNT::BLOCK_GRANULARITY;
+    return result;
+}
+
+function void
+block_set_byte_count(Tracked_Block_Header* block, uintptr byte_count)
+{
+    block->byte_count_units = block_units_from_byte_count(byte_count);
+}
+
+function Tracked_Block_Header*
+block_left(Tracked_Block_Header* block)
+{
+    if (!block->left_units)
+        return nullptr;
+
+    Tracked_Block_Header* result = (Tracked_Block_Header*)((u8*)block - (uintptr)block->left_units * BYTE_COUNT::BLOCK_GRANULARITY);
+    return result;
+}
+
+function void
+block_set_left(Tracked_Block_Header* block, Tracked_Block_Header* left)
+{
+    ASSERT(!left || left < block);
+    block->left_units = left ? block_units_from_byte_count((u8*)block - (u8*)left) : 0;
+}
+
+function Tracked_Block_Header*
+block_right(Tracked_Block_Header* block)
+{
+    if (!block->right_units)
+        return nullptr;
+
+    Tracked_Block_Header* result = (Tracked_Block_Header*)((u8*)block + (uintptr)block->right_units * BYTE_COUNT::BLOCK_GRANULARITY);
+    return result;
 }
 
+function void
+block_set_right(Tracked_Block_Header* block, Tracked_Block_Header* right)
+{
+    ASSERT(!right || right > block);
+    block->right_units = right ? block_units_from_byte_count((u8*)right - (u8*)block) : 0;
+}
+
+#else
+
+function uintptr block_byte_count(Tracked_Block_Header* block) { return block->byte_count; }
+function void block_set_byte_count(Tracked_Block_Header* block, uintptr byte_count) { block->byte_count = byte_count; }
+function Tracked_Block_Header* block_left(Tracked_Block_Header* block) { return block->left; }
+function void block_set_left(Tracked_Block_Header* block, Tracked_Block_Header* left) { block->left = left; }
+function Tracked_Block_Header* block_right(Tracked_Block_Header* block) { return block->right; }
+function void block_set_right(Tracked_Block_Header* block, Tracked_Block_Header* right) { block->right = right; }
+
+#endif
+
 function u32
 debug_id_from_name(char const* name)
 {
@@ -96,18 +238,18 @@ function void
 debug_validate_left_and_right(Tracked_Block_Header* tracked)
 {
 #if BUILD_DEBUG
-    Tracked_Block_Header* left = tracked ? tracked->left : nullptr;
+    Tracked_Block_Header* left = tracked ? block_left(tracked) : nullptr;
     if (left)
     {
-        ASSERT(left->right == tracked);
-        ASSERT((u8*)left + left->byte_count == (u8*)tracked);
+        ASSERT(block_right(left) == tracked);
+        ASSERT((u8*)left + block_byte_count(left) == (u8*)tracked);
 
     }
-    Tracked_Block_Header* right = tracked ? tracked->right : nullptr;
+    Tracked_Block_Header* right = tracked ? block_right(tracked) : nullptr;
     if (right)
     {
-        ASSERT(right->left == tracked);
-        ASSERT((u8*)tracked + tracked->byte_count == (u8*)right);
+        ASSERT(block_left(right) == tracked);
+        ASSERT((u8*)tracked + block_byte_count(tracked) == (u8*)right);
     }
 #endif
 }
@@ -120,18 +262,36 @@ debug_validate_prev_and_next(Free_Block_Header* free, bool allow_size_mismatch =
     if (prev)
     {
         ASSERT(prev->next == free);
-        ASSERT(IMPLIES(!allow_size_mismatch, prev->byte_count >= free->byte_count));
+        ASSERT(IMPLIES(!allow_size_mismatch, block_byte_count(prev) >= block_byte_count(free)));
 
     }
     Free_Block_Header* next = free ? free->next : nullptr;
     if (next)
     {
         ASSERT(next->prev == free);
-        ASSERT(IMPLIES(!allow_size_mismatch, next->byte_count <= free->byte_count));
+        ASSERT(IMPLIES(!allow_size_mismatch, block_byte_count(next) <= block_byte_count(free)));
     }
 #endif
 }
 
+function void
+stats_live_add(Region_Header* region, uintptr byte_count)
+{
+#if MEM_STATS_ENABLE
+    region->stats.live_byte_count += byte_count;
+    region->stats.live_byte_count_peak = max(region->stats.live_byte_count_peak, region->stats.live_byte_count);
+#endif
+}
+
+function void
+stats_live_remove(Region_Header* region, uintptr byte_count)
+{
+#if MEM_STATS_ENABLE
+    ASSERT(region->stats.live_byte_count >= byte_count);
+    region->stats.live_byte_count -= byte_count;
+#endif
+}
+
 function void
 debug_region_name_set(MEM::Region_Header * region, char const * name)
 {
@@ -177,7 +337,9 @@ enum AllocType : u8
 
 // @Cleanup - forward declarations because core module doesn't run hgen
 function void* allocate(MEM::Region_Header* region, uintptr byte_count, CTZ ctz=CTZ::NO);
+function void* allocate(MEM::Region_Header* region, uintptr byte_count, uintptr alignment, CTZ ctz=CTZ::NO);
 function void* allocate_tracked(MEM::Region_Header* region, uintptr byte_count, CTZ ctz=CTZ::NO);
+function void* allocate_tracked(MEM::Region_Header* region, uintptr byte_count, uintptr alignment, CTZ ctz=CTZ::NO);
 function void free_tracked_allocation(MEM::Region_Header* region, void* allocation);
 function bool mem_region_end(MEM::Region_Header* region);
 function bool mem_region_reset(MEM::Region_Header* region);
@@ -207,8 +369,8 @@ resize_free_list_head(Free_Block_Header** ppHead, uintptr byte_count_new)
     {
         ASSERT(byte_count_new > BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING);
 
-        pHeadOrig->byte_count = byte_count_new;
-        bool isHeadTooSmall = pHeadOrig->next && pHeadOrig->next->byte_count > pHeadOrig->byte_count;
+        block_set_byte_count(pHeadOrig, byte_count_new);
+        bool isHeadTooSmall = pHeadOrig->next && block_byte_count(pHeadOrig->next) > block_byte_count(pHeadOrig);
 
         if (isHeadTooSmall)
         {
@@ -223,7 +385,7 @@ resize_free_list_head(Free_Block_Header** ppHead, uintptr byte_count_new)
                 // Find the node that should point to the old head
                 Free_Block_Header* biggerThanOrig = *ppHead;
                 while (biggerThanOrig->next &&
-                       biggerThanOrig->next->byte_count > pHeadOrig->byte_count)
+                       block_byte_count(biggerThanOrig->next) > block_byte_count(pHeadOrig))
                 {
                     biggerThanOrig = biggerThanOrig->next;
                 }
@@ -250,27 +412,179 @@ resize_free_list_head(Free_Block_Header** ppHead, uintptr byte_count_new)
     }
 }
 
+// --- Free list of tracked (unshared) blocks. Either segregated into size class bins, or a single sorted list.
+
+function void free_list_remove(Free_Block_Header** ppHead, Free_Block_Header* pItem, bool allow_size_mismatch);
+function void free_list_add(Free_Block_Header** ppHead, Free_Block_Header* pItem);
+
+#if MEM_SEGREGATED_FIT_ENABLE
+function int
+tracked_bin_index(uintptr byte_count)
+{
+    int msb = 0;
+    bitscan_msb_index((u64)byte_count, &msb);
+
+    int result = clamp(msb - TRACKED_BIN::MIN_LOG2, 0, TRACKED_BIN::COUNT - 1);
+    return result;
+}
+#endif
+
+function Free_Block_Header*
+tracked_free_list_find(Region_Header* region, uintptr byte_count)
+{
+#if MEM_SEGREGATED_FIT_ENABLE
+    // Blocks in byte_count's own bin might be too small, so we only peek at that bin's head instead of walking it.
+    //  Any block in a higher bin is guaranteed to fit, so we take the head of the smallest non-empty one.
+    int bin = tracked_bin_index(byte_count);
+
+    Free_Block_Header* candidate = region->tracked_bins[bin];
+    if (candidate && block_byte_count(candidate) >= byte_count)
+        return candidate;
+
+    u32 higher_mask = (bin + 1 < TRACKED_BIN::COUNT) ?
+                        region->tracked_bin_mask & (U32::MAX << (bin + 1)) :
+                        0;
+
+    int higher_bin;
+    if (bitscan_lsb_index(higher_mask, &higher_bin))
+        return region->tracked_bins[higher_bin];
+
+    return nullptr;
+#else
+    if (region->tracked_list && block_byte_count(region->tracked_list) >= byte_count)
+        return region->tracked_list;
+
+    return nullptr;
+#endif
+}
+
+function void
+tracked_free_list_add(Region_Header* region, Free_Block_Header* free)
+{
+    ASSERT(free->state == Tracked_State::FREE_UNSHARED);
+
+#if MEM_SEGREGATED_FIT_ENABLE
+    int bin = tracked_bin_index(block_byte_count(free));
+
+    free->prev = nullptr;
+    free->next = region->tracked_bins[bin];
+    if (free->next)
+    {
+        free->next->prev = free;
+    }
+
+    region->tracked_bins[bin] = free;
+    region->tracked_bin_mask |= (1u << bin);
+
+    debug_validate_prev_and_next(free, true /* allow_size_mismatch */);
+#else
+    free_list_add(&region->tracked_list, free);
+#endif
+}
+
+// NOTE - Must be called before changing the block's byte_count, since that determines which bin it's in
+function void
+tracked_free_list_remove(Region_Header* region, Free_Block_Header* free)
+{
+#if MEM_SEGREGATED_FIT_ENABLE
+    int bin = tracked_bin_index(block_byte_count(free));
+    free_list_remove(region->tracked_bins + bin, free, true /* allow_size_mismatch */);
+
+    if (!region->tracked_bins[bin])
+    {
+        region->tracked_bin_mask &= ~(1u << bin);
+    }
+#else
+    free_list_remove(&region->tracked_list, free, false /* allow_size_mismatch */);
+#endif
+}
+
+function void
+tracked_free_list_reset(Region_Header* region)
+{
+#if MEM_SEGREGATED_FIT_ENABLE
+    region->tracked_bin_mask = 0;
+    ZeroArray(region->tracked_bins);
+#else
+    region->tracked_list = nullptr;
+#endif
+}
+
+// Commits more of a virtual region's reserved memory, so that the shared list has a block of at least byte_count.
+//  The shared block that runs up to the end of the committed memory (if any) grows in place. Otherwise the newly
+//  committed pages become a new shared block. Returns false if the region isn't virtual, or is out of reserve.
+function bool
+virtual_region_commit(Region_Header* region, uintptr byte_count)
+{
+    if (!region->reserved_byte_count)
+        return false;
+
+    // Grow geometrically, like overflowing does, but contiguously
+    uintptr commit_byte_count = max(byte_count, region->byte_budget);
+    commit_byte_count += mem_align_offset(commit_byte_count, BYTE_COUNT::VIRTUAL_COMMIT_GRANULARITY);
+    commit_byte_count = min(commit_byte_count, region->reserved_byte_count - region->byte_budget);
+    if (commit_byte_count < byte_count)
+        return false;
+
+    u8* committed_end = (u8*)region + region->byte_budget;
+    if (!system_commit(committed_end, commit_byte_count))
+        return false;
+
+    region->byte_budget += commit_byte_count;
+
+    Free_Block_Header* adjacent = region->shared_list;
+    while (adjacent && (u8*)adjacent + block_byte_count(adjacent) != committed_end)
+    {
+        adjacent = adjacent->next;
+    }
+
+    if (adjacent)
+    {
+        free_list_remove(&region->shared_list, adjacent, false /* allow_size_mismatch */);
+        block_set_byte_count(adjacent, block_byte_count(adjacent) + commit_byte_count);
+        free_list_add(&region->shared_list, adjacent);
+    }
+    else
+    {
+        Free_Block_Header* free = (Free_Block_Header*)committed_end;
+        *free = {};
+        block_set_byte_count(free, commit_byte_count);
+        free->state = Tracked_State::FREE_SHARED;
+        free_list_add(&region->shared_list, free);
+    }
+
+    return true;
+}
+
 function Free_Block_Header*
 ensure_block_with_size(Region_Header* region_header, uintptr byte_count, AllocType allocType)
 {
     // --- Return tracked block if we've got one big enough (and we asked for tracked)
 
-    if (allocType == AllocType::Tracked &&
-        region_header->tracked_list &&
-        region_header->tracked_list->byte_count >= byte_count)
+    if (allocType == AllocType::Tracked)
     {
-        return region_header->tracked_list;
+        if (Free_Block_Header* tracked = tracked_free_list_find(region_header, byte_count))
+            return tracked;
     }
 
     // --- Allocate an overflow region from our parent if shared block is too small.
     //      This memory is treated as a shared block.
 
     if (!region_header->shared_list ||
-        region_header->shared_list->byte_count < byte_count)
+        block_byte_count(region_header->shared_list) < byte_count)
     {
+        // --- Virtual regions commit more memory instead, as long as they have reserve left.
+
+        if (virtual_region_commit(region_header, byte_count))
+        {
+            ASSERT(block_byte_count(region_header->shared_list) >= byte_count);
+            return region_header->shared_list;
+        }
+
         // HMM - Maybe make regions have more control over how much they grow when they overflow?
         byte_count += sizeof(Overflow_Header);
         byte_count = max(byte_count, region_header->byte_budget);
+        byte_count += mem_align_offset(byte_count, BYTE_COUNT::BLOCK_GRANULARITY);
 
         Overflow_Header* overflow = (Overflow_Header*)allocate_tracked(region_header->parent, byte_count);
 
@@ -280,11 +594,16 @@ ensure_block_with_size(Region_Header* region_header, uintptr byte_count, AllocTy
         overflow->next = region_header->overflow;
         region_header->overflow = overflow;
 
+#if MEM_STATS_ENABLE
+        region_header->stats.overflow_count++;
+        region_header->stats.overflow_byte_count += byte_count;
+#endif
+
         // --- Initialize free-block and make it the head of the free list
 
         Free_Block_Header* free = (Free_Block_Header*)(overflow + 1);
         *free = {};
-        free->byte_count = byte_count - sizeof(Overflow_Header);
+        block_set_byte_count(free, byte_count - sizeof(Overflow_Header));
         free->state = Tracked_State::FREE_SHARED;
 
         free->next = region_header->shared_list;
@@ -305,7 +624,7 @@ ensure_block_with_size(Region_Header* region_header, uintptr byte_count, AllocTy
 }
 
 function void
-free_list_remove(Free_Block_Header** ppHead, Free_Block_Header* pItem)
+free_list_remove(Free_Block_Header** ppHead, Free_Block_Header* pItem, bool allow_size_mismatch = false)
 {
     if (*ppHead == pItem)
     {
@@ -315,7 +634,7 @@ free_list_remove(Free_Block_Header** ppHead, Free_Block_Header* pItem)
             (*ppHead)->prev = nullptr;
         }
 
-        debug_validate_prev_and_next(*ppHead);
+        debug_validate_prev_and_next(*ppHead, allow_size_mismatch);
     }
     else
     {
@@ -332,8 +651,8 @@ free_list_remove(Free_Block_Header** ppHead, Free_Block_Header* pItem)
             pItem->next->prev = pItem->prev;
         }
 
-        debug_validate_prev_and_next(pItem->prev);
-        debug_validate_prev_and_next(pItem->next);
+        debug_validate_prev_and_next(pItem->prev, allow_size_mismatch);
+        debug_validate_prev_and_next(pItem->next, allow_size_mismatch);
     }
 }
 
@@ -342,7 +661,7 @@ free_list_add(Free_Block_Header** ppHead, Free_Block_Header* pItem)
 {
     Free_Block_Header** ppNextToFix = ppHead;
     while ((*ppNextToFix) &&
-           (*ppNextToFix)->byte_count > pItem->byte_count)
+           block_byte_count(*ppNextToFix) > block_byte_count(pItem))
     {
         ppNextToFix = &(*ppNextToFix)->next;
     }
@@ -369,23 +688,114 @@ free_list_add(Free_Block_Header** ppHead, Free_Block_Header* pItem)
     debug_validate_prev_and_next(*ppNextToFix);
 }
 
+// Moves the start of a free block forward, so that an allocation made from it will be aligned. The skipped
+//  bytes are lumped in with the left neighbor, or split off into their own free block if they're worth tracking.
+//  Expects the block to not be on any free list.
+function Free_Block_Header*
+free_block_align(Region_Header* region, Free_Block_Header* free, uintptr alignment)
+{
+    uintptr skip_byte_count = mem_align_offset((uintptr)free + sizeof(Tracked_Block_Header), alignment);
+    if (skip_byte_count == 0)
+        return free;
+
+    Tracked_Block_Header* left = block_left(free);
+    if (!left && skip_byte_count <= BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING)
+    {
+        // Nothing to lump the skipped bytes in with, so skip far enough ahead that we can track them
+        uintptr deficit = BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING - skip_byte_count;
+        skip_byte_count += alignment * (deficit / alignment + 1);
+    }
+
+    ASSERT(block_byte_count(free) > skip_byte_count);
+
+    // Read the header out first, since the old and new headers might overlap
+    uintptr orig_byte_count = block_byte_count(free);
+    Tracked_Block_Header* orig_right = block_right(free);
+    Tracked_State orig_state = free->state;
+
+    Free_Block_Header* result = (Free_Block_Header*)((u8*)free + skip_byte_count);
+    block_set_byte_count(result, orig_byte_count - skip_byte_count);
+    block_set_right(result, orig_right);
+    result->state = orig_state;
+    if (block_right(result))
+    {
+        block_set_left(block_right(result), result);
+    }
+
+    if (skip_byte_count <= BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING)
+    {
+        // --- Lump with left. It can't be free, since free neighbors always get coalesced.
+
+        ASSERT(left->state == Tracked_State::ALLOCATED);
+        block_set_byte_count(left, block_byte_count(left) + skip_byte_count);
+        stats_live_add(region, skip_byte_count);
+        block_set_right(left, result);
+        block_set_left(result, left);
+    }
+    else
+    {
+        // --- Split off into a free block (left)
+
+        Free_Block_Header* skipped = free;
+        block_set_byte_count(skipped, skip_byte_count);
+        block_set_left(skipped, left);
+        block_set_right(skipped, result);
+        skipped->state = Tracked_State::FREE_UNSHARED;
+        block_set_left(result, skipped);
+
+        tracked_free_list_add(region, skipped);
+        debug_validate_left_and_right(skipped);
+    }
+
+    debug_validate_left_and_right(result);
+    return result;
+}
+
 function void*
-allocate_tracked_from_region(Region_Header* region, uintptr byte_count)
+allocate_tracked_from_region(Region_Header* region, uintptr byte_count, uintptr alignment)
 {
+    ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
     // Make sure our tracked or free block is big enough!
 
     // HMM - Gracefully handle 0 byte allocation?
     byte_count += sizeof(Tracked_Block_Header);
     byte_count = max(byte_count, sizeof(Free_Block_Header)); // Make sure the allocation is big enough that if it gets freed, we can store a free block header in place
+    byte_count += mem_align_offset(byte_count, BYTE_COUNT::BLOCK_GRANULARITY);
+
+    // Worst case, free_block_align(..) skips (alignment - 1) bytes, and then some more to make them trackable
+    //  Anything up to the block granularity comes for free, since blocks and their headers are multiples of it.
+    uintptr byte_count_with_alignment = byte_count;
+    if (alignment > BYTE_COUNT::BLOCK_GRANULARITY)
+    {
+        byte_count_with_alignment += BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING + alignment;
+    }
 
-    Free_Block_Header* free = ensure_block_with_size(region, byte_count, AllocType::Tracked);
+    Free_Block_Header* free = ensure_block_with_size(region, byte_count_with_alignment, AllocType::Tracked);
 
-    bool is_free_block_from_tracked_list = (free == region->tracked_list);
+    bool is_free_block_from_tracked_list = (free->state == Tracked_State::FREE_UNSHARED);
     ASSERT(IMPLIES(!is_free_block_from_tracked_list, free == region->shared_list));
 
+    // Remove it before we clobber it. If we split it, we'll add the remainder back in.
+    if (is_free_block_from_tracked_list)
+    {
+        tracked_free_list_remove(region, free);
+    }
+    else
+    {
+        free_list_remove(&region->shared_list, free);
+    }
+
+    if (alignment > BYTE_COUNT::BLOCK_GRANULARITY)
+    {
+        free = free_block_align(region, free, alignment);
+    }
+
+    ASSERT(block_byte_count(free) >= byte_count);
+
     // Split free block into the tracked allocation (left) and ...
 
-    uintptr split_byte_count = free->byte_count - byte_count;
+    uintptr split_byte_count = block_byte_count(free) - byte_count;
     if (split_byte_count <= BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING)
     {
         // ... nothing. Just lump the extra bytes with the returned tracked allocation.
@@ -394,68 +804,42 @@ allocate_tracked_from_region(Region_Header* region, uintptr byte_count)
 
     Tracked_Block_Header* result_header = (Tracked_Block_Header*)free;
     void* result = (u8*)((Tracked_Block_Header*)result_header + 1);
-    result_header->byte_count = free->byte_count - split_byte_count;
+    block_set_byte_count(result_header, block_byte_count(free) - split_byte_count);
     result_header->state = Tracked_State::ALLOCATED;
 
     if (split_byte_count > 0)
     {
-        // ... a smaller shared block (right)
+        // ... a smaller free block (right), which goes back on the list we took the original from
         ASSERT(split_byte_count > BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING);
 
         Free_Block_Header* split = (Free_Block_Header*)((u8*)free + byte_count);
-        split->byte_count = split_byte_count;
-        split->left = result_header;
-        split->right = result_header->right;
-        split->state = is_free_block_from_tracked_list ?
-                        Tracked_State::FREE_UNSHARED :
-                        Tracked_State::FREE_SHARED;
-        split->next = free->next;
-        if (split->next)
-        {
-            split->next->prev = split;
-        }
-        split->prev = nullptr; ASSERT(!free->prev);
+        block_set_byte_count(split, split_byte_count);
+        block_set_left(split, result_header);
+        block_set_right(split, block_right(result_header));
 
-        result_header->right = split;
-        if (split->right)
+        block_set_right(result_header, split);
+        if (block_right(split))
         {
-            split->right->left = split;
+            block_set_left(block_right(split), split);
         }
 
         // --- Update free list
         if (is_free_block_from_tracked_list)
         {
-            region->tracked_list = split;
-            resize_free_list_head(&region->tracked_list, split_byte_count);
+            split->state = Tracked_State::FREE_UNSHARED;
+            tracked_free_list_add(region, split);
         }
         else
         {
-            region->shared_list = split;
-            resize_free_list_head(&region->shared_list, split_byte_count);
+            split->state = Tracked_State::FREE_SHARED;
+            free_list_add(&region->shared_list, split);
         }
-
-        debug_validate_prev_and_next(split);
     }
-    else
-    {
-        // ... (nothing)
-
-        // --- Update free list
-        if (is_free_block_from_tracked_list)
-        {
-            resize_free_list_head(&region->tracked_list, 0);
-            debug_validate_prev_and_next(region->tracked_list);
-        }
-        else
-        {
-            resize_free_list_head(&region->shared_list, 0);
-            debug_validate_prev_and_next(region->shared_list);
-        }
-    }
-
 
     debug_validate_left_and_right(result_header);
+    stats_live_add(region, block_byte_count(result_header));
 
+    ASSERT(((uintptr)result & (alignment - 1)) == 0);
     return result;
 }
 
@@ -469,27 +853,30 @@ free_tracked_allocation_from_region(Region_Header* region, void* allocation)
     ASSERT(tracked_header->state == Tracked_State::ALLOCATED);
     debug_validate_left_and_right(tracked_header);
 
-    Tracked_Block_Header* left = tracked_header->left;
-    Tracked_Block_Header* right = tracked_header->right;
+    Tracked_Block_Header* left = block_left(tracked_header);
+    Tracked_Block_Header* right = block_right(tracked_header);
     debug_validate_left_and_right(left);
     debug_validate_left_and_right(right);
 
+    stats_live_remove(region, block_byte_count(tracked_header));
+
     if (left && left->state == Tracked_State::FREE_UNSHARED)
     {
-        ASSERT(left->right == tracked_header);
+        ASSERT(block_right(left) == tracked_header);
+
+        // Remove for now (before its size changes), and...
+        tracked_free_list_remove(region, (Free_Block_Header*)left);
 
         // --- Merge w/ free left (unshared)
 
-        left->byte_count += tracked_header->byte_count;
-        left->right = tracked_header->right;
+        block_set_byte_count(left, block_byte_count(left) + block_byte_count(tracked_header));
+        block_set_right(left, block_right(tracked_header));
 
-        if (left->right)
+        if (block_right(left))
         {
-            left->right->left = left;
+            block_set_left(block_right(left), left);
         }
 
-        // Remove for now, and...
-        free_list_remove(&region->tracked_list, (Free_Block_Header*)left);
         // ... consider the merged result the new "tracked header" that we will add back in.
         tracked_header = left;
     }
@@ -500,18 +887,18 @@ free_tracked_allocation_from_region(Region_Header* region, void* allocation)
     {
         if (right->state == Tracked_State::FREE_UNSHARED)
         {
+            // Remove for now. We'll add the merged result back in.
+            tracked_free_list_remove(region, (Free_Block_Header*)right);
+
             // --- Merge w/ free right (unshared)
 
-            tracked_header->byte_count += right->byte_count;
+            block_set_byte_count(tracked_header, block_byte_count(tracked_header) + block_byte_count(right));
 
-            tracked_header->right = right->right;
-            if (tracked_header->right)
+            block_set_right(tracked_header, block_right(right));
+            if (block_right(tracked_header))
             {
-                tracked_header->right->left = tracked_header;
+                block_set_left(block_right(tracked_header), tracked_header);
             }
-
-            // Remove for now. We'll add the merged result back in.
-            free_list_remove(&region->tracked_list, (Free_Block_Header*)right);
         }
         else if (right->state == Tracked_State::FREE_SHARED)
         {
@@ -519,10 +906,10 @@ free_tracked_allocation_from_region(Region_Header* region, void* allocation)
 
             // --- Merge w/ free right (shared)
 
-            tracked_header->byte_count += right->byte_count;
+            block_set_byte_count(tracked_header, block_byte_count(tracked_header) + block_byte_count(right));
 
-            ASSERT(right->right == nullptr);     // right of shared is never tracked, by definition
-            tracked_header->right = nullptr;
+            ASSERT(block_right(right) == nullptr);     // right of shared is never tracked, by definition
+            block_set_right(tracked_header, nullptr);
 
             // Remove for now. We'll add the merged result back in.
             free_list_remove(&region->shared_list, (Free_Block_Header*)right);
@@ -537,8 +924,104 @@ free_tracked_allocation_from_region(Region_Header* region, void* allocation)
     else
     {
         tracked_header->state = Tracked_State::FREE_UNSHARED;
-        free_list_add(&region->tracked_list, (Free_Block_Header*)tracked_header);
+        tracked_free_list_add(region, (Free_Block_Header*)tracked_header);
+    }
+}
+
+// Tries to grow an allocation by absorbing its free right neighbor. Any remainder of the neighbor
+//  that is big enough to track is split back off. Returns false (and does nothing) if the neighbor
+//  isn't free or isn't big enough.
+function bool
+grow_tracked_allocation_in_place(Region_Header* region, Tracked_Block_Header* tracked_header, uintptr byte_count)
+{
+    ASSERT(tracked_header->state == Tracked_State::ALLOCATED);
+    ASSERT(byte_count > block_byte_count(tracked_header));
+
+    byte_count += mem_align_offset(byte_count, BYTE_COUNT::BLOCK_GRANULARITY);
+
+    Free_Block_Header* right = (Free_Block_Header*)block_right(tracked_header);
+    if (!right || right->state == Tracked_State::ALLOCATED)
+        return false;
+
+    uintptr combined_byte_count = block_byte_count(tracked_header) + block_byte_count(right);
+    if (combined_byte_count < byte_count)
+    {
+        // --- A shared neighbor at the end of a virtual region's committed memory can grow by committing more
+
+        bool is_right_at_committed_end = (u8*)right + block_byte_count(right) == (u8*)region + region->byte_budget;
+        if (right->state != Tracked_State::FREE_SHARED ||
+            !is_right_at_committed_end ||
+            !virtual_region_commit(region, byte_count - block_byte_count(tracked_header)))
+        {
+            return false;
+        }
+
+        combined_byte_count = block_byte_count(tracked_header) + block_byte_count(right);
+        ASSERT(combined_byte_count >= byte_count);
+    }
+
+    debug_validate_left_and_right(right);
+
+    // --- Remove the neighbor from its free list. Read everything we need out of its header first,
+    //      since the split below might overlap it.
+
+    Tracked_State right_state = right->state;
+    Tracked_Block_Header* right_right = block_right(right);
+
+    if (right_state == Tracked_State::FREE_UNSHARED)
+    {
+        tracked_free_list_remove(region, right);
+    }
+    else
+    {
+        ASSERT(right_state == Tracked_State::FREE_SHARED);
+        ASSERT(right_right == nullptr);     // right of shared is never tracked, by definition
+        free_list_remove(&region->shared_list, right);
+    }
+
+    // --- Grow into the neighbor, and split off the remainder (if it's worth tracking)
+
+    uintptr byte_count_old = block_byte_count(tracked_header);
+    uintptr split_byte_count = combined_byte_count - byte_count;
+    if (split_byte_count <= BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING)
+    {
+        block_set_byte_count(tracked_header, combined_byte_count);
+        block_set_right(tracked_header, right_right);
+        if (right_right)
+        {
+            block_set_left(right_right, tracked_header);
+        }
     }
+    else
+    {
+        Free_Block_Header* split = (Free_Block_Header*)((u8*)tracked_header + byte_count);
+        block_set_byte_count(split, split_byte_count);
+        block_set_left(split, tracked_header);
+        block_set_right(split, right_right);
+        split->state = right_state;
+        if (right_right)
+        {
+            block_set_left(right_right, split);
+        }
+
+        block_set_byte_count(tracked_header, byte_count);
+        block_set_right(tracked_header, split);
+
+        if (right_state == Tracked_State::FREE_UNSHARED)
+        {
+            tracked_free_list_add(region, split);
+        }
+        else
+        {
+            free_list_add(&region->shared_list, split);
+        }
+
+        debug_validate_left_and_right(split);
+    }
+
+    debug_validate_left_and_right(tracked_header);
+    stats_live_add(region, block_byte_count(tracked_header) - byte_count_old);
+    return true;
 }
 
 function bool mem_region_end(Region_Header* region, bool unlink);
@@ -580,7 +1063,14 @@ mem_region_end(Region_Header* region, bool unlink)
         }
     }
 
-    free_tracked_allocation(region->parent, region);
+    if (region->reserved_byte_count)
+    {
+        system_release(region, region->reserved_byte_count);
+    }
+    else
+    {
+        free_tracked_allocation(region->parent, region);
+    }
 
     // TODO - Maybe add some auditing and return false if it fails? Or just make this return void?
     return true;
@@ -592,46 +1082,55 @@ mem_region_end(Region_Header* region, bool unlink)
 using Memory_Region = MEM::Region_Header*;
 
 function void*
-allocate(Memory_Region region, uintptr byte_count, CTZ ctz)
+allocate(Memory_Region region, uintptr byte_count, uintptr alignment, CTZ ctz)
 {
     using namespace MEM;
 
     ASSERT(region);
+    ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
 
     Region_Header* region_header = region;
 
-    // --- Make sure our shared block is big enough!
+    // Carving at a multiple of the block granularity keeps what's left of the shared block a valid block size
+    alignment = max(alignment, BYTE_COUNT::BLOCK_GRANULARITY);
+
+    // --- Make sure our shared block is big enough! Worst case, we skip (alignment - 1) bytes to align the result.
 
-    Free_Block_Header* shared = ensure_block_with_size(region_header, byte_count, AllocType::Untracked);
+    Free_Block_Header* shared = ensure_block_with_size(region_header, byte_count + alignment - 1, AllocType::Untracked);
     ASSERT(shared == region_header->shared_list);
-    ASSERT(shared->byte_count >= byte_count);
+    ASSERT(block_byte_count(shared) >= byte_count + alignment - 1);
 
     // --- Split shared block into the untracked allocation (right) and ...
+    //      Any bytes skipped to align the allocation are simply lost.
 
     void* result;
 
     // HMM - Gracefully handle 0 byte allocation?
-    uintptr split_byte_count = shared->byte_count - byte_count;
+    uintptr shared_byte_count = block_byte_count(shared);
+    uintptr result_address = ((uintptr)shared + shared_byte_count - byte_count) & ~(alignment - 1);
+    uintptr split_byte_count = result_address - (uintptr)shared;
     if (split_byte_count <= BYTE_COUNT::TOO_SMALL_TO_BOTHER_TRACKING)
     {
         // ... nothing! The remaining block is too small to fit anything of use
 
-        if (shared->left)
+        if (block_left(shared))
         {
-            shared->left->right = nullptr;
+            block_set_right(block_left(shared), nullptr);
         }
 
         resize_free_list_head(&region_header->shared_list, 0);
         debug_validate_prev_and_next(region_header->shared_list);
 
-        result = shared;
+        result = (u8*)shared + mem_align_offset((uintptr)shared, alignment);
+        stats_live_add(region_header, shared_byte_count);
     }
     else
     {
         // ... a smaller shared block (left)
 
         resize_free_list_head(&region_header->shared_list, split_byte_count);
-        result = (u8*)shared + split_byte_count;
+        result = (void*)result_address;
+        stats_live_add(region_header, shared_byte_count - split_byte_count);
 
         debug_validate_prev_and_next(region_header->shared_list);
     }
@@ -644,13 +1143,31 @@ allocate(Memory_Region region, uintptr byte_count, CTZ ctz)
     return result;
 }
 
+function void*
+allocate(Memory_Region region, uintptr byte_count, CTZ ctz)
+{
+    void* result = allocate(region, byte_count, 1 /* alignment */, ctz);
+    return result;
+}
+
 template <typename T>
 T*
 allocate(
     Memory_Region region,
     CTZ ctz=CTZ::NO)
 {
-    T* result = (T*)allocate(region, sizeof(T), ctz);
+    T* result = (T*)allocate(region, sizeof(T), alignof(T), ctz);
+    return result;
+}
+
+template <typename T>
+T*
+allocate_array(
+    Memory_Region region,
+    uintptr count,
+    CTZ ctz=CTZ::NO)
+{
+    T* result = (T*)allocate(region, sizeof(T) * count, alignof(T), ctz);
     return result;
 }
 
@@ -659,23 +1176,26 @@ T*
 allocate_array(
     Memory_Region region,
     uintptr count,
+    uintptr alignment,
     CTZ ctz=CTZ::NO)
 {
-    T* result = (T*)allocate(region, sizeof(T) * count, ctz);
+    T* result = (T*)allocate(region, sizeof(T) * count, alignment, ctz);
     return result;
 }
 
 function void*
-allocate_tracked(Memory_Region region, uintptr byte_count, CTZ ctz)
+allocate_tracked(Memory_Region region, uintptr byte_count, uintptr alignment, CTZ ctz)
 {
     void* result;
     if (region)
     {
-        result = MEM::allocate_tracked_from_region(region, byte_count);
+        result = MEM::allocate_tracked_from_region(region, byte_count, alignment);
     }
     else
     {
+        // NOTE - Relies on the system allocator to honor the alignment
         result = MEM::system_allocate(byte_count);
+        ASSERT_WARN(((uintptr)result & (alignment - 1)) == 0);
     }
 
     if ((bool)ctz)
@@ -686,13 +1206,31 @@ allocate_tracked(Memory_Region region, uintptr byte_count, CTZ ctz)
     return result;
 }
 
+function void*
+allocate_tracked(Memory_Region region, uintptr byte_count, CTZ ctz)
+{
+    void* result = allocate_tracked(region, byte_count, 1 /* alignment */, ctz);
+    return result;
+}
+
 template <typename T>
 T*
 allocate_tracked(
     Memory_Region region,
     CTZ ctz=CTZ::NO)
 {
-    T* result = (T*)allocate_tracked(region, sizeof(T), ctz);
+    T* result = (T*)allocate_tracked(region, sizeof(T), alignof(T), ctz);
+    return result;
+}
+
+template <typename T>
+T*
+allocate_array_tracked(
+    Memory_Region region,
+    uintptr count,
+    CTZ ctz=CTZ::NO)
+{
+    T* result = (T*)allocate_tracked(region, sizeof(T) * count, alignof(T), ctz);
     return result;
 }
 
@@ -701,9 +1239,10 @@ T*
 allocate_array_tracked(
     Memory_Region region,
     uintptr count,
+    uintptr alignment,
     CTZ ctz=CTZ::NO)
 {
-    T* result = (T*)allocate_tracked(region, sizeof(T) * count, ctz);
+    T* result = (T*)allocate_tracked(region, sizeof(T) * count, alignment, ctz);
     return result;
 }
 
@@ -720,15 +1259,22 @@ free_tracked_allocation(Memory_Region region, void* allocation)
     }
 }
 
+// NOTE - If the allocation has to move, the new one is aligned to the provided alignment. Growing in place
+//  keeps the original address, so callers should pass the same alignment they originally allocated with.
 function void*
-reallocate_tracked(Memory_Region region, void* allocation, uintptr byte_count_new)
+reallocate_tracked(Memory_Region region, void* allocation, uintptr byte_count_new, uintptr alignment)
 {
     using namespace MEM;
 
     void* result;
     if (!allocation)
     {
-        result = allocate_tracked(region, byte_count_new);
+        result = allocate_tracked(region, byte_count_new, alignment);
+    }
+    else if (!region)
+    {
+        // System allocations don't have a tracked header, so let the system handle it
+        result = MEM::system_reallocate(allocation, byte_count_new);
     }
     else
     {
@@ -736,26 +1282,45 @@ reallocate_tracked(Memory_Region region, void* allocation, uintptr byte_count_ne
         ASSERT(tracked_header->state == Tracked_State::ALLOCATED);
         debug_validate_left_and_right(tracked_header);
 
-        uintptr byte_countOld = tracked_header->byte_count - sizeof(Tracked_Block_Header);
+        uintptr byte_countOld = block_byte_count(tracked_header) - sizeof(Tracked_Block_Header);
         if (byte_countOld >= byte_count_new)
         {
             result = allocation;
         }
         else
         {
+#if MEM_STATS_ENABLE
+            region->stats.reallocate_grow_count++;
+#endif
 
-            // TODO - Grow in place if possible
+            if (grow_tracked_allocation_in_place(region, tracked_header, byte_count_new + sizeof(Tracked_Block_Header)))
+            {
+                result = allocation;
 
-            result = allocate_tracked(region, byte_count_new);
-            mem_copy(result, allocation, byte_countOld);
+#if MEM_STATS_ENABLE
+                region->stats.reallocate_in_place_count++;
+#endif
+            }
+            else
+            {
+                result = allocate_tracked(region, byte_count_new, alignment);
+                mem_copy(result, allocation, byte_countOld);
 
-            free_tracked_allocation(region, allocation);
+                free_tracked_allocation(region, allocation);
+            }
         }
     }
 
     return result;
 }
 
+function void*
+reallocate_tracked(Memory_Region region, void* allocation, uintptr byte_count_new)
+{
+    void* result = reallocate_tracked(region, allocation, byte_count_new, 1 /* alignment */);
+    return result;
+}
+
 template <typename T>
 T*
 reallocate_array_tracked(
@@ -767,6 +1332,18 @@ reallocate_array_tracked(
     return result;
 }
 
+template <typename T>
+T*
+reallocate_array_tracked(
+    Memory_Region region,
+    T* allocation,
+    uintptr count_new,
+    uintptr alignment)
+{
+    T* result = (T*)reallocate_tracked(region, allocation, sizeof(T) * count_new, alignment);
+    return result;
+}
+
 function bool
 mem_region_end(Memory_Region region)
 {
@@ -799,10 +1376,13 @@ mem_region_reset(Memory_Region region)
         region->overflow = nullptr;
     }
 
-    region->tracked_list = nullptr;
+    tracked_free_list_reset(region);
+#if MEM_STATS_ENABLE
+    region->stats.live_byte_count = 0;
+#endif
     region->shared_list = (Free_Block_Header*)(header + 1);
     *region->shared_list = {};
-    region->shared_list->byte_count = header->byte_budget - sizeof(Region_Header);
+    block_set_byte_count(region->shared_list, header->byte_budget - sizeof(Region_Header));
     region->shared_list->state = Tracked_State::FREE_SHARED;
 
     // TODO - Maybe add some auditing and return false if it fails? Or just make this return void?
@@ -821,13 +1401,15 @@ mem_region_init(
     using namespace MEM;
 
     byte_count = max(byte_count, BYTE_COUNT::MINIMUM_REGION);
+    byte_count -= byte_count % BYTE_COUNT::BLOCK_GRANULARITY;
+    ASSERT((uintptr)bytes % BYTE_COUNT::BLOCK_GRANULARITY == 0);
 
     Region_Header* result = (Region_Header*)bytes;
     *result = {};
     result->byte_budget = byte_count;
     result->shared_list = (Free_Block_Header*)(result + 1);
     *result->shared_list = {};
-    result->shared_list->byte_count = result->byte_budget - sizeof(Region_Header);
+    block_set_byte_count(result->shared_list, result->byte_budget - sizeof(Region_Header));
     result->shared_list->state = Tracked_State::FREE_SHARED;
     result->parent = parent;
     result->prev_sibling = nullptr;
@@ -867,8 +1449,124 @@ mem_region_begin(Memory_Region parent, uintptr byte_count, char const* debug_nam
     return result;
 }
 
+// Initialize a root memory region backed by a reserved range of virtual memory, with commit_byte_count of it
+//  initially committed. When it runs out, it commits more of the reserve instead of overflowing, so it
+//  grows contiguously and tracked allocations next to the end can grow in place. Only overflows (via
+//  MEM::system_allocate) once the reserve is used up. Requires the MEM::system_reserve/commit/release hooks.
+function Memory_Region
+mem_region_begin_virtual(uintptr reserve_byte_count, uintptr commit_byte_count = KILOBYTES(64), char const* debug_name = nullptr)
+{
+    using namespace MEM;
+
+    ASSERT(system_reserve && system_commit && system_release);
+
+    commit_byte_count = max(commit_byte_count, BYTE_COUNT::MINIMUM_REGION);
+    commit_byte_count += mem_align_offset(commit_byte_count, BYTE_COUNT::VIRTUAL_COMMIT_GRANULARITY);
+    reserve_byte_count = max(reserve_byte_count, commit_byte_count);
+    reserve_byte_count += mem_align_offset(reserve_byte_count, BYTE_COUNT::VIRTUAL_COMMIT_GRANULARITY);
+
+    u8* bytes = (u8*)system_reserve(reserve_byte_count);
+    if (!bytes)
+        return nullptr;
+
+    if (!system_commit(bytes, commit_byte_count))
+    {
+        system_release(bytes, reserve_byte_count);
+        return nullptr;
+    }
+
+    Memory_Region result = mem_region_init(bytes, commit_byte_count, nullptr, debug_name);
+    result->reserved_byte_count = reserve_byte_count;
+    return result;
+}
+
+#if MEM_STATS_ENABLE
+
+// --- Stats
+
+struct Memory_Region_Stats
+{
+    char const* name;                   // From debug_region_name_set(..). Empty if unnamed.
+    uintptr byte_budget;
+
+    MEM::Region_Stats counters;
+
+    int tracked_free_block_count;       // # of blocks on the tracked free list
+    int shared_free_block_count;        // # of blocks on the shared free list
+    uintptr free_byte_count;            // total size of both
+    uintptr largest_free_byte_count;
+    f32 fragmentation;                  // 1 - (largest free block / all free bytes). 0 if free memory is all in one block.
+};
+
+function void
+stats_accumulate_free_list(Memory_Region_Stats* stats, MEM::Free_Block_Header* free, int* count)
+{
+    for (; free; free = free->next)
+    {
+        (*count)++;
+        stats->free_byte_count += block_byte_count(free);
+        stats->largest_free_byte_count = max(stats->largest_free_byte_count, block_byte_count(free));
+    }
+}
+
+// Snapshot of a region's stats. Walks its free lists, so it's O(# of free blocks).
+function Memory_Region_Stats
+mem_region_stats(Memory_Region region)
+{
+    using namespace MEM;
+
+    Memory_Region_Stats result = {};
+#if MEM_DEBUG_NAMES_ENABLE
+    result.name = region->name;
+#else
+    result.name = "";
+#endif
+    result.byte_budget = region->byte_budget;
+    result.counters = region->stats;
+
+#if MEM_SEGREGATED_FIT_ENABLE
+    for (int i_bin = 0; i_bin < TRACKED_BIN::COUNT; i_bin++)
+    {
+        stats_accumulate_free_list(&result, region->tracked_bins[i_bin], &result.tracked_free_block_count);
+    }
+#else
+    stats_accumulate_free_list(&result, region->tracked_list, &result.tracked_free_block_count);
+#endif
+    stats_accumulate_free_list(&result, region->shared_list, &result.shared_free_block_count);
+
+    if (result.free_byte_count > 0)
+    {
+        result.fragmentation = 1.0f - (f32)result.largest_free_byte_count / (f32)result.free_byte_count;
+    }
+
+    return result;
+}
+
+using Fn_Mem_Region_Stats_Visit = void (*)(Memory_Region_Stats const& stats, int depth, void* user);
+
+// Visits a region and all of its descendants, depth first
+function void
+mem_region_stats_visit_tree(Memory_Region region, Fn_Mem_Region_Stats_Visit visit, void* user = nullptr, int depth = 0)
+{
+    visit(mem_region_stats(region), depth, user);
+
+    for (Memory_Region child = region->first_child; child; child = child->next_sibling)
+    {
+        mem_region_stats_visit_tree(child, visit, user, depth + 1);
+    }
+}
+
+#endif // MEM_STATS_ENABLE
 
 // --- Allocator for a single type. Freed values are recycled to service future allocations.
+//      New slots are bump allocated from slabs, which are tracked allocations in the backing region.
+//      Slabs start at slab_slot_count_initial slots and double in size, up to slab_slot_count_max.
+
+namespace RECYCLE
+{
+static constexpr int SLAB_SLOT_COUNT_INITIAL_DEFAULT = 16;
+static constexpr int SLAB_SLOT_COUNT_MAX_DEFAULT = 4096;
+}
 
 template <typename T>
 struct Recycle_Allocator
@@ -879,9 +1577,21 @@ struct Recycle_Allocator
         T item;                 // Valid if live.
     };
 
+    struct Slab
+    {
+        Slab* next;
+        int slot_count;
+        int slot_count_used;    // Slots that have been bump allocated or preallocated. Any slab can be partially used, e.g. once PreallocateRecycleListContiguous(..) pushes a full slab in front of slab_bump.
+    };
+
     Slot* recycleList;          // Free list. Using "recycle" nomenclature to match the type and function names.
     Memory_Region memory;
 
+    Slab* slabs;                // Newest first
+    Slab* slab_bump;            // Slab that new slots are bump allocated from. nullptr if there isn't one with room.
+    int slab_slot_count_next;
+    int slab_slot_count_max;
+
 #if BUILD_DEBUG
     int countLive;               // total # of slots live
     int countAvailableToRecycle; // total # of slots on recycled list
@@ -892,23 +1602,88 @@ struct Recycle_Allocator
     Recycle_Allocator() = default;
 
     // @Cleanup... both ctor and init
-    Recycle_Allocator(Memory_Region memory) { *this = {}; this->memory = memory; }
+    Recycle_Allocator(Memory_Region memory)
+    {
+        *this = {};
+        this->memory = memory;
+        this->slab_slot_count_next = RECYCLE::SLAB_SLOT_COUNT_INITIAL_DEFAULT;
+        this->slab_slot_count_max = RECYCLE::SLAB_SLOT_COUNT_MAX_DEFAULT;
+    }
 };
 
 template <typename T>
 function void
-recycle_allocator_init(Recycle_Allocator<T>* alloc, Memory_Region memory)
+recycle_allocator_init(
+    Recycle_Allocator<T>* alloc,
+    Memory_Region memory,
+    int slab_slot_count_initial=RECYCLE::SLAB_SLOT_COUNT_INITIAL_DEFAULT,
+    int slab_slot_count_max=RECYCLE::SLAB_SLOT_COUNT_MAX_DEFAULT)
 {
+    ASSERT(slab_slot_count_initial > 0);
+    ASSERT(slab_slot_count_max >= slab_slot_count_initial);
+
     *alloc = {};
     alloc->memory = memory;
+    alloc->slab_slot_count_next = slab_slot_count_initial;
+    alloc->slab_slot_count_max = slab_slot_count_max;
+}
+
+namespace MEM
+{
+
+template <typename T>
+function uintptr
+recycle_slab_header_byte_count()
+{
+    using Slab = typename Recycle_Allocator<T>::Slab;
+    using Slot = typename Recycle_Allocator<T>::Slot;
+
+    uintptr result = sizeof(Slab) + mem_align_offset(sizeof(Slab), alignof(Slot));
+    return result;
+}
+
+template <typename T>
+function typename Recycle_Allocator<T>::Slot*
+recycle_slab_slots(typename Recycle_Allocator<T>::Slab* slab)
+{
+    using Slot = typename Recycle_Allocator<T>::Slot;
+
+    Slot* result = (Slot*)((u8*)slab + recycle_slab_header_byte_count<T>());
+    return result;
+}
+
+template <typename T>
+function typename Recycle_Allocator<T>::Slab*
+recycle_slab_push(Recycle_Allocator<T>* alloc, int slot_count)
+{
+    using Slab = typename Recycle_Allocator<T>::Slab;
+    using Slot = typename Recycle_Allocator<T>::Slot;
+
+    uintptr alignment = max(alignof(Slab), alignof(Slot));
+    Slab* result = (Slab*)allocate_tracked(
+                            alloc->memory,
+                            recycle_slab_header_byte_count<T>() + sizeof(Slot) * slot_count,
+                            alignment);
+
+    result->next = alloc->slabs;
+    result->slot_count = slot_count;
+    result->slot_count_used = 0;
+    alloc->slabs = result;
+    return result;
 }
 
+} // namespace MEM
+
 template <typename T>
 function T*
 allocate(
     Recycle_Allocator<T> * alloc,
     CTZ ctz=CTZ::NO)
 {
+    using namespace MEM;
+    using Slab = typename Recycle_Allocator<T>::Slab;
+    using Slot = typename Recycle_Allocator<T>::Slot;
+
     T* result;
 
     if (alloc->recycleList)
@@ -920,7 +1695,7 @@ allocate(
 
         if ((bool)ctz)
         {
-            mem_zero(result, sizeof(Recycle_Allocator<T>::Slot));
+            mem_zero(result, sizeof(Slot));
         }
 
 #if BUILD_DEBUG
@@ -931,7 +1706,30 @@ allocate(
     }
     else
     {
-        result = (T*)allocate(alloc->memory, sizeof(Recycle_Allocator<T>::Slot), ctz);
+        Slab* slab = alloc->slab_bump;
+        if (!slab || slab->slot_count_used == slab->slot_count)
+        {
+            // --- Start a new slab, and grow the next one
+
+            if (alloc->slab_slot_count_next <= 0)
+            {
+                // Zero-initialized allocator
+                alloc->slab_slot_count_next = RECYCLE::SLAB_SLOT_COUNT_INITIAL_DEFAULT;
+                alloc->slab_slot_count_max = RECYCLE::SLAB_SLOT_COUNT_MAX_DEFAULT;
+            }
+
+            slab = recycle_slab_push(alloc, alloc->slab_slot_count_next);
+            alloc->slab_bump = slab;
+            alloc->slab_slot_count_next = min(alloc->slab_slot_count_next * 2, alloc->slab_slot_count_max);
+        }
+
+        result = &recycle_slab_slots<T>(slab)[slab->slot_count_used].item;
+        slab->slot_count_used++;
+
+        if ((bool)ctz)
+        {
+            mem_zero(result, sizeof(Slot));
+        }
     }
 
 #if BUILD_DEBUG
@@ -942,6 +1740,7 @@ allocate(
     return result;
 }
 
+// Puts a contiguous slab of cntItemPreallocate slots on the recycle list
 template <typename T>
 function void
 PreallocateRecycleListContiguous(
@@ -949,11 +1748,18 @@ PreallocateRecycleListContiguous(
     int cntItemPreallocate,
     CTZ ctz=CTZ::NO)
 {
-    using Slot = Recycle_Allocator<T>::Slot;
-    Slot * slots = (Slot*)allocate(
-                            alloc->memory,
-                            cntItemPreallocate * sizeof(Recycle_Allocator<T>::Slot),
-                            ctz);
+    using namespace MEM;
+    using Slab = typename Recycle_Allocator<T>::Slab;
+    using Slot = typename Recycle_Allocator<T>::Slot;
+
+    Slab* slab = recycle_slab_push(alloc, cntItemPreallocate);
+    slab->slot_count_used = cntItemPreallocate;
+
+    Slot * slots = recycle_slab_slots<T>(slab);
+    if ((bool)ctz)
+    {
+        mem_zero(slots, cntItemPreallocate * sizeof(Slot));
+    }
 
     for (int iSlot = 0; iSlot < cntItemPreallocate; iSlot++)
     {
@@ -989,4 +1795,30 @@ recycle(Recycle_Allocator<T>* alloc, T* item)
 #endif
 }
 
+// Frees every slab at once. All previously allocated items become invalid. Keeps the current slab growth,
+//  so a reused allocator doesn't have to grow its way back up.
+template <typename T>
+function void
+recycle_allocator_reset(Recycle_Allocator<T>* alloc)
+{
+    using Slab = typename Recycle_Allocator<T>::Slab;
+
+    Slab* slab = alloc->slabs;
+    while (slab)
+    {
+        Slab* slabNext = slab->next;
+        free_tracked_allocation(alloc->memory, slab);
+        slab = slabNext;
+    }
+
+    alloc->slabs = nullptr;
+    alloc->slab_bump = nullptr;
+    alloc->recycleList = nullptr;
+
+#if BUILD_DEBUG
+    alloc->countLive = 0;
+    alloc->countAvailableToRecycle = 0;
+#endif
+}
+
 #undef MEM_DEBUG_NAMES_ENABLE
@@ -0,0 +1,376 @@
+// --- Concurrent memory region
+//  A Memory_Region that many threads can allocate from at once. Each thread attaches its own Thread_Cache,
+//  which services small allocations from power-of-2 size class free lists and a private bump slab. Slabs
+//  are pulled from the shared region in batches, so the lock on it is only taken when a slab runs out,
+//  or for allocations too big for any size class.
+//
+//  Freeing a block owned by another thread's cache pushes it onto that cache's remote free list, which
+//  is lock-free. The owning thread drains it the next time one of its size class lists runs dry.
+//
+//  A thread that's done with the region detaches its cache, which hands its free blocks back to the region's
+//  shared size class lists, where any cache can pick them up. The cache itself (and whatever is left of its
+//  slab) is reused by the next thread that attaches.
+//
+//  usage:
+//      Concurrent_Region* shared = concurrent_region_begin(parent);
+//      ... on each worker thread:
+//      Thread_Cache* cache = concurrent_region_attach(shared);
+//      void* bytes = allocate(cache, 100);
+//      free_tracked_allocation(cache, bytes);
+//      concurrent_region_detach(cache);
+//      ... once all workers are done:
+//      concurrent_region_end(shared);
+
+struct Concurrent_Region;
+
+namespace MEM
+{
+
+namespace CONCURRENT
+{
+static constexpr int SIZE_CLASS_COUNT = 12;                        // 16 bytes ... 32 kb
+static constexpr int SIZE_CLASS_MIN_LOG2 = 4;
+static constexpr int SIZE_CLASS_LARGE = SIZE_CLASS_COUNT;           // Marks blocks that came straight from the shared region
+static constexpr uintptr SLAB_BYTE_COUNT_DEFAULT = KILOBYTES(64);
+static constexpr uintptr ALIGNMENT = 16;
+static constexpr uintptr CACHE_LINE = 64;
+}
+
+struct Thread_Cache;
+
+// Precedes every allocation. 16 bytes, so allocations stay 16-byte aligned.
+struct Concurrent_Block_Header
+{
+    Thread_Cache* cache;        // Owning cache. Large blocks are owned by whichever cache allocated them, but are freed to the shared region.
+    u64 size_class;
+};
+
+struct Concurrent_Free_Block : Concurrent_Block_Header
+{
+    Concurrent_Free_Block* next;
+};
+
+struct Thread_Cache
+{
+    // Written by other threads, so it gets its own cache line
+    Concurrent_Free_Block* volatile remote_free_list;
+    u8 pad[CONCURRENT::CACHE_LINE - sizeof(Concurrent_Free_Block*)];
+
+    // --- Everything below is only touched by the owning thread
+
+    Concurrent_Region* region;
+    Concurrent_Free_Block* free_lists[CONCURRENT::SIZE_CLASS_COUNT];
+    u8* slab_cursor;
+    u8* slab_end;
+
+    // --- Guarded by the region's lock
+
+    Thread_Cache* next;         // In the region's list of caches
+    bool is_attached;           // False once detached, until another thread attaches and reuses it
+};
+
+} // namespace MEM
+
+struct Concurrent_Region
+{
+    Spin_Lock lock;                     // Guards everything below
+    Memory_Region memory;               // Child of the parent region. Slabs, caches, and large blocks live here.
+    MEM::Thread_Cache* caches;
+    uintptr slab_byte_count;
+
+    // Free blocks handed back by detached caches. Read without the lock to check if they're empty.
+    MEM::Concurrent_Free_Block* volatile free_lists[MEM::CONCURRENT::SIZE_CLASS_COUNT];
+};
+
+namespace MEM
+{
+
+function int
+concurrent_size_class(uintptr byte_count)
+{
+    byte_count = max(byte_count, (uintptr)1 << CONCURRENT::SIZE_CLASS_MIN_LOG2);
+
+    int msb = 0;
+    bitscan_msb_index((u64)(byte_count - 1), &msb);
+
+    int result = min(msb + 1 - CONCURRENT::SIZE_CLASS_MIN_LOG2, CONCURRENT::SIZE_CLASS_LARGE);
+    return result;
+}
+
+function uintptr
+concurrent_size_class_byte_count(int size_class)
+{
+    ASSERT(size_class >= 0 && size_class < CONCURRENT::SIZE_CLASS_COUNT);
+
+    uintptr result = (uintptr)1 << (size_class + CONCURRENT::SIZE_CLASS_MIN_LOG2);
+    return result;
+}
+
+// Moves everything other threads have freed to us onto our size class lists
+function void
+thread_cache_drain_remote_frees(Thread_Cache* cache)
+{
+    if (!atomic_load(&cache->remote_free_list))
+        return;
+
+    Concurrent_Free_Block* remote = atomic_exchange(&cache->remote_free_list, (Concurrent_Free_Block*)nullptr);
+    while (remote)
+    {
+        Concurrent_Free_Block* remote_next = remote->next;
+
+        ASSERT(remote->cache == cache);
+        ASSERT(remote->size_class < CONCURRENT::SIZE_CLASS_COUNT);
+
+        remote->next = cache->free_lists[remote->size_class];
+        cache->free_lists[remote->size_class] = remote;
+
+        remote = remote_next;
+    }
+}
+
+function Concurrent_Block_Header*
+thread_cache_allocate_small(Thread_Cache* cache, int size_class)
+{
+    if (!cache->free_lists[size_class])
+    {
+        thread_cache_drain_remote_frees(cache);
+    }
+
+    if (!cache->free_lists[size_class])
+    {
+        // --- Take every block of this size class that detached caches handed back
+
+        Concurrent_Region* region = cache->region;
+        if (atomic_load(&region->free_lists[size_class]))
+        {
+            spin_lock_acquire(&region->lock);
+            cache->free_lists[size_class] = region->free_lists[size_class];
+            region->free_lists[size_class] = nullptr;
+            spin_lock_release(&region->lock);
+        }
+    }
+
+    if (Concurrent_Free_Block* recycled = cache->free_lists[size_class])
+    {
+        cache->free_lists[size_class] = recycled->next;
+        return recycled;
+    }
+
+    // --- Bump allocate from our slab, refilling it from the shared region if it's used up
+
+    uintptr block_byte_count = sizeof(Concurrent_Block_Header) + concurrent_size_class_byte_count(size_class);
+    if ((uintptr)(cache->slab_end - cache->slab_cursor) < block_byte_count)
+    {
+        Concurrent_Region* region = cache->region;
+        uintptr slab_byte_count = max(region->slab_byte_count, block_byte_count);
+
+        // NOTE - Whatever is left of the old slab is too small for this size class, but we don't bother
+        //  carving it into smaller ones. It gets reclaimed when the region ends.
+        spin_lock_acquire(&region->lock);
+        u8* slab = (u8*)allocate(region->memory, slab_byte_count, CONCURRENT::ALIGNMENT);
+        spin_lock_release(&region->lock);
+
+        cache->slab_cursor = slab;
+        cache->slab_end = slab + slab_byte_count;
+    }
+
+    Concurrent_Block_Header* result = (Concurrent_Block_Header*)cache->slab_cursor;
+    cache->slab_cursor += block_byte_count;
+    return result;
+}
+
+} // namespace MEM
+
+function Concurrent_Region*
+concurrent_region_begin(
+    Memory_Region parent,
+    uintptr slab_byte_count = MEM::CONCURRENT::SLAB_BYTE_COUNT_DEFAULT,
+    char const* debug_name = nullptr)
+{
+    using namespace MEM;
+
+    Memory_Region memory = mem_region_begin(parent, slab_byte_count * 4, debug_name);
+
+    Concurrent_Region* result = allocate<Concurrent_Region>(memory, CTZ::YES);
+    result->memory = memory;
+    result->slab_byte_count = slab_byte_count;
+    return result;
+}
+
+// Must be called once by each thread that wants to allocate from the region. The returned cache should
+//  only be used by the calling thread, until it calls concurrent_region_detach(..).
+function MEM::Thread_Cache*
+concurrent_region_attach(Concurrent_Region* region)
+{
+    using namespace MEM;
+
+    spin_lock_acquire(&region->lock);
+
+    Thread_Cache* result = nullptr;
+    for (Thread_Cache* cache = region->caches; cache; cache = cache->next)
+    {
+        if (!cache->is_attached)
+        {
+            result = cache;
+            break;
+        }
+    }
+
+    if (!result)
+    {
+        result = (Thread_Cache*)allocate(region->memory, sizeof(Thread_Cache), CONCURRENT::CACHE_LINE, CTZ::YES);
+        result->region = region;
+        result->next = region->caches;
+        region->caches = result;
+    }
+
+    result->is_attached = true;
+
+    spin_lock_release(&region->lock);
+    return result;
+}
+
+// Hands the cache's free blocks, including ones other threads freed to it, back to the region. Blocks the
+//  thread allocated stay valid, and can still be freed from any attached cache.
+//
+// NOTE - Blocks freed to the cache after it detaches wait on its remote free list until another thread
+//  reuses it (or the region ends).
+function void
+concurrent_region_detach(MEM::Thread_Cache* cache)
+{
+    using namespace MEM;
+
+    Concurrent_Region* region = cache->region;
+    thread_cache_drain_remote_frees(cache);
+
+    spin_lock_acquire(&region->lock);
+
+    ASSERT(cache->is_attached);
+    for (int size_class = 0; size_class < CONCURRENT::SIZE_CLASS_COUNT; size_class++)
+    {
+        Concurrent_Free_Block* head = cache->free_lists[size_class];
+        if (!head)
+            continue;
+
+        Concurrent_Free_Block* tail = head;
+        while (tail->next)
+        {
+            tail = tail->next;
+        }
+
+        tail->next = region->free_lists[size_class];
+        region->free_lists[size_class] = head;
+        cache->free_lists[size_class] = nullptr;
+    }
+
+    cache->is_attached = false;
+
+    spin_lock_release(&region->lock);
+}
+
+// Frees everything allocated from the region, on every thread. No thread may use its cache afterwards.
+function void
+concurrent_region_end(Concurrent_Region* region)
+{
+    mem_region_end(region->memory);
+}
+
+// Result is always 16-byte aligned
+function void*
+allocate(MEM::Thread_Cache* cache, uintptr byte_count, CTZ ctz=CTZ::NO)
+{
+    using namespace MEM;
+
+    Concurrent_Block_Header* header;
+
+    int size_class = concurrent_size_class(byte_count);
+    if (size_class < CONCURRENT::SIZE_CLASS_COUNT)
+    {
+        header = thread_cache_allocate_small(cache, size_class);
+    }
+    else
+    {
+        Concurrent_Region* region = cache->region;
+
+        spin_lock_acquire(&region->lock);
+        header = (Concurrent_Block_Header*)allocate_tracked(
+                                                region->memory,
+                                                sizeof(Concurrent_Block_Header) + byte_count,
+                                                CONCURRENT::ALIGNMENT);
+        spin_lock_release(&region->lock);
+    }
+
+    header->cache = cache;
+    header->size_class = size_class;
+
+    void* result = header + 1;
+    if ((bool)ctz)
+    {
+        mem_zero(result, byte_count);
+    }
+
+    return result;
+}
+
+template <typename T>
+T*
+allocate(
+    MEM::Thread_Cache* cache,
+    CTZ ctz=CTZ::NO)
+{
+    T* result = (T*)allocate(cache, sizeof(T), ctz);
+    return result;
+}
+
+template <typename T>
+T*
+allocate_array(
+    MEM::Thread_Cache* cache,
+    uintptr count,
+    CTZ ctz=CTZ::NO)
+{
+    T* result = (T*)allocate(cache, sizeof(T) * count, ctz);
+    return result;
+}
+
+// Can free allocations made by any thread's cache. The cache is the calling thread's own.
+function void
+free_tracked_allocation(MEM::Thread_Cache* cache, void* allocation)
+{
+    using namespace MEM;
+
+    if (!allocation)
+        return;
+
+    Concurrent_Free_Block* block = (Concurrent_Free_Block*)((Concurrent_Block_Header*)allocation - 1);
+    Thread_Cache* owner = block->cache;
+    ASSERT(owner && owner->region == cache->region);
+    ASSERT(cache->is_attached);
+
+    if (block->size_class >= CONCURRENT::SIZE_CLASS_COUNT)
+    {
+        // --- Large blocks go straight back to the shared region
+
+        Concurrent_Region* region = cache->region;
+
+        spin_lock_acquire(&region->lock);
+        free_tracked_allocation(region->memory, block);
+        spin_lock_release(&region->lock);
+    }
+    else if (owner == cache)
+    {
+        block->next = cache->free_lists[block->size_class];
+        cache->free_lists[block->size_class] = block;
+    }
+    else
+    {
+        // --- Hand it back to the owning thread. Push-only (the owner takes the whole list at once), so no ABA problem.
+
+        Concurrent_Free_Block* head;
+        do
+        {
+            head = atomic_load(&owner->remote_free_list);
+            block->next = head;
+        } while (!atomic_compare_exchange(&owner->remote_free_list, head, block));
+    }
+}
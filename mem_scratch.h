@@ -0,0 +1,261 @@
+// --- Scratch memory
+//  A thread can have a scratch arena for short-lived memory with nested (LIFO) lifetimes. scratch_begin(..)
+//  initializes a root Memory_Region at the top of the arena and returns a marker, and scratch_end(..) rolls
+//  the arena back to that marker. Unlike mem_region_begin(..), no tracked allocation is made in a parent.
+//
+//  Arenas are never created behind your back. Each thread that wants one calls scratch_thread_begin(..) and
+//  scratch_thread_end(..) (Thread_Pool workers do this themselves). Without an arena, or if it's full,
+//  scratch_begin(..) falls back to a child region of the fallback parent passed in, which scratch_end(..)
+//  frees. With no fallback parent, that's a root region, so the MEM::system_allocate hook is required.
+//
+//  A scratch region can still overflow (via MEM::system_allocate) like any other root region. Overflows are
+//  freed by scratch_end(..).
+//
+//  usage:
+//      Scratch scratch = scratch_begin(memory, KILOBYTES(4));
+//      int* temp = allocate_array<int>(scratch.memory, 100);
+//      ...
+//      scratch_end(scratch);
+
+namespace MEM
+{
+
+namespace SCRATCH
+{
+static constexpr uintptr ARENA_BYTE_COUNT_DEFAULT = MEGABYTES(1);
+static constexpr uintptr REGION_BYTE_COUNT_DEFAULT = KILOBYTES(4);
+static constexpr uintptr ALIGNMENT = 16;
+}
+
+struct Scratch_Arena
+{
+    u8* bytes;
+    uintptr byte_count;
+    uintptr cursor;
+};
+
+thread_local Scratch_Arena scratch_arena = {};
+
+} // namespace MEM
+
+struct Scratch
+{
+    Memory_Region memory;
+    uintptr marker;         // Arena cursor to roll back to
+};
+
+// Creates the calling thread's arena, from MEM::system_allocate. Pair with scratch_thread_end(..) before the thread exits.
+function void
+scratch_thread_begin(uintptr byte_count = MEM::SCRATCH::ARENA_BYTE_COUNT_DEFAULT)
+{
+    using namespace MEM;
+
+    Scratch_Arena* arena = &scratch_arena;
+    ASSERT(!arena->bytes);
+    ASSERT(system_allocate);
+
+    arena->bytes = (u8*)system_allocate(byte_count);
+    arena->byte_count = byte_count;
+    arena->cursor = 0;
+}
+
+// Frees the calling thread's arena. Every scratch region on this thread must have ended.
+function void
+scratch_thread_end()
+{
+    using namespace MEM;
+
+    Scratch_Arena* arena = &scratch_arena;
+    ASSERT(arena->cursor == 0);
+
+    system_free(arena->bytes);
+    *arena = {};
+}
+
+// Falls back to a child of fallback_parent if the calling thread has no arena, or it's full
+function Scratch
+scratch_begin(Memory_Region fallback_parent, uintptr byte_count = MEM::SCRATCH::REGION_BYTE_COUNT_DEFAULT, char const* debug_name = nullptr)
+{
+    using namespace MEM;
+
+    Scratch_Arena* arena = &scratch_arena;
+
+    byte_count = max(byte_count, BYTE_COUNT::MINIMUM_REGION);
+    byte_count += mem_align_offset(byte_count, SCRATCH::ALIGNMENT);
+
+    Scratch result;
+    result.marker = arena->cursor;
+
+    if (arena->byte_count - arena->cursor >= byte_count)
+    {
+        result.memory = mem_region_init(arena->bytes + arena->cursor, byte_count, nullptr, debug_name);
+        arena->cursor += byte_count;
+    }
+    else
+    {
+        // No arena and no fallback parent needs the MEM::system_allocate hook. Either call scratch_thread_begin(..)
+        //  on this thread, pass a fallback parent, or install the hook.
+        ASSERT(fallback_parent || system_allocate);
+        result.memory = mem_region_begin(fallback_parent, byte_count, debug_name);
+    }
+
+    return result;
+}
+
+function Scratch
+scratch_begin(uintptr byte_count = MEM::SCRATCH::REGION_BYTE_COUNT_DEFAULT, char const* debug_name = nullptr)
+{
+    Scratch result = scratch_begin(nullptr, byte_count, debug_name);
+    return result;
+}
+
+// Scratch regions must end in the reverse order they began
+function void
+scratch_end(Scratch scratch)
+{
+    using namespace MEM;
+
+    Scratch_Arena* arena = &scratch_arena;
+
+    u8* bytes = (u8*)scratch.memory;
+    bool is_in_arena = (bytes >= arena->bytes && bytes < arena->bytes + arena->byte_count);
+    if (is_in_arena)
+    {
+        ASSERT(bytes == arena->bytes + scratch.marker);
+        ASSERT(bytes + scratch.memory->byte_budget == arena->bytes + arena->cursor);
+
+        // Frees overflows and children. The region itself is just rolled back.
+        mem_region_reset(scratch.memory);
+        arena->cursor = scratch.marker;
+    }
+    else
+    {
+        mem_region_end(scratch.memory);
+    }
+}
+
+// --- Recycle_Allocator walks. These live here, rather than in mem_alloc.h, since they need scratch memory.
+
+namespace MEM
+{
+
+// Where one slab's used slots are, and where its bits start in recycle_allocator_for_each_live's bitmap
+struct Recycle_Slab_Range
+{
+    uintptr begin;
+    uintptr end;
+    int bit_base;
+};
+
+} // namespace MEM
+
+// Calls visit(T*) on every live item, in no particular order. Not free: it marks the recycled slots in
+//  a temporary bitmap first, finding each one's slab with a binary search over the slabs sorted by
+//  address. O(# recycled * log(# slabs) + # slots), plus sorting the slabs, which is usually O(# slabs).
+template <typename T, typename Fn>
+function void
+recycle_allocator_for_each_live(Recycle_Allocator<T>* alloc, Fn visit)
+{
+    using namespace MEM;
+    using Slab = typename Recycle_Allocator<T>::Slab;
+    using Slot = typename Recycle_Allocator<T>::Slot;
+
+    // --- Give each slab a range of bits, in list order
+
+    int slab_count = 0;
+    int slot_count_total = 0;
+    for (Slab* slab = alloc->slabs; slab; slab = slab->next)
+    {
+        slab_count++;
+        slot_count_total += slab->slot_count_used;
+    }
+
+    if (slot_count_total == 0)
+        return;
+
+    int word_count = (slot_count_total + 63) / 64;
+    Scratch scratch = scratch_begin(
+                        alloc->memory,
+                        word_count * sizeof(u64) + slab_count * sizeof(Recycle_Slab_Range) + alignof(Recycle_Slab_Range));
+
+    u64* recycled_bits = allocate_array<u64>(scratch.memory, word_count, CTZ::YES);
+
+    if (alloc->recycleList)
+    {
+        Recycle_Slab_Range* ranges = allocate_array<Recycle_Slab_Range>(scratch.memory, slab_count);
+
+        // Slabs are newest first, and newer slabs usually sit at higher addresses, so filling from the back
+        //  leaves the ranges nearly sorted. Insertion sort by address is then about one compare per slab.
+        int bit_base = 0;
+        int range_count = 0;
+        for (Slab* slab = alloc->slabs; slab; slab = slab->next)
+        {
+            Slot* slots = recycle_slab_slots<T>(slab);
+
+            Recycle_Slab_Range range;
+            range.begin = (uintptr)slots;
+            range.end = (uintptr)(slots + slab->slot_count_used);
+            range.bit_base = bit_base;
+
+            int i = slab_count - range_count;
+            while (i < slab_count && ranges[i].begin < range.begin)
+            {
+                ranges[i - 1] = ranges[i];
+                i++;
+            }
+
+            ranges[i - 1] = range;
+            range_count++;
+            bit_base += slab->slot_count_used;
+        }
+
+        // --- Mark recycled slots
+
+        for (Slot* recycled = alloc->recycleList; recycled; recycled = recycled->pNextRecycled)
+        {
+            // Last slab that starts at or before the slot
+            uintptr address = (uintptr)recycled;
+            int low = 0;
+            int high = slab_count;
+            while (low < high)
+            {
+                int middle = (low + high) / 2;
+                if (ranges[middle].begin <= address)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+
+            ASSERT(low > 0);
+            Recycle_Slab_Range const& range = ranges[low - 1];
+            ASSERT(address < range.end);
+
+            int bit = range.bit_base + (int)((address - range.begin) / sizeof(Slot));
+            recycled_bits[bit / 64] |= (u64)1 << (bit % 64);
+        }
+    }
+
+    // --- Visit everything else
+
+    int bit_base = 0;
+    for (Slab* slab = alloc->slabs; slab; slab = slab->next)
+    {
+        Slot* slots = recycle_slab_slots<T>(slab);
+        for (int i = 0; i < slab->slot_count_used; i++)
+        {
+            int bit = bit_base + i;
+            if (!(recycled_bits[bit / 64] & ((u64)1 << (bit % 64))))
+            {
+                visit(&slots[i].item);
+            }
+        }
+
+        bit_base += slab->slot_count_used;
+    }
+
+    scratch_end(scratch);
+}
@@ -0,0 +1,56 @@
+// --- Text dump of a region tree's stats (see mem_region_stats(..)). One line per region, indented by depth.
+//      Lives apart from mem_alloc.h since it needs string formatting.
+
+#if MEM_STATS_ENABLE
+
+using Fn_Mem_Stats_Print = void (*)(char const* line, void* user);
+
+namespace MEM
+{
+
+struct Stats_Dump_Ctx
+{
+    Fn_Mem_Stats_Print print;
+    void* user;
+};
+
+function void
+stats_dump_visit(Memory_Region_Stats const& stats, int depth, void* user)
+{
+    Stats_Dump_Ctx* ctx = (Stats_Dump_Ctx*)user;
+
+    char line[256];
+    zstrFromPrintf(
+        line,
+        ARRAY_LEN(line),
+        "%*s%-8s budget %llu, live %llu (peak %llu), overflow %llu x (%llu bytes), "
+        "free %d tracked + %d shared (%llu bytes, largest %llu), fragmentation %.2f\n",
+        depth * 2, "",
+        stats.name[0] ? stats.name : "?",
+        (unsigned long long)stats.byte_budget,
+        (unsigned long long)stats.counters.live_byte_count,
+        (unsigned long long)stats.counters.live_byte_count_peak,
+        (unsigned long long)stats.counters.overflow_count,
+        (unsigned long long)stats.counters.overflow_byte_count,
+        stats.tracked_free_block_count,
+        stats.shared_free_block_count,
+        (unsigned long long)stats.free_byte_count,
+        (unsigned long long)stats.largest_free_byte_count,
+        stats.fragmentation);
+
+    ctx->print(line, ctx->user);
+}
+
+} // namespace MEM
+
+function void
+mem_region_stats_dump(Memory_Region root, Fn_Mem_Stats_Print print, void* user = nullptr)
+{
+    MEM::Stats_Dump_Ctx ctx = {};
+    ctx.print = print;
+    ctx.user = user;
+
+    mem_region_stats_visit_tree(root, MEM::stats_dump_visit, &ctx);
+}
+
+#endif // MEM_STATS_ENABLE
@@ -32,9 +32,455 @@ mem_align_offset(uintptr value, uintptr alignment)
     return alignOffset;
 }
 
+// --- SIMD kernels for mem_copy / mem_move / mem_set / mem_zero.
+//      SSE2 is always available on x64. AVX2 is used if the CPU supports it, which is detected once at startup.
+//      Very large copies and sets use non-temporal stores, so they don't evict everything else from the cache.
+//      Disable to use the plain byte loops.
+
+#ifndef MEM_SIMD_ENABLE
+ #define MEM_SIMD_ENABLE 1
+#endif
+
+#if MEM_SIMD_ENABLE
+
+#if COMPILER_MSVC
+ #include <intrin.h>
+ #define MEM_TARGET_AVX2
+#else
+ #define MEM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace MEM
+{
+
+namespace SIMD
+{
+static constexpr uintptr NON_TEMPORAL_MIN_BYTE_COUNT = MEGABYTES(4);    // Won't stay in cache anyway, so bypass it
+}
+
+enum class Simd_Level : u8
+{
+    SSE2 = 0,
+    AVX2,
+};
+
+function Simd_Level
+simd_level_detect()
+{
+#if COMPILER_MSVC
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return Simd_Level::SSE2;
+
+    // AVX needs OS support for saving the ymm registers
+    __cpuid(info, 1);
+    bool has_osxsave = info[2] & (1 << 27);
+    bool has_avx = info[2] & (1 << 28);
+    if (!has_osxsave || !has_avx || (_xgetbv(0) & 0x6) != 0x6)
+        return Simd_Level::SSE2;
+
+    __cpuidex(info, 7, 0);
+    bool has_avx2 = info[1] & (1 << 5);
+    return has_avx2 ? Simd_Level::AVX2 : Simd_Level::SSE2;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? Simd_Level::AVX2 : Simd_Level::SSE2;
+#endif
+}
+
+// Anything that runs before this is initialized just gets SSE2
+static Simd_Level const simd_level = simd_level_detect();
+
+// All of the move kernels load the first and last vector up front, and store them last. That covers the
+//  unaligned head and tail, and makes overlapping moves safe, as long as the direction is right:
+//  forward for dst <= src, backward for dst > src.
+
+// Any byte count. Both directions.
+function void
+simd_move_small(u8* dst, u8 const* src, uintptr bytes)
+{
+    if (bytes >= 8)
+    {
+        __m128i head = _mm_loadl_epi64((__m128i const*)src);
+        __m128i tail = _mm_loadl_epi64((__m128i const*)(src + bytes - 8));
+        _mm_storel_epi64((__m128i*)dst, head);
+        _mm_storel_epi64((__m128i*)(dst + bytes - 8), tail);
+    }
+    else if (dst <= src)
+    {
+        for (uintptr i = 0; i < bytes; i++)
+        {
+            dst[i] = src[i];
+        }
+    }
+    else
+    {
+        for (uintptr i = bytes; i > 0; i--)
+        {
+            dst[i - 1] = src[i - 1];
+        }
+    }
+}
+
+// bytes >= 16
+function void
+simd_move_forward_sse2(u8* dst, u8 const* src, uintptr bytes, bool non_temporal)
+{
+    __m128i head = _mm_loadu_si128((__m128i const*)src);
+    __m128i tail = _mm_loadu_si128((__m128i const*)(src + bytes - 16));
+
+    uintptr skip = 16 - ((uintptr)dst & 15);
+    u8* d = dst + skip;
+    u8 const* s = src + skip;
+    u8* d_end = dst + bytes - 16;
+
+    if (non_temporal)
+    {
+        for (; d_end - d >= 64; d += 64, s += 64)
+        {
+            __m128i v0 = _mm_loadu_si128((__m128i const*)s);
+            __m128i v1 = _mm_loadu_si128((__m128i const*)(s + 16));
+            __m128i v2 = _mm_loadu_si128((__m128i const*)(s + 32));
+            __m128i v3 = _mm_loadu_si128((__m128i const*)(s + 48));
+            _mm_stream_si128((__m128i*)d, v0);
+            _mm_stream_si128((__m128i*)(d + 16), v1);
+            _mm_stream_si128((__m128i*)(d + 32), v2);
+            _mm_stream_si128((__m128i*)(d + 48), v3);
+        }
+
+        for (; d < d_end; d += 16, s += 16)
+        {
+            _mm_stream_si128((__m128i*)d, _mm_loadu_si128((__m128i const*)s));
+        }
+
+        _mm_sfence();
+    }
+    else
+    {
+        for (; d_end - d >= 64; d += 64, s += 64)
+        {
+            __m128i v0 = _mm_loadu_si128((__m128i const*)s);
+            __m128i v1 = _mm_loadu_si128((__m128i const*)(s + 16));
+            __m128i v2 = _mm_loadu_si128((__m128i const*)(s + 32));
+            __m128i v3 = _mm_loadu_si128((__m128i const*)(s + 48));
+            _mm_store_si128((__m128i*)d, v0);
+            _mm_store_si128((__m128i*)(d + 16), v1);
+            _mm_store_si128((__m128i*)(d + 32), v2);
+            _mm_store_si128((__m128i*)(d + 48), v3);
+        }
+
+        for (; d < d_end; d += 16, s += 16)
+        {
+            _mm_store_si128((__m128i*)d, _mm_loadu_si128((__m128i const*)s));
+        }
+    }
+
+    _mm_storeu_si128((__m128i*)dst, head);
+    _mm_storeu_si128((__m128i*)d_end, tail);
+}
+
+// bytes >= 16
+function void
+simd_move_backward_sse2(u8* dst, u8 const* src, uintptr bytes)
+{
+    __m128i head = _mm_loadu_si128((__m128i const*)src);
+    __m128i tail = _mm_loadu_si128((__m128i const*)(src + bytes - 16));
+
+    uintptr skip = (uintptr)(dst + bytes) & 15;
+    u8* d = dst + bytes - skip;
+    u8 const* s = src + bytes - skip;
+
+    while (d - dst > 64)
+    {
+        d -= 64;
+        s -= 64;
+        __m128i v0 = _mm_loadu_si128((__m128i const*)s);
+        __m128i v1 = _mm_loadu_si128((__m128i const*)(s + 16));
+        __m128i v2 = _mm_loadu_si128((__m128i const*)(s + 32));
+        __m128i v3 = _mm_loadu_si128((__m128i const*)(s + 48));
+        _mm_store_si128((__m128i*)d, v0);
+        _mm_store_si128((__m128i*)(d + 16), v1);
+        _mm_store_si128((__m128i*)(d + 32), v2);
+        _mm_store_si128((__m128i*)(d + 48), v3);
+    }
+
+    while (d > dst + 16)
+    {
+        d -= 16;
+        s -= 16;
+        _mm_store_si128((__m128i*)d, _mm_loadu_si128((__m128i const*)s));
+    }
+
+    _mm_storeu_si128((__m128i*)(dst + bytes - 16), tail);
+    _mm_storeu_si128((__m128i*)dst, head);
+}
+
+// bytes >= 32
+MEM_TARGET_AVX2 function void
+simd_move_forward_avx2(u8* dst, u8 const* src, uintptr bytes, bool non_temporal)
+{
+    __m256i head = _mm256_loadu_si256((__m256i const*)src);
+    __m256i tail = _mm256_loadu_si256((__m256i const*)(src + bytes - 32));
+
+    uintptr skip = 32 - ((uintptr)dst & 31);
+    u8* d = dst + skip;
+    u8 const* s = src + skip;
+    u8* d_end = dst + bytes - 32;
+
+    if (non_temporal)
+    {
+        for (; d_end - d >= 128; d += 128, s += 128)
+        {
+            __m256i v0 = _mm256_loadu_si256((__m256i const*)s);
+            __m256i v1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+            __m256i v2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+            __m256i v3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+            _mm256_stream_si256((__m256i*)d, v0);
+            _mm256_stream_si256((__m256i*)(d + 32), v1);
+            _mm256_stream_si256((__m256i*)(d + 64), v2);
+            _mm256_stream_si256((__m256i*)(d + 96), v3);
+        }
+
+        for (; d < d_end; d += 32, s += 32)
+        {
+            _mm256_stream_si256((__m256i*)d, _mm256_loadu_si256((__m256i const*)s));
+        }
+
+        _mm_sfence();
+    }
+    else
+    {
+        for (; d_end - d >= 128; d += 128, s += 128)
+        {
+            __m256i v0 = _mm256_loadu_si256((__m256i const*)s);
+            __m256i v1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+            __m256i v2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+            __m256i v3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+            _mm256_store_si256((__m256i*)d, v0);
+            _mm256_store_si256((__m256i*)(d + 32), v1);
+            _mm256_store_si256((__m256i*)(d + 64), v2);
+            _mm256_store_si256((__m256i*)(d + 96), v3);
+        }
+
+        for (; d < d_end; d += 32, s += 32)
+        {
+            _mm256_store_si256((__m256i*)d, _mm256_loadu_si256((__m256i const*)s));
+        }
+    }
+
+    _mm256_storeu_si256((__m256i*)dst, head);
+    _mm256_storeu_si256((__m256i*)d_end, tail);
+}
+
+// bytes >= 32
+MEM_TARGET_AVX2 function void
+simd_move_backward_avx2(u8* dst, u8 const* src, uintptr bytes)
+{
+    __m256i head = _mm256_loadu_si256((__m256i const*)src);
+    __m256i tail = _mm256_loadu_si256((__m256i const*)(src + bytes - 32));
+
+    uintptr skip = (uintptr)(dst + bytes) & 31;
+    u8* d = dst + bytes - skip;
+    u8 const* s = src + bytes - skip;
+
+    while (d - dst > 128)
+    {
+        d -= 128;
+        s -= 128;
+        __m256i v0 = _mm256_loadu_si256((__m256i const*)s);
+        __m256i v1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+        __m256i v2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+        __m256i v3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+        _mm256_store_si256((__m256i*)d, v0);
+        _mm256_store_si256((__m256i*)(d + 32), v1);
+        _mm256_store_si256((__m256i*)(d + 64), v2);
+        _mm256_store_si256((__m256i*)(d + 96), v3);
+    }
+
+    while (d > dst + 32)
+    {
+        d -= 32;
+        s -= 32;
+        _mm256_store_si256((__m256i*)d, _mm256_loadu_si256((__m256i const*)s));
+    }
+
+    _mm256_storeu_si256((__m256i*)(dst + bytes - 32), tail);
+    _mm256_storeu_si256((__m256i*)dst, head);
+}
+
+// bytes >= 16
+function void
+simd_set_sse2(u8* dst, u8 value, uintptr bytes)
+{
+    __m128i v = _mm_set1_epi8((char)value);
+
+    u8* d = (u8*)(((uintptr)dst + 16) & ~(uintptr)15);
+    u8* d_end = dst + bytes - 16;
+
+    if (bytes >= SIMD::NON_TEMPORAL_MIN_BYTE_COUNT)
+    {
+        for (; d_end - d >= 64; d += 64)
+        {
+            _mm_stream_si128((__m128i*)d, v);
+            _mm_stream_si128((__m128i*)(d + 16), v);
+            _mm_stream_si128((__m128i*)(d + 32), v);
+            _mm_stream_si128((__m128i*)(d + 48), v);
+        }
+
+        for (; d < d_end; d += 16)
+        {
+            _mm_stream_si128((__m128i*)d, v);
+        }
+
+        _mm_sfence();
+    }
+    else
+    {
+        for (; d_end - d >= 64; d += 64)
+        {
+            _mm_store_si128((__m128i*)d, v);
+            _mm_store_si128((__m128i*)(d + 16), v);
+            _mm_store_si128((__m128i*)(d + 32), v);
+            _mm_store_si128((__m128i*)(d + 48), v);
+        }
+
+        for (; d < d_end; d += 16)
+        {
+            _mm_store_si128((__m128i*)d, v);
+        }
+    }
+
+    _mm_storeu_si128((__m128i*)dst, v);
+    _mm_storeu_si128((__m128i*)d_end, v);
+}
+
+// bytes >= 32
+MEM_TARGET_AVX2 function void
+simd_set_avx2(u8* dst, u8 value, uintptr bytes)
+{
+    __m256i v = _mm256_set1_epi8((char)value);
+
+    u8* d = (u8*)(((uintptr)dst + 32) & ~(uintptr)31);
+    u8* d_end = dst + bytes - 32;
+
+    if (bytes >= SIMD::NON_TEMPORAL_MIN_BYTE_COUNT)
+    {
+        for (; d_end - d >= 128; d += 128)
+        {
+            _mm256_stream_si256((__m256i*)d, v);
+            _mm256_stream_si256((__m256i*)(d + 32), v);
+            _mm256_stream_si256((__m256i*)(d + 64), v);
+            _mm256_stream_si256((__m256i*)(d + 96), v);
+        }
+
+        for (; d < d_end; d += 32)
+        {
+            _mm256_stream_si256((__m256i*)d, v);
+        }
+
+        _mm_sfence();
+    }
+    else
+    {
+        for (; d_end - d >= 128; d += 128)
+        {
+            _mm256_store_si256((__m256i*)d, v);
+            _mm256_store_si256((__m256i*)(d + 32), v);
+            _mm256_store_si256((__m256i*)(d + 64), v);
+            _mm256_store_si256((__m256i*)(d + 96), v);
+        }
+
+        for (; d < d_end; d += 32)
+        {
+            _mm256_store_si256((__m256i*)d, v);
+        }
+    }
+
+    _mm256_storeu_si256((__m256i*)dst, v);
+    _mm256_storeu_si256((__m256i*)d_end, v);
+}
+
+// non_temporal is only allowed if src and dst don't overlap
+function void
+simd_move(u8* dst, u8 const* src, uintptr bytes, bool non_temporal)
+{
+    if (bytes < 16)
+    {
+        simd_move_small(dst, src, bytes);
+    }
+    else if (bytes < 32 || simd_level != Simd_Level::AVX2)
+    {
+        if (dst <= src)
+        {
+            simd_move_forward_sse2(dst, src, bytes, non_temporal);
+        }
+        else
+        {
+            simd_move_backward_sse2(dst, src, bytes);
+        }
+    }
+    else
+    {
+        if (dst <= src)
+        {
+            simd_move_forward_avx2(dst, src, bytes, non_temporal);
+        }
+        else
+        {
+            simd_move_backward_avx2(dst, src, bytes);
+        }
+    }
+}
+
+// Forward only. src and dst must not overlap.
+function void
+simd_copy(u8* dst, u8 const* src, uintptr bytes, bool non_temporal)
+{
+    if (bytes < 16)
+    {
+        simd_move_small(dst, src, bytes);
+    }
+    else if (bytes < 32 || simd_level != Simd_Level::AVX2)
+    {
+        simd_move_forward_sse2(dst, src, bytes, non_temporal);
+    }
+    else
+    {
+        simd_move_forward_avx2(dst, src, bytes, non_temporal);
+    }
+}
+
+function void
+simd_set(u8* dst, u8 value, uintptr bytes)
+{
+    if (bytes < 16)
+    {
+        for (uintptr i = 0; i < bytes; i++)
+        {
+            dst[i] = value;
+        }
+    }
+    else if (bytes < 32 || simd_level != Simd_Level::AVX2)
+    {
+        simd_set_sse2(dst, value, bytes);
+    }
+    else
+    {
+        simd_set_avx2(dst, value, bytes);
+    }
+}
+
+} // namespace MEM
+
+#endif // MEM_SIMD_ENABLE
+
 function void
 mem_zero(void* memory, uintptr cBytes)
 {
+#if MEM_SIMD_ENABLE
+    MEM::simd_set((u8*)memory, 0, cBytes);
+#else
     bool isMemory8ByteAligned = (((uintptr)memory & 0x7) == 0);
     bool isCount8ByteMultiple = ((cBytes & 0x7) == 0);
     
@@ -61,6 +507,7 @@ mem_zero(void* memory, uintptr cBytes)
             pByte++;
         }
     }
+#endif
 }
 
 #define ZeroArray(array) do { mem_zero((array), ARRAY_LEN(array) * sizeof((array)[0])); } while (0)
@@ -69,9 +516,13 @@ mem_zero(void* memory, uintptr cBytes)
 function void
 mem_copy(void* dst, void const* src, uintptr bytes)
 {
-    // NOTE - Does not try to handle overlapping src / dst
-    // TODO - Copy multi-byte chunks for performance (like mem_zero does...)
+    // NOTE - Does not try to handle overlapping src / dst. Use mem_move for that.
+    ASSERT((u8*)dst + bytes <= (u8 const*)src || (u8 const*)src + bytes <= (u8*)dst || bytes == 0);
 
+#if MEM_SIMD_ENABLE
+    bool non_temporal = (bytes >= MEM::SIMD::NON_TEMPORAL_MIN_BYTE_COUNT);
+    MEM::simd_copy((u8*)dst, (u8 const*)src, bytes, non_temporal);
+#else
     u8 * s = (u8 *)src;
     u8 * d = (u8 *)dst;
     for (uintptr i = 0; i < bytes; i++)
@@ -80,6 +531,7 @@ mem_copy(void* dst, void const* src, uintptr bytes)
         d++;
         s++;
     }
+#endif
 }
 
 template<typename T>
@@ -93,11 +545,24 @@ function void
 mem_move(void* dst, void* src, uintptr bytes)
 {
     // NOTE - Like CopyMemory, but handles overlapping src/dst
-    // TODO - Copy multi-byte chunks for performance (like mem_zero does...)
 
+#if MEM_SIMD_ENABLE
+    u8* d = (u8*)dst;
+    u8* s = (u8*)src;
+    bool is_overlapping = (d < s + bytes && s < d + bytes);
+    bool non_temporal = (!is_overlapping && bytes >= MEM::SIMD::NON_TEMPORAL_MIN_BYTE_COUNT);
+    MEM::simd_move(d, s, bytes, non_temporal);
+#else
     if (src >= dst)
     {
-        mem_copy(dst, src, bytes);
+        u8 * s = (u8 *)src;
+        u8 * d = (u8 *)dst;
+        for (uintptr i = 0; i < bytes; i++)
+        {
+            *d = *s;
+            d++;
+            s++;
+        }
     }
     else
     {
@@ -110,19 +575,22 @@ mem_move(void* dst, void* src, uintptr bytes)
             s--;
         }
     }
+#endif
 }
 
 function void
 mem_set(void* dst, u8 value, uintptr bytes)
 {
-    // TODO - Copy multi-byte chunks for performance (like mem_zero does...)
-
+#if MEM_SIMD_ENABLE
+    MEM::simd_set((u8*)dst, value, bytes);
+#else
     u8* cursor = (u8*)dst;
     while (bytes--)
     {
         *cursor = value;
         cursor++;
     }
+#endif
 }
 
 template<class T>
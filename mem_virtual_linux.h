@@ -0,0 +1,40 @@
+#pragma once
+
+// --- Linux virtual memory backend for mem_region_begin_virtual(..)
+//  Not included by core.h, since it pulls in system headers. Include it from the platform layer, and call
+//  mem_virtual_linux_install() once at startup.
+
+#include <sys/mman.h>
+
+function void*
+mem_virtual_linux_reserve(uintptr byte_count)
+{
+    // PROT_NONE + MAP_NORESERVE only claims address space. No pages or swap are set aside until committed.
+    void* result = mmap(nullptr, byte_count, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (result == MAP_FAILED)
+        return nullptr;
+
+    return result;
+}
+
+function bool
+mem_virtual_linux_commit(void* address, uintptr byte_count)
+{
+    // Pages are still only physically backed (and zeroed) on first touch
+    bool result = (mprotect(address, byte_count, PROT_READ | PROT_WRITE) == 0);
+    return result;
+}
+
+function void
+mem_virtual_linux_release(void* address, uintptr byte_count)
+{
+    munmap(address, byte_count);
+}
+
+function void
+mem_virtual_linux_install()
+{
+    MEM::system_reserve = mem_virtual_linux_reserve;
+    MEM::system_commit = mem_virtual_linux_commit;
+    MEM::system_release = mem_virtual_linux_release;
+}
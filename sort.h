@@ -11,37 +11,105 @@ inline int i8_compare(i8 const& lhs, i8 const& rhs) { return (lhs > rhs) - (lhs
 inline int f32_compare(f32 const& lhs, f32 const& rhs) { return (lhs > rhs) - (lhs < rhs); }
 inline int f64_compare(f64 const& lhs, f64 const& rhs) { return (lhs > rhs) - (lhs < rhs); }
 
-// NOTE - If not found, returns a negative value that can be bit-flipped with ~
-//    to find the index that the item *should* go into to keep the list sorted
+// --- Binary search
+//  LowerBound / UpperBound are branchless: each step picks the next half with a conditional move instead of a
+//  branch the CPU has to guess (it guesses wrong half the time). The loop runs exactly log2(count) times no
+//  matter where the item is. Large arrays also prefetch both possible next midpoints, so the next step's cache
+//  miss is already underway while this step's compare runs.
+
+namespace SORT
+{
+static constexpr int SEARCH_PREFETCH_BYTE_COUNT = 64 * 1024;     // Smaller arrays are probably already in cache
+}
+
+// Index of the first item that isn't less than item, or sorted.count if there isn't one
 template <class T, class FN_COMPARATOR>
-int BinarySearch(Slice<T> sorted, T const& item, int iLow, int iHigh, FN_COMPARATOR compare)
+function int
+LowerBound(Slice<T> sorted, T const& item, FN_COMPARATOR compare)
 {
     if (sorted.count <= 0)
-        return ~0;
+        return 0;
 
-    iLow = clamp(iLow, 0, sorted.count - 1);
-    iHigh = clamp(iHigh, 0, sorted.count - 1); // NOTE - iHigh is inclusive! Hmm should it be?
+    T const* base = sorted.items;
+    int count = sorted.count;
+    bool should_prefetch = (sorted.count * (int)sizeof(T) > SORT::SEARCH_PREFETCH_BYTE_COUNT);
 
-    while (iHigh >= iLow)
+    while (count > 1)
     {
-        int iCandidate = (iLow + iHigh) / 2;
-        T* candidate = sorted.items + iCandidate;
-
-        int compareResult = compare(item, *candidate);
-        if (compareResult == 0)
-            return iCandidate;
-
-        if (compareResult > 0)
+        int half = count / 2;
+        if (should_prefetch)
         {
-            iLow = iCandidate + 1;
+            _mm_prefetch((char const*)(base + half / 2), _MM_HINT_T0);
+            _mm_prefetch((char const*)(base + half + half / 2), _MM_HINT_T0);
         }
-        else if (compareResult < 0)
+
+        base = (compare(base[half - 1], item) < 0) ? base + half : base;
+        count -= half;
+    }
+
+    int result = (int)(base - sorted.items) + ((compare(*base, item) < 0) ? 1 : 0);
+    return result;
+}
+
+// Index of the first item that's greater than item, or sorted.count if there isn't one
+template <class T, class FN_COMPARATOR>
+function int
+UpperBound(Slice<T> sorted, T const& item, FN_COMPARATOR compare)
+{
+    if (sorted.count <= 0)
+        return 0;
+
+    T const* base = sorted.items;
+    int count = sorted.count;
+    bool should_prefetch = (sorted.count * (int)sizeof(T) > SORT::SEARCH_PREFETCH_BYTE_COUNT);
+
+    while (count > 1)
+    {
+        int half = count / 2;
+        if (should_prefetch)
         {
-            iHigh = iCandidate - 1;
+            _mm_prefetch((char const*)(base + half / 2), _MM_HINT_T0);
+            _mm_prefetch((char const*)(base + half + half / 2), _MM_HINT_T0);
         }
+
+        base = (compare(item, base[half - 1]) >= 0) ? base + half : base;
+        count -= half;
     }
 
-    int result = ~iLow;
+    int result = (int)(base - sorted.items) + ((compare(item, *base) >= 0) ? 1 : 0);
+    return result;
+}
+
+// The items equal to item. Empty (but pointing where item would go) if there aren't any.
+template <class T, class FN_COMPARATOR>
+function Slice<T>
+EqualRange(Slice<T> sorted, T const& item, FN_COMPARATOR compare)
+{
+    int begin = LowerBound(sorted, item, compare);
+    int end = begin + UpperBound(slice_create(sorted.items + begin, sorted.count - begin), item, compare);
+    Slice<T> result = slice_create(sorted.items + begin, end - begin);
+    return result;
+}
+
+// NOTE - If not found, returns a negative value that can be bit-flipped with ~
+//    to find the index that the item *should* go into to keep the list sorted.
+//    If there are several equal items, returns the first.
+template <class T, class FN_COMPARATOR>
+int BinarySearch(Slice<T> sorted, T const& item, int iLow, int iHigh, FN_COMPARATOR compare)
+{
+    if (sorted.count <= 0)
+        return ~0;
+
+    iLow = clamp(iLow, 0, sorted.count - 1);
+    iHigh = clamp(iHigh, 0, sorted.count - 1); // NOTE - iHigh is inclusive! Hmm should it be?
+    if (iHigh < iLow)
+        return ~iLow;
+
+    int index = iLow + LowerBound(slice_create(sorted.items + iLow, iHigh - iLow + 1), item, compare);
+    if (index <= iHigh && compare(item, sorted.items[index]) == 0)
+        return index;
+
+    int result = ~index;
     ASSERT(result < 0);
     return result;
 }
@@ -53,18 +121,158 @@ int BinarySearch(Slice<T> sorted, T const& item, FN_COMPARATOR compare)
     return result;
 }
 
+// Inserts after any equal items, so items that compare equal stay in insertion order
 template <class T, class FN_COMPARATOR>
 void InsertSorted(DynArray<T> * array, T const& item, FN_COMPARATOR compare)
 {
-    int index = BinarySearch(slice_create(*array), item, compare);
-    if (index < 0)
+    int index = UpperBound(slice_create(*array), item, compare);
+    Insert(array, item, index);
+}
+
+namespace SORT
+{
+static constexpr int SEARCH_BATCH_COUNT = 16;      // Searches in flight. Enough to overlap trips to DRAM.
+}
+
+// Sets out[i] to LowerBound(sorted, items[i], compare). Runs a chunk of searches in lockstep (they all take
+//  log2(count) steps over the same array), so each step issues every search's cache miss before waiting on any.
+template <class T, class FN_COMPARATOR>
+function void
+LowerBoundBatch(Slice<T> sorted, Slice<T> items, Slice<int> out, FN_COMPARATOR compare)
+{
+    ASSERT(out.count >= items.count);
+
+    if (sorted.count <= 0)
     {
-        index = ~index;
+        for (int i = 0; i < items.count; i++) out[i] = 0;
+        return;
     }
 
-    Insert(array, item, index);
+    int bases[SORT::SEARCH_BATCH_COUNT];
+    for (int chunk_start = 0; chunk_start < items.count; chunk_start += SORT::SEARCH_BATCH_COUNT)
+    {
+        int chunk_count = min(SORT::SEARCH_BATCH_COUNT, items.count - chunk_start);
+        T const* chunk_items = items.items + chunk_start;
+
+        for (int i = 0; i < chunk_count; i++)
+        {
+            bases[i] = 0;
+        }
+
+        int count = sorted.count;
+        while (count > 1)
+        {
+            int half = count / 2;
+            for (int i = 0; i < chunk_count; i++)
+            {
+                bases[i] += (compare(sorted.items[bases[i] + half - 1], chunk_items[i]) < 0) ? half : 0;
+            }
+
+            count -= half;
+            for (int i = 0; i < chunk_count; i++)
+            {
+                _mm_prefetch((char const*)(sorted.items + bases[i] + count / 2 - 1), _MM_HINT_T0);
+            }
+        }
+
+        for (int i = 0; i < chunk_count; i++)
+        {
+            out[chunk_start + i] = bases[i] + ((compare(sorted.items[bases[i]], chunk_items[i]) < 0) ? 1 : 0);
+        }
+    }
+}
+
+
+
+// --- Eytzinger layout
+//  A sorted array stored in breadth-first order of its implicit binary search tree: the root at 1, the children
+//  of k at 2k and 2k + 1. A search walks down from the root, so consecutive steps touch nearby memory, and the 16
+//  possible nodes 4 levels down (for 4 byte items) share one cache line, which gets prefetched 4 levels early.
+//  Costs a copy of the array. For read-mostly sorted tables too big for cache, where a plain binary search takes
+//  a cache miss on almost every step.
+//
+//  usage:
+//      Eytzinger<u32> table = eytzinger_create(memory, slice_create(sorted_keys, count));
+//      u32* found = eytzinger_lower_bound(table, key, u32_compare);
+//      ...
+//      eytzinger_destroy(&table);
+
+namespace SORT
+{
+static constexpr int EYTZINGER_ALIGNMENT = 64;
+}
+
+template <class T>
+struct Eytzinger
+{
+    T* items;           // 1-based. items[0] is padding, so the children of any node start on a cache line.
+    int count;
+    Memory_Region memory;
+};
+
+namespace SORT
+{
+
+template <class T>
+function int
+eytzinger_fill(Eytzinger<T>* eytzinger, T const* sorted, int sorted_index, int k)
+{
+    if (k <= eytzinger->count)
+    {
+        sorted_index = eytzinger_fill(eytzinger, sorted, sorted_index, 2 * k);
+        eytzinger->items[k] = sorted[sorted_index++];
+        sorted_index = eytzinger_fill(eytzinger, sorted, sorted_index, 2 * k + 1);
+    }
+
+    return sorted_index;
+}
+
+} // namespace SORT
+
+template <class T>
+function Eytzinger<T>
+eytzinger_create(Memory_Region memory, Slice<T> sorted)
+{
+    Eytzinger<T> result = {};
+    result.count = sorted.count;
+    result.memory = memory;
+    result.items = (T*)allocate_tracked(memory, (sorted.count + 1) * sizeof(T), SORT::EYTZINGER_ALIGNMENT);
+    SORT::eytzinger_fill(&result, sorted.items, 0, 1);
+    return result;
+}
+
+template <class T>
+function void
+eytzinger_destroy(Eytzinger<T>* eytzinger)
+{
+    free_tracked_allocation(eytzinger->memory, eytzinger->items);
+    *eytzinger = {};
 }
 
+// The first item that isn't less than item, or nullptr if there isn't one
+template <class T, class FN_COMPARATOR>
+function T*
+eytzinger_lower_bound(Eytzinger<T> const& eytzinger, T const& item, FN_COMPARATOR compare)
+{
+    // Nodes per cache line. The descendants of k that many nodes wide start at k * stride.
+    static constexpr int PREFETCH_STRIDE =
+        ((int)sizeof(T) >= SORT::EYTZINGER_ALIGNMENT) ? 1 : SORT::EYTZINGER_ALIGNMENT / (int)sizeof(T);
+
+    u32 k = 1;
+    while (k <= (u32)eytzinger.count)
+    {
+        _mm_prefetch((char const*)(eytzinger.items + (uintptr)k * PREFETCH_STRIDE), _MM_HINT_T0);
+        k = 2 * k + ((compare(eytzinger.items[k], item) < 0) ? 1 : 0);
+    }
+
+    // Each right turn appended a 1 bit. Undo the right turns after the last left turn, which was at the answer.
+    int left_turn_index = 0;
+    bitscan_lsb_index(~k, &left_turn_index);
+    k >>= left_turn_index + 1;
+
+    T* result = (k > 0) ? eytzinger.items + k : nullptr;
+    return result;
+}
 template <class T, class FN_COMPARATOR>
 void BubbleSort(Slice<T> slice, FN_COMPARATOR compare)
 {
@@ -198,3 +406,1051 @@ BubbleSortByPtr(T* items, int count, FN_COMPARATOR compare)
 {
     BubbleSortByPtr(slice_create(items, count), compare);
 }
+
+
+
+// --- Pattern-defeating quicksort (pdqsort, after Orson Peters)
+//  O(n log n) worst case, not stable. Takes the same comparators as BubbleSort.
+//  - Introsort: quicksort with a median-of-3 pivot (ninther for big ranges), insertion sort for small ranges,
+//    and heapsort if too many partitions come out badly unbalanced.
+//  - A partition that didn't need to swap anything is probably already sorted, so it gets a bounded
+//    insertion sort, which finishes sorted and nearly-sorted input in O(n).
+//  - Unbalanced partitions shuffle a few items around, to break up patterns that fool the pivot choice.
+//  - Ranges whose pivot equals the item before them hold only copies of it on the left, so those go in one
+//    partition, which makes few-unique input O(n k).
+
+namespace SORT
+{
+
+static constexpr int INSERTION_SORT_COUNT = 24;
+static constexpr int NINTHER_COUNT = 128;
+static constexpr int PARTIAL_INSERTION_SORT_LIMIT = 8;     // Moves allowed before giving up on "nearly sorted"
+
+// Comparator adapters, so one implementation serves every overload
+
+template <class T, class FN_COMPARATOR>
+struct Less
+{
+    FN_COMPARATOR compare;
+    bool operator()(T const& lhs, T const& rhs) const { return compare(lhs, rhs) < 0; }
+};
+
+template <class T, class FN_COMPARATOR, class CONTEXT>
+struct Less_Context
+{
+    FN_COMPARATOR compare;
+    CONTEXT const* context;
+    bool operator()(T const& lhs, T const& rhs) const { return compare(*context, lhs, rhs) < 0; }
+};
+
+template <class T, class FN_COMPARATOR>
+struct Less_By_Ptr
+{
+    FN_COMPARATOR compare;
+    bool operator()(T const& lhs, T const& rhs) const { return compare(&lhs, &rhs) < 0; }
+};
+
+// Sorts items in place, by moving them
+template <class T, class LESS>
+struct Item_Ops
+{
+    T* items;
+    LESS less_items;
+
+    bool less(int i, int j) const { return less_items(items[i], items[j]); }
+    void swap(int i, int j) const { T temp = items[i]; items[i] = items[j]; items[j] = temp; }
+
+    // If !guarded, there's an item before begin that's <= everything in the range, to stop the search
+    void insertion_sort(int begin, int end, bool guarded) const
+    {
+        for (int i = begin + 1; i < end; i++)
+        {
+            if (!less_items(items[i], items[i - 1]))
+                continue;
+
+            T temp = items[i];
+            int hole = i;
+            do
+            {
+                items[hole] = items[hole - 1];
+                hole--;
+            } while ((!guarded || hole > begin) && less_items(temp, items[hole - 1]));
+
+            items[hole] = temp;
+        }
+    }
+
+    // Gives up, leaving the range partly sorted, after moving too many items
+    bool partial_insertion_sort(int begin, int end) const
+    {
+        int move_count = 0;
+        for (int i = begin + 1; i < end; i++)
+        {
+            if (!less_items(items[i], items[i - 1]))
+                continue;
+
+            T temp = items[i];
+            int hole = i;
+            do
+            {
+                items[hole] = items[hole - 1];
+                hole--;
+            } while (hole > begin && less_items(temp, items[hole - 1]));
+
+            items[hole] = temp;
+
+            move_count += i - hole;
+            if (move_count > PARTIAL_INSERTION_SORT_LIMIT)
+                return false;
+        }
+
+        return true;
+    }
+};
+
+// Sorts with a user-provided swap, so the context can sort parallel arrays. Only ever swaps.
+template <class T, class FN_COMPARATOR, class FN_SWAP, class CONTEXT>
+struct Swap_Ops
+{
+    T* items;
+    FN_COMPARATOR compare;
+    FN_SWAP swap_items;
+    CONTEXT const* context;
+
+    bool less(int i, int j) const { return compare(*context, items[i], items[j]) < 0; }
+    void swap(int i, int j) const { swap_items(*context, i, j); }
+
+    void insertion_sort(int begin, int end, bool guarded) const
+    {
+        for (int i = begin + 1; i < end; i++)
+        {
+            for (int j = i; j > begin && less(j, j - 1); j--)
+            {
+                swap(j, j - 1);
+            }
+        }
+    }
+
+    bool partial_insertion_sort(int begin, int end) const
+    {
+        int move_count = 0;
+        for (int i = begin + 1; i < end; i++)
+        {
+            int j = i;
+            for (; j > begin && less(j, j - 1); j--)
+            {
+                swap(j, j - 1);
+            }
+
+            move_count += i - j;
+            if (move_count > PARTIAL_INSERTION_SORT_LIMIT)
+                return false;
+        }
+
+        return true;
+    }
+};
+
+template <class OPS>
+function void
+sort3(OPS const& ops, int a, int b, int c)
+{
+    if (ops.less(b, a)) ops.swap(a, b);
+    if (ops.less(c, b)) ops.swap(b, c);
+    if (ops.less(b, a)) ops.swap(a, b);
+}
+
+template <class OPS>
+function void
+sift_down(OPS const& ops, int begin, int root, int heap_count)
+{
+    while (true)
+    {
+        int child = 2 * root + 1;
+        if (child >= heap_count)
+            break;
+
+        if (child + 1 < heap_count && ops.less(begin + child, begin + child + 1))
+        {
+            child++;
+        }
+
+        if (!ops.less(begin + root, begin + child))
+            break;
+
+        ops.swap(begin + root, begin + child);
+        root = child;
+    }
+}
+
+template <class OPS>
+function void
+heap_sort(OPS const& ops, int begin, int end)
+{
+    int count = end - begin;
+    for (int i = count / 2 - 1; i >= 0; i--)
+    {
+        sift_down(ops, begin, i, count);
+    }
+
+    for (int i = count - 1; i > 0; i--)
+    {
+        ops.swap(begin, begin + i);
+        sift_down(ops, begin, 0, i);
+    }
+}
+
+// Partitions around the pivot at begin into [< pivot] pivot [>= pivot]. Returns the pivot's new index.
+//  Relies on some item in the range being >= the pivot, which pivot selection guarantees.
+template <class OPS>
+function int
+partition_right(OPS const& ops, int begin, int end, bool* already_partitioned)
+{
+    int first = begin;
+    int last = end;
+
+    while (ops.less(++first, begin));
+
+    // No item before first was swapped, so guard the search from the right
+    if (first - 1 == begin)
+    {
+        while (first < last && !ops.less(--last, begin));
+    }
+    else
+    {
+        while (!ops.less(--last, begin));
+    }
+
+    *already_partitioned = (first >= last);
+
+    while (first < last)
+    {
+        ops.swap(first, last);
+        while (ops.less(++first, begin));
+        while (!ops.less(--last, begin));
+    }
+
+    int pivot = first - 1;
+    ops.swap(begin, pivot);
+    return pivot;
+}
+
+// Partitions around the pivot at begin into [== pivot] pivot [> pivot]. Used when the item before the range is
+//  equal to the pivot, so nothing in the range is less than it.
+template <class OPS>
+function int
+partition_left(OPS const& ops, int begin, int end)
+{
+    int first = begin;
+    int last = end;
+
+    while (ops.less(begin, --last));
+
+    if (last + 1 == end)
+    {
+        while (first < last && !ops.less(begin, ++first));
+    }
+    else
+    {
+        while (!ops.less(begin, ++first));
+    }
+
+    while (first < last)
+    {
+        ops.swap(first, last);
+        while (ops.less(begin, --last));
+        while (!ops.less(begin, ++first));
+    }
+
+    int pivot = last;
+    ops.swap(begin, pivot);
+    return pivot;
+}
+
+template <class OPS>
+function void
+pdq_sort(OPS const& ops, int begin, int end, int bad_allowed, bool leftmost)
+{
+    while (true)
+    {
+        int count = end - begin;
+        if (count < INSERTION_SORT_COUNT)
+        {
+            ops.insertion_sort(begin, end, leftmost);
+            return;
+        }
+
+        // Median of 3 (or ninther) goes to begin
+        int half = count / 2;
+        if (count > NINTHER_COUNT)
+        {
+            sort3(ops, begin, begin + half, end - 1);
+            sort3(ops, begin + 1, begin + half - 1, end - 2);
+            sort3(ops, begin + 2, begin + half + 1, end - 3);
+            sort3(ops, begin + half - 1, begin + half, begin + half + 1);
+            ops.swap(begin, begin + half);
+        }
+        else
+        {
+            sort3(ops, begin + half, begin, end - 1);
+        }
+
+        if (!leftmost && !ops.less(begin - 1, begin))
+        {
+            begin = partition_left(ops, begin, end) + 1;
+            continue;
+        }
+
+        bool already_partitioned;
+        int pivot = partition_right(ops, begin, end, &already_partitioned);
+
+        int left_count = pivot - begin;
+        int right_count = end - (pivot + 1);
+        bool highly_unbalanced = (left_count < count / 8 || right_count < count / 8);
+        if (highly_unbalanced)
+        {
+            bad_allowed--;
+            if (bad_allowed == 0)
+            {
+                heap_sort(ops, begin, end);
+                return;
+            }
+
+            if (left_count >= INSERTION_SORT_COUNT)
+            {
+                int quarter = left_count / 4;
+                ops.swap(begin, begin + quarter);
+                ops.swap(pivot - 1, pivot - quarter);
+                if (left_count > NINTHER_COUNT)
+                {
+                    ops.swap(begin + 1, begin + quarter + 1);
+                    ops.swap(begin + 2, begin + quarter + 2);
+                    ops.swap(pivot - 2, pivot - quarter - 1);
+                    ops.swap(pivot - 3, pivot - quarter - 2);
+                }
+            }
+
+            if (right_count >= INSERTION_SORT_COUNT)
+            {
+                int quarter = right_count / 4;
+                ops.swap(pivot + 1, pivot + 1 + quarter);
+                ops.swap(end - 1, end - quarter);
+                if (right_count > NINTHER_COUNT)
+                {
+                    ops.swap(pivot + 2, pivot + 2 + quarter);
+                    ops.swap(pivot + 3, pivot + 3 + quarter);
+                    ops.swap(end - 2, end - 1 - quarter);
+                    ops.swap(end - 3, end - 2 - quarter);
+                }
+            }
+        }
+        else if (already_partitioned &&
+                 ops.partial_insertion_sort(begin, pivot) &&
+                 ops.partial_insertion_sort(pivot + 1, end))
+        {
+            return;
+        }
+
+        // Recurse on the left, loop on the right
+        pdq_sort(ops, begin, pivot, bad_allowed, leftmost);
+        begin = pivot + 1;
+        leftmost = false;
+    }
+}
+
+template <class OPS>
+function void
+pdq_sort(OPS const& ops, int count)
+{
+    if (count < 2)
+        return;
+
+    int log2_count = 0;
+    bitscan_msb_index((u32)count, &log2_count);
+    pdq_sort(ops, 0, count, log2_count + 1, true);
+}
+
+} // namespace SORT
+
+template <class T, class FN_COMPARATOR>
+function void
+PdqSort(Slice<T> slice, FN_COMPARATOR compare)
+{
+    using Less = SORT::Less<T, FN_COMPARATOR>;
+    SORT::Item_Ops<T, Less> ops = { slice.items, Less{ compare } };
+    SORT::pdq_sort(ops, slice.count);
+}
+
+template <class T, class FN_COMPARATOR, class CONTEXT>
+function void
+PdqSort(Slice<T> slice, FN_COMPARATOR compare, CONTEXT const& context)
+{
+    using Less = SORT::Less_Context<T, FN_COMPARATOR, CONTEXT>;
+    SORT::Item_Ops<T, Less> ops = { slice.items, Less{ compare, &context } };
+    SORT::pdq_sort(ops, slice.count);
+}
+
+// User-provided swap function, so the context can sort parallel arrays in 1 sort call
+template <class T, class FN_COMPARATOR, class CONTEXT, class FN_SWAP>
+function void
+PdqSort(Slice<T> slice, FN_COMPARATOR compare, FN_SWAP swap, CONTEXT const& context)
+{
+    SORT::Swap_Ops<T, FN_COMPARATOR, FN_SWAP, CONTEXT> ops = { slice.items, compare, swap, &context };
+    SORT::pdq_sort(ops, slice.count);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+PdqSort(DynArray<T>* array, FN_COMPARATOR compare)
+{
+    PdqSort(slice_create(*array), compare);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+PdqSort(T* items, int count, FN_COMPARATOR compare)
+{
+    PdqSort(slice_create(items, count), compare);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+PdqSortByPtr(Slice<T> slice, FN_COMPARATOR compare)
+{
+    using Less = SORT::Less_By_Ptr<T, FN_COMPARATOR>;
+    SORT::Item_Ops<T, Less> ops = { slice.items, Less{ compare } };
+    SORT::pdq_sort(ops, slice.count);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+PdqSortByPtr(DynArray<T>* array, FN_COMPARATOR compare)
+{
+    PdqSortByPtr(slice_create(*array), compare);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+PdqSortByPtr(T* items, int count, FN_COMPARATOR compare)
+{
+    PdqSortByPtr(slice_create(items, count), compare);
+}
+
+
+
+// --- LSD radix sort
+//  Sorts by an unsigned integer key, 8 bits per pass, least significant first. Stable. O(n) per pass, with a
+//  scratch buffer the size of the input. One pass over the input counts every digit up front, and digits
+//  that are the same for every key are skipped, so e.g. small u64 keys only pay for their low bytes.
+//
+//  radix_key(..) maps signed and floating point values to unsigned keys that sort in the same order. Use it
+//  in key extractors, e.g. RadixSort(slice, [](Foo const& foo) { return radix_key(foo.depth); })
+
+inline u32 radix_key(u32 value) { return value; }
+inline u64 radix_key(u64 value) { return value; }
+inline u32 radix_key(i32 value) { return (u32)value ^ 0x80000000u; }
+inline u64 radix_key(i64 value) { return (u64)value ^ 0x8000000000000000ull; }
+
+// Negative floats have their order reversed, so flip all their bits. Positive floats just need to go after.
+//  NaNs sort before -inf or after +inf, depending on their sign bit.
+inline u32
+radix_key(f32 value)
+{
+    u32 bits;
+    mem_copy(&bits, &value, sizeof(bits));
+    u32 mask = (bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+    return bits ^ mask;
+}
+
+inline u64
+radix_key(f64 value)
+{
+    u64 bits;
+    mem_copy(&bits, &value, sizeof(bits));
+    u64 mask = (bits & 0x8000000000000000ull) ? 0xFFFFFFFFFFFFFFFFull : 0x8000000000000000ull;
+    return bits ^ mask;
+}
+
+namespace SORT
+{
+
+static constexpr int RADIX_MIN_COUNT = 128;     // Below this, counting digits costs more than an insertion sort
+
+template <class T>
+struct Radix_Key_Identity
+{
+    auto operator()(T const& value) const { return radix_key(value); }
+};
+
+template <class T, class FN_KEY>
+struct Less_Key
+{
+    FN_KEY key;
+    bool operator()(T const& lhs, T const& rhs) const { return key(lhs) < key(rhs); }
+};
+
+template <class T, class FN_KEY>
+function void
+radix_sort(Slice<T> slice, FN_KEY key)
+{
+    using Key = decltype(key(slice.items[0]));
+    static constexpr int DIGIT_COUNT = sizeof(Key);
+    STATIC_ASSERT(DIGIT_COUNT == 4 || DIGIT_COUNT == 8);
+
+    int count = slice.count;
+    if (count < RADIX_MIN_COUNT)
+    {
+        // Insertion sort is stable too
+        Item_Ops<T, Less_Key<T, FN_KEY>> ops = { slice.items, Less_Key<T, FN_KEY>{ key } };
+        ops.insertion_sort(0, count, true);
+        return;
+    }
+
+    u32 histograms[DIGIT_COUNT][256] = {};
+    for (int i = 0; i < count; i++)
+    {
+        Key k = key(slice.items[i]);
+        for (int digit = 0; digit < DIGIT_COUNT; digit++)
+        {
+            histograms[digit][(k >> (8 * digit)) & 0xFF]++;
+        }
+    }
+
+    Scratch scratch = scratch_begin(count * sizeof(T) + alignof(T));
+    T* src = slice.items;
+    T* dst = allocate_array<T>(scratch.memory, count, alignof(T));
+
+    Key first_key = key(slice.items[0]);
+    for (int digit = 0; digit < DIGIT_COUNT; digit++)
+    {
+        int shift = 8 * digit;
+        u32* histogram = histograms[digit];
+
+        // Every key has the same digit, so this pass wouldn't move anything
+        if (histogram[(first_key >> shift) & 0xFF] == (u32)count)
+            continue;
+
+        u32 offsets[256];
+        u32 offset = 0;
+        for (int i = 0; i < 256; i++)
+        {
+            offsets[i] = offset;
+            offset += histogram[i];
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            dst[offsets[(key(src[i]) >> shift) & 0xFF]++] = src[i];
+        }
+
+        T* temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != slice.items)
+    {
+        mem_copy(slice.items, src, count * sizeof(T));
+    }
+
+    scratch_end(scratch);
+}
+
+} // namespace SORT
+
+// FN_KEY maps an item to a u32 or u64 key. See radix_key(..).
+template <class T, class FN_KEY>
+function void
+RadixSort(Slice<T> slice, FN_KEY key)
+{
+    SORT::radix_sort(slice, key);
+}
+
+function void RadixSort(Slice<u32> slice) { SORT::radix_sort(slice, SORT::Radix_Key_Identity<u32>{}); }
+function void RadixSort(Slice<u64> slice) { SORT::radix_sort(slice, SORT::Radix_Key_Identity<u64>{}); }
+function void RadixSort(Slice<i32> slice) { SORT::radix_sort(slice, SORT::Radix_Key_Identity<i32>{}); }
+function void RadixSort(Slice<i64> slice) { SORT::radix_sort(slice, SORT::Radix_Key_Identity<i64>{}); }
+function void RadixSort(Slice<f32> slice) { SORT::radix_sort(slice, SORT::Radix_Key_Identity<f32>{}); }
+function void RadixSort(Slice<f64> slice) { SORT::radix_sort(slice, SORT::Radix_Key_Identity<f64>{}); }
+
+template <class T>
+function void
+RadixSort(DynArray<T>* array)
+{
+    RadixSort(slice_create(*array));
+}
+
+
+
+// --- Parallel sort
+//  Sorts chunks on every thread of a Thread_Pool with PdqSort, then merges them pairwise. Each merge round
+//  splits its output into as many pieces as there are threads, and finds where each piece starts in the 2
+//  inputs with a binary search along the merge path, so the last rounds (1 or 2 big merges) still use every
+//  thread. Needs a scratch buffer the size of the input. Not stable. Items are copied as bytes.
+//
+//  Inputs below PARALLEL_MIN_COUNT, or a pool with no workers, just get PdqSort on the calling thread.
+
+namespace SORT
+{
+
+static constexpr int PARALLEL_MIN_COUNT = 64 * 1024;
+static constexpr int PARALLEL_CHUNK_COUNT_MIN = 16 * 1024;     // Items per chunk, so merging doesn't dominate
+static constexpr int PARALLEL_PIECES_PER_THREAD = 2;           // Slack, so one slow piece doesn't idle everyone
+
+template <class T, class FN_COMPARATOR>
+struct Parallel_Sort
+{
+    T* items;
+    T* buffer;
+    int count;
+    int chunk_count;            // Power of 2
+    FN_COMPARATOR compare;
+
+    int run_count;              // Items per sorted run: a chunk, then doubling each merge round. The last run can be short.
+
+    // Current merge round
+    T* src;
+    T* dst;
+    int pieces_per_merge;
+};
+
+template <class T, class FN_COMPARATOR>
+function void
+parallel_sort_chunk(void* data, int task_index)
+{
+    auto* sort = (Parallel_Sort<T, FN_COMPARATOR>*)data;
+
+    int begin = task_index * sort->run_count;
+    int end = min(begin + sort->run_count, sort->count);
+    PdqSort(sort->items + begin, end - begin, sort->compare);
+}
+
+// Number of items from a that go in the first output_index items of merge(a, b), taking from a on ties
+template <class T, class FN_COMPARATOR>
+function int
+merge_path_split(T const* a, int a_count, T const* b, int b_count, int output_index, FN_COMPARATOR const& compare)
+{
+    int low = max(0, output_index - b_count);
+    int high = min(output_index, a_count);
+    while (low < high)
+    {
+        int a_index = (low + high) / 2;
+        int b_index = output_index - a_index - 1;
+        if (compare(b[b_index], a[a_index]) < 0)
+        {
+            high = a_index;
+        }
+        else
+        {
+            low = a_index + 1;
+        }
+    }
+
+    return low;
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+parallel_sort_merge_piece(void* data, int task_index)
+{
+    auto* sort = (Parallel_Sort<T, FN_COMPARATOR>*)data;
+
+    int merge_index = task_index / sort->pieces_per_merge;
+    int piece_index = task_index % sort->pieces_per_merge;
+
+    int begin = merge_index * 2 * sort->run_count;
+    int middle = min(begin + sort->run_count, sort->count);
+    int end = min(middle + sort->run_count, sort->count);
+
+    T const* a = sort->src + begin;
+    T const* b = sort->src + middle;
+    int a_count = middle - begin;
+    int b_count = end - middle;
+    int merged_count = end - begin;
+
+    int output_begin = (int)((i64)merged_count * piece_index / sort->pieces_per_merge);
+    int output_end = (int)((i64)merged_count * (piece_index + 1) / sort->pieces_per_merge);
+
+    int a_begin = merge_path_split(a, a_count, b, b_count, output_begin, sort->compare);
+    int a_end = merge_path_split(a, a_count, b, b_count, output_end, sort->compare);
+    int b_begin = output_begin - a_begin;
+    int b_end = output_end - a_end;
+
+    T* out = sort->dst + begin + output_begin;
+    while (a_begin < a_end && b_begin < b_end)
+    {
+        if (sort->compare(b[b_begin], a[a_begin]) < 0)
+        {
+            *out++ = b[b_begin++];
+        }
+        else
+        {
+            *out++ = a[a_begin++];
+        }
+    }
+
+    mem_copy(out, a + a_begin, (a_end - a_begin) * sizeof(T));
+    out += a_end - a_begin;
+    mem_copy(out, b + b_begin, (b_end - b_begin) * sizeof(T));
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+parallel_sort_copy_back(void* data, int task_index)
+{
+    auto* sort = (Parallel_Sort<T, FN_COMPARATOR>*)data;
+
+    int begin = task_index * sort->run_count;
+    int end = min(begin + sort->run_count, sort->count);
+    mem_copy(sort->items + begin, sort->buffer + begin, (end - begin) * sizeof(T));
+}
+
+} // namespace SORT
+
+template <class T, class FN_COMPARATOR>
+function void
+ParallelSort(Slice<T> slice, FN_COMPARATOR compare, Thread_Pool* pool)
+{
+    using namespace SORT;
+    using Sort = Parallel_Sort<T, FN_COMPARATOR>;
+
+    int thread_count = thread_pool_thread_count(pool);
+    if (slice.count < PARALLEL_MIN_COUNT || thread_count == 1)
+    {
+        PdqSort(slice, compare);
+        return;
+    }
+
+    Scratch scratch = scratch_begin(slice.count * sizeof(T) + alignof(T));
+
+    Sort sort = {};
+    sort.items = slice.items;
+    sort.buffer = allocate_array<T>(scratch.memory, slice.count, alignof(T));
+    sort.count = slice.count;
+    sort.compare = compare;
+
+    // A power of 2 so every merge round pairs up evenly, but no more chunks than threads (rounded up)
+    sort.chunk_count = (int)u32_ceil_power_of_2((u32)thread_count);
+    while (sort.chunk_count > 1 && sort.count / sort.chunk_count < PARALLEL_CHUNK_COUNT_MIN)
+    {
+        sort.chunk_count /= 2;
+    }
+
+    sort.run_count = (sort.count + sort.chunk_count - 1) / sort.chunk_count;
+    thread_pool_run(pool, sort.chunk_count, parallel_sort_chunk<T, FN_COMPARATOR>, &sort);
+
+    sort.src = sort.items;
+    sort.dst = sort.buffer;
+    for (int merge_count = sort.chunk_count / 2; merge_count >= 1; merge_count /= 2)
+    {
+        sort.pieces_per_merge = max(1, PARALLEL_PIECES_PER_THREAD * thread_count / merge_count);
+        thread_pool_run(pool, merge_count * sort.pieces_per_merge, parallel_sort_merge_piece<T, FN_COMPARATOR>, &sort);
+
+        T* temp = sort.src;
+        sort.src = sort.dst;
+        sort.dst = temp;
+        sort.run_count *= 2;
+    }
+
+    if (sort.src != sort.items)
+    {
+        sort.run_count = (sort.count + sort.chunk_count - 1) / sort.chunk_count;
+        thread_pool_run(pool, sort.chunk_count, parallel_sort_copy_back<T, FN_COMPARATOR>, &sort);
+    }
+
+    scratch_end(scratch);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+ParallelSort(DynArray<T>* array, FN_COMPARATOR compare, Thread_Pool* pool)
+{
+    ParallelSort(slice_create(*array), compare, pool);
+}
+
+
+
+// --- Stable merge sort
+//  O(n log n), stable. Sorts runs of MERGE_SORT_RUN_COUNT with insertion sort, then merges runs top-down.
+//  Merging copies the left run out to a buffer half the size of the input, and merges back into place. Runs
+//  that are already in order aren't merged, so sorted input is O(n). Items are copied as bytes.
+//
+//  The buffer comes from memory if one is passed, otherwise from the calling thread's scratch arena.
+
+namespace SORT
+{
+
+static constexpr int MERGE_SORT_RUN_COUNT = 32;
+
+template <class T, class LESS>
+function void
+merge_sort(T* items, int count, T* buffer, LESS const& less)
+{
+    if (count <= MERGE_SORT_RUN_COUNT)
+    {
+        Item_Ops<T, LESS> ops = { items, less };
+        ops.insertion_sort(0, count, true);
+        return;
+    }
+
+    int half = count / 2;
+    merge_sort(items, half, buffer, less);
+    merge_sort(items + half, count - half, buffer, less);
+
+    if (!less(items[half], items[half - 1]))
+        return;
+
+    mem_copy(buffer, items, half * sizeof(T));
+
+    T const* a = buffer;
+    T const* a_end = buffer + half;
+    T const* b = items + half;
+    T const* b_end = items + count;
+    T* out = items;
+
+    // Ties take from a, which came first
+    while (a < a_end && b < b_end)
+    {
+        if (less(*b, *a))
+        {
+            *out++ = *b++;
+        }
+        else
+        {
+            *out++ = *a++;
+        }
+    }
+
+    // Whatever's left of b is already in place
+    mem_copy(out, a, (a_end - a) * sizeof(T));
+}
+
+} // namespace SORT
+
+template <class T, class FN_COMPARATOR>
+function void
+MergeSort(Slice<T> slice, FN_COMPARATOR compare, Memory_Region memory)
+{
+    using Less = SORT::Less<T, FN_COMPARATOR>;
+
+    if (slice.count <= SORT::MERGE_SORT_RUN_COUNT)
+    {
+        SORT::merge_sort(slice.items, slice.count, (T*)nullptr, Less{ compare });
+        return;
+    }
+
+    T* buffer = (T*)allocate_tracked(memory, (slice.count / 2) * sizeof(T), alignof(T));
+    SORT::merge_sort(slice.items, slice.count, buffer, Less{ compare });
+    free_tracked_allocation(memory, buffer);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+MergeSort(Slice<T> slice, FN_COMPARATOR compare)
+{
+    using Less = SORT::Less<T, FN_COMPARATOR>;
+
+    if (slice.count <= SORT::MERGE_SORT_RUN_COUNT)
+    {
+        SORT::merge_sort(slice.items, slice.count, (T*)nullptr, Less{ compare });
+        return;
+    }
+
+    Scratch scratch = scratch_begin((slice.count / 2) * sizeof(T) + alignof(T));
+    T* buffer = allocate_array<T>(scratch.memory, slice.count / 2, alignof(T));
+    SORT::merge_sort(slice.items, slice.count, buffer, Less{ compare });
+    scratch_end(scratch);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+MergeSort(DynArray<T>* array, FN_COMPARATOR compare)
+{
+    MergeSort(slice_create(*array), compare);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+MergeSort(T* items, int count, FN_COMPARATOR compare)
+{
+    MergeSort(slice_create(items, count), compare);
+}
+
+
+
+// --- K-way merge
+//  Merges any number of sorted inputs with a loser tree: a tournament tree whose internal nodes remember the
+//  input that lost the match there. After the winner's input advances, only the matches on the path from its
+//  leaf to the root are replayed, against the stored losers: log2(k) compares per item, with no sibling to
+//  compare against first as a binary heap has, and no items moved around.
+//
+//  Ties go to the earlier input, so merging the sorted runs of a stable sort is stable.
+//
+//  usage:
+//      K_Way_Merge<Item, decltype(&item_compare)> merge = k_way_merge_create(memory, inputs, item_compare);
+//      while (Item* item = k_way_merge_next(&merge))
+//      {
+//          ...
+//      }
+//      k_way_merge_destroy(&merge);
+//
+//  Or MergeSorted(inputs, compare, &out) to stream everything into a DynArray or Push_Buffer.
+
+template <class T, class FN_COMPARATOR>
+struct K_Way_Merge
+{
+    int input_count;
+    int leaf_count;             // input_count rounded up to a power of 2. Leaves past input_count are empty.
+
+    T** heads;                  // Next item of each input, or nullptr once it's used up
+    T** ends;
+    int* losers;                // Internal node i holds the input that lost the match there. losers[0] is the winner.
+
+    FN_COMPARATOR compare;
+    Memory_Region memory;
+};
+
+namespace SORT
+{
+
+template <class T, class FN_COMPARATOR>
+function bool
+k_way_merge_beats(K_Way_Merge<T, FN_COMPARATOR> const& merge, int input_a, int input_b)
+{
+    T const* a = merge.heads[input_a];
+    T const* b = merge.heads[input_b];
+    if (!a)
+        return false;
+
+    if (!b)
+        return true;
+
+    int compare_result = merge.compare(*a, *b);
+    bool result = (compare_result < 0 || (compare_result == 0 && input_a < input_b));
+    return result;
+}
+
+// Plays the matches below node, and returns the winner
+template <class T, class FN_COMPARATOR>
+function int
+k_way_merge_build(K_Way_Merge<T, FN_COMPARATOR>* merge, int node)
+{
+    if (node >= merge->leaf_count)
+        return node - merge->leaf_count;
+
+    int left = k_way_merge_build(merge, 2 * node);
+    int right = k_way_merge_build(merge, 2 * node + 1);
+    if (k_way_merge_beats(*merge, left, right))
+    {
+        merge->losers[node] = right;
+        return left;
+    }
+
+    merge->losers[node] = left;
+    return right;
+}
+
+} // namespace SORT
+
+// Reads the inputs as it goes, so they must stay alive (and unchanged) until the merge is destroyed
+template <class T, class FN_COMPARATOR>
+function K_Way_Merge<T, FN_COMPARATOR>
+k_way_merge_create(Memory_Region memory, Slice<Slice<T>> inputs, FN_COMPARATOR compare)
+{
+    K_Way_Merge<T, FN_COMPARATOR> result = {};
+    result.input_count = inputs.count;
+    result.leaf_count = (int)u32_ceil_power_of_2((u32)max(inputs.count, 1));
+    result.compare = compare;
+    result.memory = memory;
+
+    uintptr byte_count = result.leaf_count * (2 * sizeof(T*) + sizeof(int));
+    result.heads = (T**)allocate_tracked(memory, byte_count, alignof(T*), CTZ::YES);
+    result.ends = result.heads + result.leaf_count;
+    result.losers = (int*)(result.ends + result.leaf_count);
+
+    for (int i = 0; i < inputs.count; i++)
+    {
+        if (inputs[i].count > 0)
+        {
+            result.heads[i] = inputs[i].items;
+            result.ends[i] = inputs[i].items + inputs[i].count;
+        }
+    }
+
+    result.losers[0] = SORT::k_way_merge_build(&result, 1);
+    return result;
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+k_way_merge_destroy(K_Way_Merge<T, FN_COMPARATOR>* merge)
+{
+    free_tracked_allocation(merge->memory, merge->heads);
+    *merge = {};
+}
+
+// The next item in sorted order, pointing into its input, or nullptr once every input is used up
+template <class T, class FN_COMPARATOR>
+function T*
+k_way_merge_next(K_Way_Merge<T, FN_COMPARATOR>* merge)
+{
+    int winner = merge->losers[0];
+    T* result = merge->heads[winner];
+    if (!result)
+        return nullptr;
+
+    merge->heads[winner] = (result + 1 < merge->ends[winner]) ? result + 1 : nullptr;
+
+    // Replay the winner's path, with its next item
+    for (int node = (winner + merge->leaf_count) / 2; node >= 1; node /= 2)
+    {
+        int loser = merge->losers[node];
+        if (SORT::k_way_merge_beats(*merge, loser, winner))
+        {
+            merge->losers[node] = winner;
+            winner = loser;
+        }
+    }
+
+    merge->losers[0] = winner;
+    return result;
+}
+
+// Appends every item of the sorted inputs to out, in sorted order
+template <class T, class FN_COMPARATOR>
+function void
+MergeSorted(Slice<Slice<T>> inputs, FN_COMPARATOR compare, DynArray<T>* out)
+{
+    int count = 0;
+    for (int i = 0; i < inputs.count; i++)
+    {
+        count += inputs[i].count;
+    }
+
+    EnsureCapacity(out, out->count + count);
+
+    Scratch scratch = scratch_begin();
+    K_Way_Merge<T, FN_COMPARATOR> merge = k_way_merge_create(scratch.memory, inputs, compare);
+    while (T* item = k_way_merge_next(&merge))
+    {
+        out->items[out->count++] = *item;
+    }
+
+    k_way_merge_destroy(&merge);
+    scratch_end(scratch);
+}
+
+template <class T, class FN_COMPARATOR>
+function void
+MergeSorted(Slice<Slice<T>> inputs, FN_COMPARATOR compare, Push_Buffer* out)
+{
+    Scratch scratch = scratch_begin();
+    K_Way_Merge<T, FN_COMPARATOR> merge = k_way_merge_create(scratch.memory, inputs, compare);
+    while (T* item = k_way_merge_next(&merge))
+    {
+        push_buffer_append(out, *item);
+    }
+
+    k_way_merge_destroy(&merge);
+    scratch_end(scratch);
+}
@@ -1,21 +1,33 @@
 function u32
 string_hash(String const& str)
 {
-    u32 result = StartHash(str.data, str.length);
+    u32 result = (u32)hash64(str.data, str.length);
     return result;
 }
 
+// All 64 bits, e.g. for Static_Dict
+function u64
+string_hash64(String const& str)
+{
+    u64 result = hash64(str.data, str.length);
+    return result;
+}
+
+// Agrees with string_eq_lowercase(..). ASCII only, like it.
 function u32
 string_hash_lowercase(String const& str)
 {
-    u32 result = StartHash();
-
-    // @Slow
-    for (int i = 0; i < str.length; i++)
-    {
-        // TODO - this isn't even forcing to lowercase? Uh... don't trust this code.
-        result = BuildHash((void*)(str.data + i), 1, result);
-    }
-
+    u32 result = (u32)hash64_lowercase(str.data, str.length);
     return result;
 }
+
+// Dict policies, for Dict<String, V, String_Hasher, String_Eq>
+struct String_Hasher
+{
+    static u32 hash(String const& key) { return string_hash(key); }
+};
+
+struct String_Eq
+{
+    static bool eq(String const& key0, String const& key1) { return string_eq(key0, key1); }
+};
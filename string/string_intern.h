@@ -0,0 +1,70 @@
+// --- String_Interner
+//  Maps strings to dense u32 ids (0, 1, 2, ... in the order they were first interned), and ids back to strings.
+//  Once a string is interned, its id stands in for it: compare with u32_eq, hash with u32_hash (or
+//  u32_identity, since ids are already dense), key Dicts with U32_Hasher / U32_Eq. The string is hashed and
+//  compared once, when it's interned, instead of on every lookup.
+//
+//  Interned bytes are copied into a Push_Buffer, so strings returned by string_interner_get(..) are stable
+//  for the lifetime of the interner, and the caller's string doesn't need to outlive the call.
+
+struct String_Interner
+{
+    Dict<String, u32, String_Hasher, String_Eq> ids;    // Keys point into bytes
+    DynArray<String> strings;                           // Indexed by id
+    Push_Buffer bytes;
+};
+
+function String_Interner
+string_interner_create(Memory_Region memory, i32 starting_capacity=64, int bytes_per_page=4096)
+{
+    String_Interner result = {};
+    result.ids = dict_create<String, u32, String_Hasher, String_Eq>(memory, starting_capacity);
+    result.strings = DynArray<String>(memory);
+    EnsureCapacity(&result.strings, starting_capacity);
+    result.bytes = Push_Buffer(memory, bytes_per_page);
+    return result;
+}
+
+function i32
+string_interner_count(String_Interner const& interner)
+{
+    i32 result = interner.strings.count;
+    return result;
+}
+
+// Returns the id of a string that was already interned. Doesn't intern it if it wasn't.
+function u32
+string_interner_find(String_Interner const& interner, String string, bool* success=nullptr)
+{
+    u32 result = dict_find(interner.ids, string, success);
+    return result;
+}
+
+function u32
+string_intern(String_Interner* interner, String string)
+{
+    if (u32* found = dict_find_ptr(interner->ids, string))
+        return *found;
+
+    u8* bytes = (u8*)push_buffer_append_new_bytes(&interner->bytes, string.length);
+    mem_copy(bytes, string.data, string.length);
+
+    String copy = string_create(bytes, string.length);
+    u32 result = (u32)interner->strings.count;
+    Append(&interner->strings, copy);
+    dict_add_unchecked(&interner->ids, copy, result);
+    return result;
+}
+
+function String
+string_interner_get(String_Interner const& interner, u32 id)
+{
+    if (id >= (u32)interner.strings.count)
+    {
+        ASSERT_FALSE_WARN;
+        return {};
+    }
+
+    String result = interner.strings[id];
+    return result;
+}
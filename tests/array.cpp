@@ -56,3 +56,577 @@ bool TestDynArray()
 
     AllTestsPass();
 }
+
+bool
+TestSlotMap()
+{
+    uint cBytes = KILOBYTES(64);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    Slot_Map<int> map = Slot_Map<int>(memory);
+
+    Slot_Handle handles[10];
+    for (int i = 0; i < 10; i++)
+    {
+        handles[i] = slot_map_insert(&map, i);
+    }
+    DoTest(slot_map_count(map) == 10);
+    DoTest(*slot_map_get(map, handles[4]) == 4);
+
+    Slot_Handle nil = {};
+    DoTest(!slot_map_get(map, nil));
+
+    // Removing moves the last item into the hole. Its handle still works, the removed one doesn't.
+    DoTest(slot_map_remove(&map, handles[2]));
+    DoTest(!slot_map_remove(&map, handles[2]));
+    DoTest(!slot_map_contains(map, handles[2]));
+    DoTest(*slot_map_get(map, handles[9]) == 9);
+    DoTest(map.items[2] == 9);
+    DoTest(slot_map_handle_at(map, 2) == handles[9]);
+
+    // The freed slot is reused, but with a new generation, so the stale handle stays stale
+    Slot_Handle reused = slot_map_insert(&map, 100);
+    DoTest(reused.index == handles[2].index);
+    DoTest(reused != handles[2]);
+    DoTest(!slot_map_get(map, handles[2]));
+    DoTest(*slot_map_get(map, reused) == 100);
+
+    int sum = 0;
+    for (int value : map)
+    {
+        sum += value;
+    }
+    DoTest(sum == 45 - 2 + 100);
+
+    slot_map_clear(&map);
+    DoTest(slot_map_count(map) == 0);
+    DoTest(!slot_map_get(map, reused));
+    DoTest(!slot_map_get(map, handles[0]));
+
+    Slot_Handle handle = slot_map_insert(&map, 7);
+    DoTest(*slot_map_get(map, handle) == 7);
+
+    slot_map_clear(&map, true /* shouldFreeMemory */);
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+struct TestSortParallel
+{
+    int* keys;
+    int* values;
+};
+
+int
+TestSortParallelCompare(TestSortParallel const& context, int const& lhs, int const& rhs)
+{
+    return i32_compare(lhs, rhs);
+}
+
+void
+TestSortParallelSwap(TestSortParallel const& context, int i, int j)
+{
+    int key = context.keys[i];
+    context.keys[i] = context.keys[j];
+    context.keys[j] = key;
+
+    int value = context.values[i];
+    context.values[i] = context.values[j];
+    context.values[j] = value;
+}
+
+int
+TestSortDescending(int const* lhs, int const* rhs)
+{
+    return i32_compare(*rhs, *lhs);
+}
+
+struct TestSortItem
+{
+    u32 key;
+    int order;
+};
+
+u32
+TestSortItemKey(TestSortItem const& item)
+{
+    return item.key;
+}
+
+bool
+TestSort()
+{
+    int const cItem = 5000;
+    int* items = new int[cItem];
+    int* values = new int[cItem];
+
+    // Random, sorted, reversed, organ pipe, few unique. Bigger than the insertion sort cutoff, so partitioning
+    //  and pattern breaking both run.
+    for (int distribution = 0; distribution < 5; distribution++)
+    {
+        u32 rand = 1;
+        for (int i = 0; i < cItem; i++)
+        {
+            rand = rand * 1664525 + 1013904223;
+            switch (distribution)
+            {
+                case 0: items[i] = (int)(rand >> 8); break;
+                case 1: items[i] = i; break;
+                case 2: items[i] = cItem - i; break;
+                case 3: items[i] = (i < cItem / 2) ? i : cItem - i; break;
+                case 4: items[i] = (int)(rand >> 28); break;
+            }
+            values[i] = items[i];
+        }
+
+        PdqSort(items, cItem, i32_compare);
+        bool sorted = true;
+        for (int i = 1; i < cItem; i++)
+        {
+            sorted = sorted && items[i - 1] <= items[i];
+        }
+        DoTest(sorted);
+
+        RadixSort(slice_create(values, cItem));
+        bool same = true;
+        for (int i = 0; i < cItem; i++)
+        {
+            same = same && items[i] == values[i];
+        }
+        DoTest(same);
+
+        // No pool, so this is PdqSort on this thread. TestParallelSort runs it with workers.
+        ParallelSort(slice_create(values, cItem), i32_compare, nullptr);
+        DoTest(values[0] == items[0] && values[cItem - 1] == items[cItem - 1]);
+    }
+
+    // Sort 2 arrays together, by the keys
+    {
+        for (int i = 0; i < cItem; i++)
+        {
+            items[i] = (i * 7919) % cItem;
+            values[i] = -items[i];
+        }
+
+        TestSortParallel context = { items, values };
+        PdqSort(slice_create(items, cItem), TestSortParallelCompare, TestSortParallelSwap, context);
+
+        bool paired = true;
+        for (int i = 0; i < cItem; i++)
+        {
+            paired = paired && items[i] == i && values[i] == -i;
+        }
+        DoTest(paired);
+
+        PdqSortByPtr(items, cItem, TestSortDescending);
+        DoTest(items[0] == cItem - 1 && items[cItem - 1] == 0);
+    }
+
+    // Radix keys for signed ints and floats keep their order
+    {
+        i64 signeds[] = { 5, -1, I64::MAX, 0, I64::MIN, -300, 300 };
+        RadixSort(slice_create(signeds, ARRAY_LEN(signeds)));
+        DoTest(signeds[0] == I64::MIN && signeds[1] == -300 && signeds[2] == -1 && signeds[6] == I64::MAX);
+
+        f32 floats[] = { 2.5f, -0.5f, 0.0f, -100.0f, 1e30f, -1e-30f, 3.0f };
+        RadixSort(slice_create(floats, ARRAY_LEN(floats)));
+        DoTest(floats[0] == -100.0f && floats[1] == -0.5f && floats[2] == -1e-30f && floats[3] == 0.0f);
+        DoTest(floats[6] == 1e30f);
+    }
+
+    // Radix sort by key is stable
+    {
+        int const cSortItem = 1000;
+        TestSortItem* sortItems = new TestSortItem[cSortItem];
+        for (int i = 0; i < cSortItem; i++)
+        {
+            sortItems[i] = { (u32)((i * 31) % 10) << 20, i };
+        }
+
+        RadixSort(slice_create(sortItems, cSortItem), TestSortItemKey);
+
+        bool stable = true;
+        for (int i = 1; i < cSortItem; i++)
+        {
+            TestSortItem const& prev = sortItems[i - 1];
+            TestSortItem const& item = sortItems[i];
+            stable = stable && (prev.key < item.key || (prev.key == item.key && prev.order < item.order));
+        }
+        DoTest(stable);
+
+        delete[] sortItems;
+    }
+
+    delete[] items;
+    delete[] values;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestParallelSort()
+{
+    Thread_Pool* pool = thread_pool_create(nullptr, 7);
+    DoTest(thread_pool_thread_count(pool) == (THREAD::system_thread_create ? 8 : 1));
+
+    // Odd sizes, so the last chunk and run are short. 200001 items make 8 chunks, so 3 merge rounds, and
+    //  the result gets copied back from the buffer.
+    int const counts[] = { 65537, 100003, 200001 };
+    int const cItemMax = 200001;
+    int* items = new int[cItemMax];
+    int* expected = new int[cItemMax];
+
+    for (int cItem : counts)
+    {
+        // Random, sorted, reversed, few unique
+        for (int distribution = 0; distribution < 4; distribution++)
+        {
+            u32 rand = 1;
+            for (int i = 0; i < cItem; i++)
+            {
+                rand = rand * 1664525 + 1013904223;
+                switch (distribution)
+                {
+                    case 0: items[i] = (int)(rand >> 8); break;
+                    case 1: items[i] = i; break;
+                    case 2: items[i] = cItem - i; break;
+                    case 3: items[i] = (int)(rand >> 29); break;
+                }
+                expected[i] = items[i];
+            }
+
+            PdqSort(expected, cItem, i32_compare);
+            ParallelSort(slice_create(items, cItem), i32_compare, pool);
+
+            bool same = true;
+            for (int i = 0; i < cItem; i++)
+            {
+                same = same && items[i] == expected[i];
+            }
+            DoTest(same);
+        }
+    }
+
+    delete[] items;
+    delete[] expected;
+    thread_pool_destroy(pool);
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+int
+TestSortItemCompare(TestSortItem const& lhs, TestSortItem const& rhs)
+{
+    return u32_compare(lhs.key, rhs.key);
+}
+
+bool
+TestSortedSearch()
+{
+    uint cBytes = KILOBYTES(64);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    // Every size up to a few levels past a full tree, with runs of duplicates. Checked against a linear scan.
+    int const cItemMax = 300;
+    int sorted[cItemMax];
+    int queries[2 * cItemMax + 3];
+    int batchOut[2 * cItemMax + 3];
+    bool allMatch = true;
+    for (int cItem = 0; cItem <= cItemMax; cItem += (cItem < 40) ? 1 : 37)
+    {
+        for (int i = 0; i < cItem; i++)
+        {
+            sorted[i] = 2 * (i - i % 3);    // Even values, each 3 times
+        }
+
+        Slice<int> slice = slice_create(sorted, cItem);
+        Eytzinger<int> eytzinger = eytzinger_create(memory, slice);
+
+        int cQuery = 0;
+        for (int query = -1; query <= 2 * cItem + 1; query++)
+        {
+            queries[cQuery++] = query;
+        }
+
+        LowerBoundBatch(slice, slice_create(queries, cQuery), slice_create(batchOut, cQuery), i32_compare);
+
+        for (int iQuery = 0; iQuery < cQuery; iQuery++)
+        {
+            int query = queries[iQuery];
+
+            int lower = 0;
+            while (lower < cItem && sorted[lower] < query) lower++;
+            int upper = lower;
+            while (upper < cItem && sorted[upper] == query) upper++;
+
+            allMatch = allMatch && LowerBound(slice, query, i32_compare) == lower;
+            allMatch = allMatch && UpperBound(slice, query, i32_compare) == upper;
+            allMatch = allMatch && batchOut[iQuery] == lower;
+
+            Slice<int> equal = EqualRange(slice, query, i32_compare);
+            allMatch = allMatch && equal.items == sorted + lower && equal.count == upper - lower;
+
+            int index = BinarySearch(slice, query, i32_compare);
+            allMatch = allMatch && index == ((upper > lower) ? lower : ~lower);
+
+            int* found = eytzinger_lower_bound(eytzinger, query, i32_compare);
+            allMatch = allMatch && ((lower < cItem) ? (found && *found == sorted[lower]) : !found);
+        }
+
+        eytzinger_destroy(&eytzinger);
+    }
+    DoTest(allMatch);
+
+    // Ranged overload only looks between iLow and iHigh (inclusive)
+    {
+        int items[] = { 1, 3, 5, 7, 9 };
+        Slice<int> slice = slice_create(items, ARRAY_LEN(items));
+        DoTest(BinarySearch(slice, 7, 1, 3, i32_compare) == 3);
+        DoTest(BinarySearch(slice, 9, 1, 3, i32_compare) == ~4);
+        DoTest(BinarySearch(slice, 1, 1, 3, i32_compare) == ~1);
+    }
+
+    // Equal items stay in insertion order
+    {
+        DynArray<TestSortItem> array(memory);
+        for (int i = 0; i < 20; i++)
+        {
+            TestSortItem item = { (u32)(i % 4), i };
+            InsertSorted(&array, item, TestSortItemCompare);
+        }
+
+        bool stable = true;
+        for (int i = 1; i < array.count; i++)
+        {
+            stable = stable && (array[i - 1].key < array[i].key || array[i - 1].order < array[i].order);
+        }
+        DoTest(stable);
+
+        Clear(&array, true /* shouldFreeMemory */);
+    }
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestMergeSort()
+{
+    uint cBytes = KILOBYTES(256);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    // Few unique keys, so there are long runs of ties for stability to matter
+    int const cItem = 3000;
+    TestSortItem* items = new TestSortItem[cItem];
+    u32 rand = 1;
+    for (int i = 0; i < cItem; i++)
+    {
+        rand = rand * 1664525 + 1013904223;
+        items[i] = { rand >> 28, i };
+    }
+
+    MergeSort(items, cItem, TestSortItemCompare);
+
+    bool stable = true;
+    for (int i = 1; i < cItem; i++)
+    {
+        stable = stable && (items[i - 1].key < items[i].key || (items[i - 1].key == items[i].key && items[i - 1].order < items[i].order));
+    }
+    DoTest(stable);
+
+    // Buffer from a region instead of scratch. Already sorted, so nothing moves.
+    MergeSort(slice_create(items, cItem), TestSortItemCompare, memory);
+    DoTest(items[0].key == 0 && items[cItem - 1].key == 15);
+
+    // Merge runs that are each sorted, with ties across runs, and an empty run. Order numbers count up across
+    //  the runs, so a stable merge keeps them in order among equal keys.
+    {
+        int const cInput = 5;
+        int const inputCounts[cInput] = { 700, 0, 1, 1200, 1099 };
+        Slice<TestSortItem> inputs[cInput];
+
+        int iItem = 0;
+        for (int iInput = 0; iInput < cInput; iInput++)
+        {
+            inputs[iInput] = slice_create(items + iItem, inputCounts[iInput]);
+            for (int i = 0; i < inputCounts[iInput]; i++)
+            {
+                items[iItem + i] = { (u32)(i / 7), iItem + i };
+            }
+
+            iItem += inputCounts[iInput];
+        }
+
+        DynArray<TestSortItem> merged(memory);
+        Append(&merged, TestSortItem{ 0, -1 });     // Merging appends
+        MergeSorted(slice_create(inputs, cInput), TestSortItemCompare, &merged);
+        DoTest(merged.count == cItem + 1);
+        DoTest(merged[0].order == -1);
+
+        bool mergedStable = true;
+        for (int i = 2; i < merged.count; i++)
+        {
+            TestSortItem const& prev = merged[i - 1];
+            TestSortItem const& item = merged[i];
+            mergedStable = mergedStable && (prev.key < item.key || (prev.key == item.key && prev.order < item.order));
+        }
+        DoTest(mergedStable);
+
+        Push_Buffer pb = Push_Buffer(memory, KILOBYTES(4));
+        MergeSorted(slice_create(inputs, cInput), TestSortItemCompare, &pb);
+        DoTest(pb.lengthPushed == cItem * sizeof(TestSortItem));
+
+        Push_Slice_Reader reader = Push_Slice_Reader(&pb);
+        bool sameOrder = true;
+        for (int i = 1; i < merged.count; i++)
+        {
+            TestSortItem* item = push_buffer_read<TestSortItem>(&reader);
+            sameOrder = sameOrder && item->order == merged[i].order;
+        }
+        DoTest(sameOrder);
+
+        // Pulling items one at a time, from no inputs and from one
+        K_Way_Merge<TestSortItem, decltype(&TestSortItemCompare)> merge = k_way_merge_create(memory, slice_create(inputs, 0), TestSortItemCompare);
+        DoTest(!k_way_merge_next(&merge));
+        k_way_merge_destroy(&merge);
+
+        merge = k_way_merge_create(memory, slice_create(inputs + 2, 1), TestSortItemCompare);
+        DoTest(k_way_merge_next(&merge) == inputs[2].items);
+        DoTest(!k_way_merge_next(&merge));
+        k_way_merge_destroy(&merge);
+
+        Clear(&merged, true /* shouldFreeMemory */);
+    }
+
+    delete[] items;
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestPriorityQueue()
+{
+    uint cBytes = KILOBYTES(256);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    int const cItem = 1000;
+    int items[cItem];
+    u32 rand = 1;
+    for (int i = 0; i < cItem; i++)
+    {
+        rand = rand * 1664525 + 1013904223;
+        items[i] = (int)(rand >> 20);
+    }
+
+    int sorted[cItem];
+    mem_copy(sorted, items, sizeof(items));
+    PdqSort(sorted, cItem, i32_compare);
+
+    // Runtime comparator, binary heap, one insert at a time
+    {
+        Priority_Queue<int> queue = priority_queue_create<int>(memory, i32_compare);
+        for (int i = 0; i < cItem; i++)
+        {
+            priority_queue_insert(&queue, items[i]);
+        }
+
+        DoTest(priority_queue_count(queue) == cItem);
+        DoTest(*priority_queue_peek(queue) == sorted[0]);
+
+        bool inOrder = true;
+        for (int i = 0; i < cItem; i++)
+        {
+            inOrder = inOrder && priority_queue_pop(&queue) == sorted[i];
+        }
+        DoTest(inOrder);
+        DoTest(priority_queue_is_empty(queue));
+
+        priority_queue_clear(&queue, true /* shouldFreeMemory */);
+    }
+
+    // Compile-time comparator, 4-ary heap, built in bulk
+    {
+        using Queue = Priority_Queue<int, Priority_Queue_Compare<int, i32_compare>, 4>;
+        Queue queue = priority_queue_create<int, Priority_Queue_Compare<int, i32_compare>, 4>(memory);
+
+        priority_queue_heapify(&queue, slice_create(items, cItem / 2));
+        priority_queue_insert_bulk(&queue, slice_create(items + cItem / 2, 10));                    // Sifts each up
+        priority_queue_insert_bulk(&queue, slice_create(items + cItem / 2 + 10, cItem / 2 - 10));   // Rebuilds
+
+        bool inOrder = true;
+        for (int i = 0; i < cItem; i++)
+        {
+            inOrder = inOrder && priority_queue_pop(&queue) == sorted[i];
+        }
+        DoTest(inOrder);
+
+        priority_queue_clear(&queue, true /* shouldFreeMemory */);
+    }
+
+    // Indexed: decrease-key, increase-key, remove from the middle, stale handles
+    {
+        using Queue = Indexed_Priority_Queue<int, Priority_Queue_Compare<int, i32_compare>, 4>;
+        Queue queue = indexed_priority_queue_create<int, Priority_Queue_Compare<int, i32_compare>, 4>(memory);
+
+        Slot_Handle handles[cItem];
+        priority_queue_insert_bulk(&queue, slice_create(items, cItem), handles);
+
+        // Every item's priority goes up by its index, then every 3rd is removed
+        int expected[cItem];
+        int cExpected = 0;
+        for (int i = 0; i < cItem; i++)
+        {
+            DoTest(*priority_queue_get(queue, handles[i]) == items[i]);
+            DoTest(priority_queue_update(&queue, handles[i], items[i] - i));
+        }
+
+        for (int i = 0; i < cItem; i++)
+        {
+            if (i % 3 == 0)
+            {
+                DoTest(priority_queue_remove(&queue, handles[i]));
+                DoTest(!priority_queue_remove(&queue, handles[i]));
+                DoTest(!priority_queue_contains(queue, handles[i]));
+            }
+            else
+            {
+                expected[cExpected++] = items[i] - i;
+            }
+        }
+
+        PdqSort(expected, cExpected, i32_compare);
+        DoTest(priority_queue_count(queue) == cExpected);
+
+        // Reused handle slots get a new generation
+        Slot_Handle reused = priority_queue_insert(&queue, I32::MIN);
+        DoTest(reused.index == handles[cItem - 1 - (cItem - 1) % 3].index);
+        DoTest(reused != handles[cItem - 1 - (cItem - 1) % 3]);
+        DoTest(priority_queue_pop(&queue) == I32::MIN);
+        DoTest(!priority_queue_get(queue, reused));
+
+        bool inOrder = true;
+        for (int i = 0; i < cExpected; i++)
+        {
+            inOrder = inOrder && priority_queue_pop(&queue) == expected[i];
+        }
+        DoTest(inOrder);
+        DoTest(!priority_queue_get(queue, handles[1]));
+
+        Slot_Handle nil = {};
+        DoTest(!priority_queue_update(&queue, nil, 0));
+
+        priority_queue_clear(&queue, true /* shouldFreeMemory */);
+    }
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
@@ -0,0 +1,776 @@
+bool
+TestSwissDict()
+{
+    uint cBytes = MEGABYTES(1);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    // Identity hash, so keys that differ by a multiple of the capacity start probing at the same slot
+    Swiss_Dict<u32, u32> dict = swiss_dict_create<u32, u32>(memory, u32_identity, u32_eq);
+
+    int const cKey = 5000;
+    for (u32 key = 0; key < cKey; key++)
+    {
+        dict_set(&dict, key * 1024, key);
+    }
+    DoTest(dict.count == cKey);
+    DoTest(dict.count < dict.capacity);
+
+    for (u32 key = 0; key < cKey; key++)
+    {
+        u32 * value = dict_find_ptr(dict, key * 1024);
+        DoTest(value && *value == key);
+        DoTest(!dict_contains(dict, key * 1024 + 1));
+    }
+
+    // Overwrite, not add
+    dict_set(&dict, 0u, 77u);
+    DoTest(dict.count == cKey);
+    DoTest(dict_find(dict, 0u) == 77);
+
+    // Remove every other key, then churn. Tombstones must not grow the table forever.
+    for (u32 key = 0; key < cKey; key += 2)
+    {
+        DoTest(dict_remove(&dict, key * 1024));
+    }
+    DoTest(!dict_remove(&dict, 0u));
+    DoTest(dict.count == cKey / 2);
+
+    i32 capacity = dict.capacity;
+    for (int round = 0; round < 20; round++)
+    {
+        for (u32 key = 0; key < cKey; key += 2)
+        {
+            dict_set(&dict, key * 1024 + round + 1, key);
+        }
+        for (u32 key = 0; key < cKey; key += 2)
+        {
+            DoTest(dict_remove(&dict, key * 1024 + round + 1));
+        }
+    }
+    DoTest(dict.capacity == capacity);
+    DoTest(dict.count == cKey / 2);
+
+    u64 sum = 0;
+    int cIter = 0;
+    for (auto const& kvp : dict)
+    {
+        DoTest(kvp.key == kvp.value * 1024);
+        sum += kvp.value;
+        cIter++;
+    }
+    DoTest(cIter == cKey / 2);
+    DoTest(sum == (u64)(cKey / 2) * (cKey / 2));     // 1 + 3 + ... + 4999
+
+    dict_reset(&dict);
+    DoTest(dict.count == 0);
+    DoTest(!dict_contains(dict, 1024u));
+
+    // Keys that only differ in their high bits still spread over the groups
+    int const cKeyHigh = 4096;
+    for (u32 key = 0; key < cKeyHigh; key++)
+    {
+        dict_set(&dict, key << 20, key);
+    }
+    DoTest(dict.count == cKeyHigh);
+
+    int const cGroup = dict.capacity / SWISS::GROUP_WIDTH;
+    bool * isGroupUsed = new bool[cGroup];
+    for (int i = 0; i < cGroup; i++)
+    {
+        isGroupUsed[i] = false;
+    }
+
+    int cGroupUsed = 0;
+    for (u32 key = 0; key < cKeyHigh; key++)
+    {
+        DoTest(dict_find(dict, key << 20) == key);
+
+        u32 position = SWISS::hash_split(key << 20).h1 & (dict.capacity - 1);
+        u32 iGroup = position / SWISS::GROUP_WIDTH;
+        cGroupUsed += !isGroupUsed[iGroup];
+        isGroupUsed[iGroup] = true;
+    }
+    DoTest(cGroupUsed > cGroup / 2);
+    delete[] isGroupUsed;
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestRobinHoodDict()
+{
+    uint cBytes = MEGABYTES(1);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    Robin_Hood_Dict<u32, u32> dict = robin_hood_dict_create<u32, u32>(memory, u32_hash, u32_eq);
+
+    int const cKey = 4000;
+    for (u32 key = 0; key < cKey; key++)
+    {
+        dict_set(&dict, key, key * 3);
+    }
+    DoTest(dict.count == cKey);
+
+    for (u32 key = 0; key < cKey; key++)
+    {
+        DoTest(dict_find(dict, key) == key * 3);
+        DoTest(!dict_contains(dict, key + cKey));
+    }
+
+    // Churn: remove and re-add a sliding window of keys. Backward shift leaves no tombstones, so the table
+    //  doesn't grow and probe lengths stay short.
+    i32 capacity = dict.capacity;
+    for (u32 key = 0; key < cKey * 20; key++)
+    {
+        DoTest(dict_remove(&dict, key));
+        dict_set(&dict, key + cKey, (key + cKey) * 3);
+    }
+    DoTest(!dict_remove(&dict, 0u));
+    DoTest(dict.count == cKey);
+    DoTest(dict.capacity == capacity);
+
+    for (u32 key = cKey * 20; key < cKey * 21; key++)
+    {
+        DoTest(dict_find(dict, key) == key * 3);
+    }
+
+    Robin_Hood_Dict_Stats stats = robin_hood_dict_stats(dict);
+    DoTest(stats.count == cKey);
+    DoTest(stats.probe_length_mean >= 1.0f && stats.probe_length_mean < 4.0f);
+    DoTest(stats.probe_length_max < 32);
+
+    int cHistogram = 0;
+    for (int count : stats.probe_length_histogram)
+    {
+        cHistogram += count;
+    }
+    DoTest(cHistogram == cKey);
+
+    int cIter = 0;
+    for (auto const& kvp : dict)
+    {
+        DoTest(kvp.value == kvp.key * 3);
+        cIter++;
+    }
+    DoTest(cIter == cKey);
+
+    dict_reset(&dict);
+    DoTest(dict.count == 0);
+    DoTest(!dict_contains(dict, (u32)cKey * 20));
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestDictIncrementalResize()
+{
+    uint cBytes = MEGABYTES(1);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    Dict<u32, u32> dict = dict_create<u32, u32>(memory, u32_hash, u32_eq);
+    dict.resize_step_count = 4;
+
+    // Catch the dict mid-resize: items split across both tables
+    u32 key = 0;
+    while (!dict.old_items || dict.old_count < 20)
+    {
+        dict_set(&dict, key, key * 2);
+        key++;
+    }
+    DoTest(dict.old_items);
+    DoTest(dict.count == (i32)key);
+
+    for (u32 i = 0; i < key; i++)
+    {
+        DoTest(dict_find(dict, i) == i * 2);
+    }
+
+    // Iteration sees both tables
+    int cIter = 0;
+    for (auto const& kvp : dict)
+    {
+        DoTest(kvp.value == kvp.key * 2);
+        cIter++;
+    }
+    DoTest(cIter == (i32)key);
+
+    // Removing from either table, and overwriting, while the move is in progress
+    DoTest(dict_remove(&dict, 0u));
+    DoTest(!dict_contains(dict, 0u));
+    dict_set(&dict, 1u, 100u);
+    DoTest(dict_find(dict, 1u) == 100);
+
+    // Keep going until the move finishes and the old table is freed
+    while (dict.old_items)
+    {
+        dict_set(&dict, key, key * 2);
+        key++;
+    }
+    DoTest(dict.count == (i32)key - 1);
+    for (u32 i = 2; i < key; i++)
+    {
+        DoTest(dict_find(dict, i) == i * 2);
+    }
+
+    // Several resizes in a row, plus a reset in the middle of one
+    for (u32 i = 0; i < 5000; i++)
+    {
+        dict_set(&dict, i, i * 2);
+    }
+    DoTest(dict.count == 5000);
+    DoTest(dict_find(dict, 4999u) == 9998);
+
+    // While the next table is being cleared, the current one holds everything
+    for (key = 5000; !dict.next_items; key++)
+    {
+        dict_set(&dict, key, key * 2);
+    }
+    DoTest(dict.count == (i32)key);
+    DoTest(dict_find(dict, key - 1) == (key - 1) * 2);
+
+    dict_reset(&dict);
+    DoTest(dict.count == 0 && !dict.next_items && !dict.old_items);
+    DoTest(!dict_contains(dict, 10u));
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestDictPolicy()
+{
+    uint cBytes = MEGABYTES(1);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    {
+        Dict<u32, u32, U32_Hasher, U32_Eq> dict = dict_create<u32, u32, U32_Hasher, U32_Eq>(memory);
+        DoTest(!dict.key_hash && !dict.key_eq);
+
+        for (u32 key = 0; key < 1000; key++)
+        {
+            dict_set(&dict, key, key * 3);
+        }
+        DoTest(dict.count == 1000);
+        DoTest(dict_find(dict, 999u) == 2997);
+        DoTest(!dict_contains(dict, 1000u));
+
+        DoTest(dict_remove(&dict, 5u));
+        DoTest(!dict_contains(dict, 5u));
+
+        int cIter = 0;
+        for (auto const& kvp : dict)
+        {
+            DoTest(kvp.value == kvp.key * 3);
+            cIter++;
+        }
+        DoTest(cIter == 999);
+
+        dict_reset(&dict);
+        DoTest(dict.count == 0);
+    }
+
+    {
+        // Keys with equal contents at different addresses must match
+        Dict<String, int, String_Hasher, String_Eq> dict = dict_create<String, int, String_Hasher, String_Eq>(memory);
+        dict_set(&dict, STR("alpha"), 1);
+        dict_set(&dict, STR("beta"), 2);
+
+        char buffer_key[] = "alpha";
+        DoTest(dict_find(dict, String(buffer_key)) == 1);
+        DoTest(dict_find(dict, STR("beta")) == 2);
+        DoTest(!dict_contains(dict, STR("gamma")));
+    }
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestHash()
+{
+    // Enough bytes for every path: short, medium, and several scrambles' worth of stripes
+    int const cByteMax = 2200;
+    u8 * bytes = new u8[cByteMax + 16];
+    u8 * lower = new u8[cByteMax];
+    u8 * shifted = new u8[cByteMax + 1];
+    u32 rand = 1;
+    for (int i = 0; i < cByteMax + 16; i++)
+    {
+        rand = rand * 1664525 + 1013904223;
+        bytes[i] = (u8)(rand >> 24);
+    }
+
+    int const lengths[] = { 0, 1, 3, 4, 7, 8, 15, 16, 17, 48, 49, 100, 255, 256, 257, 1000, 1024 + 64, cByteMax };
+    for (int cByte : lengths)
+    {
+        u64 hash = hash64(bytes, cByte);
+
+        // Same bytes at a different alignment
+        mem_copy(shifted + 1, bytes, cByte);
+        DoTest(hash64(shifted + 1, cByte) == hash);
+
+        DoTest(hash64(bytes, cByte, 1) != hash);
+        DoTest(hash64(bytes, cByte + 1) != hash);
+
+        // Every bit matters
+        for (int iBit = 0; iBit < cByte * 8; iBit += 7)
+        {
+            bytes[iBit / 8] ^= (1 << (iBit % 8));
+            DoTest(hash64(bytes, cByte) != hash);
+            bytes[iBit / 8] ^= (1 << (iBit % 8));
+        }
+
+        // Case folding matches hashing the lowercased bytes. Bytes >= 0x80 aren't letters.
+        for (int i = 0; i < cByte; i++)
+        {
+            lower[i] = (u8)AsciiLowerCase((char)bytes[i]);
+        }
+        DoTest(hash64_lowercase(bytes, cByte) == hash64(lower, cByte));
+        DoTest(hash64_lowercase(lower, cByte) == hash64(lower, cByte));
+    }
+
+    DoTest(hash64_lowercase("\xC1", 1) != hash64_lowercase("\xE1", 1));
+    DoTest(hash64_lowercase("@[`{", 4) == hash64("@[`{", 4));
+
+    DoTest(string_hash_lowercase(STR("Content-Type")) == string_hash_lowercase(STR("content-type")));
+    DoTest(string_hash(STR("Content-Type")) != string_hash(STR("content-type")));
+
+    delete[] bytes;
+    delete[] lower;
+    delete[] shifted;
+    AllTestsPass();
+}
+
+bool
+TestDictFindBatch()
+{
+    uint cBytes = MEGABYTES(1);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    Dict<u32, u32> dict = dict_create<u32, u32>(memory, u32_hash, u32_eq);
+    dict.resize_step_count = 4;
+
+    // Even keys only. Stop partway through a resize, so some keys are still in the old table.
+    u32 cKey = 0;
+    while (cKey < 1000 || !dict.old_items)
+    {
+        dict_set(&dict, cKey * 2, cKey);
+        cKey++;
+    }
+
+    // More keys than one chunk, hits and misses mixed
+    int const cLookup = 100;
+    u32 keys[cLookup];
+    u32 * values[cLookup];
+    for (int i = 0; i < cLookup; i++)
+    {
+        keys[i] = (u32)i * 7;
+    }
+
+    int cFound = dict_find_batch(dict, slice_create(keys, cLookup), slice_create(values, cLookup));
+
+    int cFoundExpected = 0;
+    for (int i = 0; i < cLookup; i++)
+    {
+        DoTest(values[i] == dict_find_ptr(dict, keys[i]));
+        DoTest(!values[i] || *values[i] == keys[i] / 2);
+        cFoundExpected += (values[i]) ? 1 : 0;
+    }
+    DoTest(cFound == cFoundExpected);
+    DoTest(cFound == cLookup / 2);
+
+    DoTest(dict_find_batch(dict, slice_create(keys, 0), slice_create(values, 0)) == 0);
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestConcurrentDict()
+{
+    uint cBytes = MEGABYTES(4);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    auto * dict = concurrent_dict_create<u32, u32, U32_Hasher, U32_Eq>(memory);
+    Concurrent_Dict_Reader * reader = concurrent_dict_attach(dict);
+
+    // Grows several times
+    int const cKey = 5000;
+    for (u32 key = 0; key < cKey; key++)
+    {
+        concurrent_dict_set(dict, key, key * 2);
+    }
+    DoTest(concurrent_dict_count(dict) == cKey);
+
+    for (u32 key = 0; key < cKey; key++)
+    {
+        u32 value = 0;
+        DoTest(concurrent_dict_find(dict, reader, key, &value) && value == key * 2);
+    }
+    DoTest(!concurrent_dict_contains(dict, reader, (u32)cKey));
+
+    // Overwrite, not add
+    concurrent_dict_set(dict, 7u, 1u);
+    u32 value = 0;
+    DoTest(concurrent_dict_find(dict, reader, 7u, &value) && value == 1);
+    DoTest(concurrent_dict_count(dict) == cKey);
+
+    // Tombstones get dropped when the table is rebuilt, so churn doesn't grow it forever
+    for (u32 key = 0; key < cKey; key++)
+    {
+        DoTest(concurrent_dict_remove(dict, key));
+    }
+    DoTest(!concurrent_dict_remove(dict, 0u));
+    DoTest(concurrent_dict_count(dict) == 0);
+
+    for (u32 round = 0; round < 100; round++)
+    {
+        for (u32 key = 0; key < 100; key++)
+        {
+            concurrent_dict_set(dict, round * 100 + key, key);
+        }
+        for (u32 key = 0; key < 100; key++)
+        {
+            concurrent_dict_remove(dict, round * 100 + key);
+        }
+    }
+    DoTest(concurrent_dict_count(dict) == 0);
+    DoTest(dict->table->capacity <= 1024);
+
+    // A detached reader gets reused
+    concurrent_dict_detach(reader);
+    DoTest(concurrent_dict_attach(dict) == reader);
+
+    concurrent_dict_destroy(dict);
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+// Written as one 16 byte value, so a torn copy almost always breaks b == a * 3 + key
+struct TestConcurrentDictValue
+{
+    u64 a;
+    u64 b;
+};
+
+using TestConcurrentDictType = Concurrent_Dict<u32, TestConcurrentDictValue, U32_Hasher, U32_Eq>;
+
+struct TestConcurrentDictThread
+{
+    TestConcurrentDictType * dict;
+    u32 keyBegin;                       // Writers only touch [keyBegin, keyEnd)
+    u32 keyEnd;
+    u32 volatile * isDone;              // Readers stop once every writer has finished
+    int cFound;
+    int cTorn;
+};
+
+u32 const g_cTestConcurrentDictKeyPerWriter = 20000;
+int const g_cTestConcurrentDictWriter = 3;
+int const g_cTestConcurrentDictReader = 4;
+
+TestConcurrentDictValue
+TestConcurrentDictValueMake(u32 key, u64 a)
+{
+    TestConcurrentDictValue result = { a, a * 3 + key };
+    return result;
+}
+
+void
+TestConcurrentDictWriter(void * data)
+{
+    TestConcurrentDictThread * thread = (TestConcurrentDictThread *)data;
+
+    for (u32 key = thread->keyBegin; key < thread->keyEnd; key++)
+    {
+        concurrent_dict_set(thread->dict, key, TestConcurrentDictValueMake(key, 0));
+    }
+
+    for (u32 key = thread->keyBegin; key < thread->keyEnd; key++)
+    {
+        if (key % 3 == 0)
+        {
+            concurrent_dict_remove(thread->dict, key);
+        }
+        else
+        {
+            concurrent_dict_set(thread->dict, key, TestConcurrentDictValueMake(key, 1));
+        }
+    }
+
+    for (u32 key = thread->keyBegin; key < thread->keyEnd; key++)
+    {
+        if (key % 3 == 0)
+        {
+            concurrent_dict_set(thread->dict, key, TestConcurrentDictValueMake(key, 2));
+        }
+    }
+}
+
+void
+TestConcurrentDictReader(void * data)
+{
+    TestConcurrentDictThread * thread = (TestConcurrentDictThread *)data;
+    Concurrent_Dict_Reader * reader = concurrent_dict_attach(thread->dict);
+
+    u32 cKey = g_cTestConcurrentDictKeyPerWriter * g_cTestConcurrentDictWriter;
+    u32 rand = thread->keyBegin + 1;
+    while (!atomic_load(thread->isDone))
+    {
+        rand = rand * 1664525 + 1013904223;
+        u32 key = (rand >> 8) % cKey;
+
+        TestConcurrentDictValue value;
+        if (concurrent_dict_find(thread->dict, reader, key, &value))
+        {
+            thread->cFound++;
+            thread->cTorn += (value.b != value.a * 3 + key || value.a > 2);
+        }
+    }
+
+    concurrent_dict_detach(reader);
+}
+
+bool
+TestConcurrentDictThreaded()
+{
+    // Needs the thread hooks, installed by main() where the platform has them
+    if (!THREAD::system_thread_create)
+    {
+        AllTestsPass();
+    }
+
+    // Tables outgrow the region, so they come from the (counted) system hooks
+    MEM::Fn_System_allocate systemAllocatePrev = MEM::system_allocate;
+    MEM::Fn_System_Free systemFreePrev = MEM::system_free;
+    MEM::system_allocate = TestAllocate;
+    MEM::system_free = TestFree;
+
+    Memory_Region memory = mem_region_begin(nullptr, KILOBYTES(64));
+
+    TestConcurrentDictType * dict = concurrent_dict_create<u32, TestConcurrentDictValue, U32_Hasher, U32_Eq>(memory);
+    i32 capacityStart = dict->table->capacity;
+
+    u32 volatile isDone = 0;
+    TestConcurrentDictThread threads[g_cTestConcurrentDictWriter + g_cTestConcurrentDictReader] = {};
+    void * handles[ARRAY_LEN(threads)];
+
+    for (int i = 0; i < ARRAY_LEN(threads); i++)
+    {
+        threads[i].dict = dict;
+        threads[i].isDone = &isDone;
+        threads[i].keyBegin = i * g_cTestConcurrentDictKeyPerWriter;
+        threads[i].keyEnd = (i + 1) * g_cTestConcurrentDictKeyPerWriter;
+    }
+
+    // Readers first, so they're looking while the table grows
+    for (int i = g_cTestConcurrentDictWriter; i < ARRAY_LEN(threads); i++)
+    {
+        handles[i] = THREAD::system_thread_create(TestConcurrentDictReader, threads + i);
+        DoTest(handles[i]);
+    }
+    for (int i = 0; i < g_cTestConcurrentDictWriter; i++)
+    {
+        handles[i] = THREAD::system_thread_create(TestConcurrentDictWriter, threads + i);
+        DoTest(handles[i]);
+    }
+
+    for (int i = 0; i < g_cTestConcurrentDictWriter; i++)
+    {
+        THREAD::system_thread_join(handles[i]);
+    }
+    atomic_store(&isDone, 1u);
+    for (int i = g_cTestConcurrentDictWriter; i < ARRAY_LEN(threads); i++)
+    {
+        THREAD::system_thread_join(handles[i]);
+        DoTest(threads[i].cTorn == 0);
+    }
+
+    // Every key is back, with the value from its last write
+    u32 cKey = g_cTestConcurrentDictKeyPerWriter * g_cTestConcurrentDictWriter;
+    DoTest(concurrent_dict_count(dict) == (i32)cKey);
+    DoTest(dict->table->capacity >= capacityStart * 256);
+
+    Concurrent_Dict_Reader * reader = concurrent_dict_attach(dict);
+    for (u32 key = 0; key < cKey; key++)
+    {
+        TestConcurrentDictValue value;
+        DoTest(concurrent_dict_find(dict, reader, key, &value));
+        DoTest(value.a == ((key % 3 == 0) ? 2u : 1u) && value.b == value.a * 3 + key);
+    }
+    concurrent_dict_detach(reader);
+
+    // With no reader mid-lookup, the next rebuild frees every retired table, including the one it replaces
+    CONCURRENT_DICT::grow(dict, dict->table);
+    DoTest(!dict->retired);
+
+    concurrent_dict_destroy(dict);
+    mem_region_end(memory);
+
+    MEM::system_allocate = systemAllocatePrev;
+    MEM::system_free = systemFreePrev;
+
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestStringInterner()
+{
+    uint cBytes = MEGABYTES(1);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    // Small pages, so interned strings span several of them
+    String_Interner interner = string_interner_create(memory, 4, 64);
+    DoTest(string_interner_count(interner) == 0);
+
+    u32 idAlpha = string_intern(&interner, STR("alpha"));
+    u32 idBeta = string_intern(&interner, STR("beta"));
+    DoTest(idAlpha == 0 && idBeta == 1);
+
+    // Same contents at a different address get the same id, and the interner keeps its own copy
+    char keyBuffer[] = "alpha";
+    DoTest(string_intern(&interner, String(keyBuffer)) == idAlpha);
+    keyBuffer[0] = 'X';
+    DoTest(string_eq(string_interner_get(interner, idAlpha), STR("alpha")));
+
+    for (int i = 0; i < 500; i++)
+    {
+        char name[16];
+        int length = snprintf(name, sizeof(name), "name_%d", i % 200);
+        DoTest(string_intern(&interner, String(name, length)) == (u32)(2 + i % 200));
+    }
+    DoTest(string_interner_count(interner) == 202);
+    DoTest(string_eq(string_interner_get(interner, 2 + 123), STR("name_123")));
+
+    bool success;
+    DoTest(string_interner_find(interner, STR("beta"), &success) == idBeta && success);
+    string_interner_find(interner, STR("gamma"), &success);
+    DoTest(!success);
+    DoTest(string_interner_count(interner) == 202);
+
+    // Empty string is a string like any other
+    u32 idEmpty = string_intern(&interner, STR(""));
+    DoTest(string_intern(&interner, STR("")) == idEmpty);
+    DoTest(string_interner_get(interner, idEmpty).length == 0);
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestStaticDict()
+{
+    uint cBytes = MEGABYTES(4);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    using Static_U32 = Static_Dict<u32, u32, U32_Hasher64, U32_Eq>;
+
+    // From a Dict
+    {
+        Dict<u32, u32, U32_Hasher, U32_Eq> dict = dict_create<u32, u32, U32_Hasher, U32_Eq>(memory);
+        for (u32 i = 0; i < 10000; i++)
+        {
+            dict_set(&dict, i * 7, i);
+        }
+
+        bool success = false;
+        Static_U32 table = static_dict_create<u32, u32, U32_Hasher64, U32_Eq>(memory, dict, &success);
+        DoTest(success);
+        DoTest(table.count == 10000);
+
+        for (u32 i = 0; i < 10000; i++)
+        {
+            u32* value = dict_find_ptr(table, i * 7);
+            DoTest(value && *value == i);
+            DoTest(!dict_contains(table, i * 7 + 1));
+        }
+
+        // Every slot holds an item
+        int cIter = 0;
+        for (auto const& kvp : table)
+        {
+            DoTest(kvp.key == kvp.value * 7);
+            cIter++;
+        }
+        DoTest(cIter == 10000);
+
+        // Round trip, and loaded tables find the same things
+        Io_Push_Buffer writer = io_pb_create(memory, KILOBYTES(256));
+        DoTest(io_static_dict(&writer.vtable, &table, STR("table")));
+        DoTest(!writer.pb.pages->pNext);
+
+        Slice<u8> bytes = slice_create((u8 *)writer.pb.pages + sizeof(Push_Buffer::Page_Header), (int)writer.pb.lengthPushed);
+        Io_Slice_Reader reader = io_slice_reader_create(bytes, memory);
+
+        Static_U32 loaded = {};
+        DoTest(io_static_dict(&reader.vtable, &loaded, STR("table")));
+        DoTest(loaded.count == 10000 && loaded.items != table.items);
+        for (u32 i = 0; i < 10000; i++)
+        {
+            DoTest(dict_find(loaded, i * 7) == i);
+        }
+        DoTest(!dict_contains(loaded, 3u));
+
+        // A table of another type refuses to load it
+        reader = io_slice_reader_create(bytes, memory);
+        Static_Dict<u32, u64, U32_Hasher64, U32_Eq> mismatched = {};
+        DoTest(!io_static_dict(&reader.vtable, &mismatched, STR("table")));
+
+        static_dict_destroy(&loaded);
+        static_dict_destroy(&table);
+    }
+
+    // From slices, with String keys
+    {
+        String keys[] = { STR("red"), STR("green"), STR("blue"), STR("") };
+        int values[] = { 1, 2, 3, 4 };
+
+        bool success = false;
+        auto table = static_dict_create<String, int, String_Hasher64, String_Eq>(
+            memory,
+            slice_create(keys, ARRAY_LEN(keys)),
+            slice_create(values, ARRAY_LEN(values)),
+            &success);
+        DoTest(success);
+        DoTest(dict_find(table, STR("green")) == 2);
+        DoTest(dict_find(table, STR("")) == 4);
+        DoTest(!dict_contains(table, STR("purple")));
+    }
+
+    // Duplicate keys can't be told apart
+    {
+        u32 keys[] = { 1, 2, 3, 2 };
+        u32 values[] = { 1, 2, 3, 4 };
+
+        bool success = true;
+        Static_U32 table = static_dict_create<u32, u32, U32_Hasher64, U32_Eq>(
+            memory,
+            slice_create(keys, ARRAY_LEN(keys)),
+            slice_create(values, ARRAY_LEN(values)),
+            &success);
+        DoTest(!success);
+        DoTest(table.count == 0 && !dict_contains(table, 1u));
+    }
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
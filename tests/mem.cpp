@@ -1,28 +1,567 @@
  bool
 TestMemory()
 {
-    uint cBytes = Max(KILOBYTES(16), CONST::cBytesMinimumRegion);
+    uint cBytes = KILOBYTES(16);
     u8 * buffer = new u8[cBytes];
     
-    Memory_Region programMemory = BeginRootMemory_Region(buffer, cBytes);
+    Memory_Region programMemory = mem_region_init(buffer, cBytes, nullptr);
     DoTest(programMemory);
     
     u8 * memory0 = (u8 *)allocate(programMemory, 135);
     u8 * memory1 = (u8 *)allocate(programMemory, 206);
     u8 * memory2 = (u8 *)allocate(programMemory, 112);
 
-    // NOTE - These tests will change once alignment is implemented!
+    // Untracked allocations are carved off the end of the shared block, each rounded to the block granularity
     
-    DoTest(memory0 == (u8 *)programMemory + sizeof(Memory_Region_Header));
-    DoTest(memory1 - memory0 == 135);
-    DoTest(memory2 - memory1 == 206);
+    DoTest(memory0 + 135 <= buffer + cBytes);
+    DoTest(memory0 - memory1 == 208);
+    DoTest(memory1 - memory2 == 112);
+    DoTest((uintptr)memory0 % MEM::BYTE_COUNT::BLOCK_GRANULARITY == 0);
+    DoTest((uintptr)memory1 % MEM::BYTE_COUNT::BLOCK_GRANULARITY == 0);
+    DoTest((uintptr)memory2 % MEM::BYTE_COUNT::BLOCK_GRANULARITY == 0);
+
+    // Typed allocations are aligned for their type, even after an odd-sized one
+    
+    u8 * memoryOdd = (u8 *)allocate_tracked(programMemory, 13);
+    u64 * memoryU64 = allocate_array_tracked<u64>(programMemory, 3);
+    f64 * memoryF64 = allocate<f64>(programMemory);
+    DoTest(memoryOdd);
+    DoTest((uintptr)memoryU64 % alignof(u64) == 0);
+    DoTest((uintptr)memoryF64 % alignof(f64) == 0);
+    free_tracked_allocation(programMemory, memoryOdd);
+    free_tracked_allocation(programMemory, memoryU64);
     
     DoTest(g_cntNew == 1);
     
+    // Overflow comes from MEM::system_allocate(..), not from the buffer
     u8 * memoryOverflow = (u8 *)allocate(programMemory, (uint)KILOBYTES(32));
-    DoTest(g_cntNew == 2);
+    DoTest(memoryOverflow < buffer || memoryOverflow >= buffer + cBytes);
+    DoTest(g_cntNew == 1);
     
-    DoTest(mem_region_end(programMemory));
+    DoTest(mem_region_reset(programMemory));
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestMemoryTracked()
+{
+    uint cBytes = KILOBYTES(16);
+    u8 * buffer = new u8[cBytes];
+
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+    DoTest(memory);
+
+    u8 * memory0 = (u8 *)allocate_tracked(memory, 200);
+    u8 * memory1 = (u8 *)allocate_tracked(memory, 200);
+    u8 * memory2 = (u8 *)allocate_tracked(memory, 200);
+    DoTest(memory1 > memory0);
+    DoTest(memory2 > memory1);
+
+    // Freeing adjacent blocks coalesces them into one free block, which can service a bigger allocation
+    free_tracked_allocation(memory, memory0);
+    free_tracked_allocation(memory, memory1);
+
+    u8 * memory3 = (u8 *)allocate_tracked(memory, 400);
+    DoTest(memory3 == memory0);
+
+    // Freed blocks are re-used before carving more out of the shared block
+    free_tracked_allocation(memory, memory3);
+    u8 * memory4 = (u8 *)allocate_tracked(memory, 64);
+    DoTest(memory4 == memory0);
+
+    free_tracked_allocation(memory, memory4);
+    free_tracked_allocation(memory, memory2);
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestMemoryReallocateInPlace()
+{
+    uint cBytes = KILOBYTES(16);
+    u8 * buffer = new u8[cBytes];
+
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+    DoTest(memory);
+
+    // Right neighbor is the shared block
+    u8 * memory0 = (u8 *)allocate_tracked(memory, 100);
+    u8 * memory0Grown = (u8 *)reallocate_tracked(memory, memory0, 1000);
+    DoTest(memory0Grown == memory0);
+
+    // Right neighbor is a free (unshared) block
+    u8 * memory1 = (u8 *)allocate_tracked(memory, 500);
+    u8 * memory2 = (u8 *)allocate_tracked(memory, 500);
+    free_tracked_allocation(memory, memory2);
+    u8 * memory1Grown = (u8 *)reallocate_tracked(memory, memory1, 800);
+    DoTest(memory1Grown == memory1);
+
+    // Right neighbor is allocated, so we have to move
+    u8 * memory3 = (u8 *)allocate_tracked(memory, 100);
+    u8 * memory4 = (u8 *)allocate_tracked(memory, 100);
+    u8 * memory3Grown = (u8 *)reallocate_tracked(memory, memory3, 200);
+    DoTest(memory3Grown != memory3);
+
+    free_tracked_allocation(memory, memory0Grown);
+    free_tracked_allocation(memory, memory1Grown);
+    free_tracked_allocation(memory, memory3Grown);
+    free_tracked_allocation(memory, memory4);
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestMemoryAligned()
+{
+    uint cBytes = KILOBYTES(16);
+    u8 * buffer = new u8[cBytes];
+
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+    DoTest(memory);
+
+    uintptr alignments[] = { 8, 16, 32, 64 };
+    for (uintptr alignment : alignments)
+    {
+        u8 * untracked = (u8 *)allocate(memory, 37, alignment);
+        DoTest(((uintptr)untracked & (alignment - 1)) == 0);
+
+        u8 * tracked = (u8 *)allocate_tracked(memory, 37, alignment);
+        DoTest(((uintptr)tracked & (alignment - 1)) == 0);
+
+        int * array = allocate_array_tracked<int>(memory, 7, alignment);
+        DoTest(((uintptr)array & (alignment - 1)) == 0);
+
+        // Moving (or growing in place) preserves alignment
+        u8 * tracked2 = (u8 *)allocate_tracked(memory, 1, alignment);
+        tracked = (u8 *)reallocate_tracked(memory, tracked, 500, alignment);
+        DoTest(((uintptr)tracked & (alignment - 1)) == 0);
+
+        free_tracked_allocation(memory, tracked);
+        free_tracked_allocation(memory, tracked2);
+        free_tracked_allocation(memory, array);
+    }
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+// Stand-in for a platform's virtual memory. The whole "reservation" is real memory, so committing is a no-op.
+void* TestReserve(uintptr cBytes) { return new u8[cBytes]; }
+bool TestCommit(void *, uintptr) { return true; }
+void TestRelease(void * bytes, uintptr) { delete[] (u8 *)bytes; }
+
+bool
+TestMemoryVirtual()
+{
+    MEM::system_reserve = TestReserve;
+    MEM::system_commit = TestCommit;
+    MEM::system_release = TestRelease;
+
+    Memory_Region memory = mem_region_begin_virtual(MEGABYTES(1), KILOBYTES(64));
+    DoTest(memory);
+    DoTest(memory->reserved_byte_count == MEGABYTES(1));
+
+    // Grows past the initial commit without moving, or overflowing
+    u8 * tracked = (u8 *)allocate_tracked(memory, 100);
+    u8 * trackedOriginal = tracked;
+    for (uintptr cBytes = KILOBYTES(1); cBytes <= KILOBYTES(512); cBytes *= 2)
+    {
+        tracked = (u8 *)reallocate_tracked(memory, tracked, cBytes);
+        DoTest(tracked == trackedOriginal);
+    }
+
+    // Untracked allocations commit more as well
+    u8 * untracked = (u8 *)allocate(memory, KILOBYTES(200));
+    DoTest(untracked);
+    DoTest(!memory->overflow);
+    DoTest(memory->byte_budget <= memory->reserved_byte_count);
+
+    free_tracked_allocation(memory, tracked);
+    mem_region_end(memory);
+
+    MEM::system_reserve = nullptr;
+    MEM::system_commit = nullptr;
+    MEM::system_release = nullptr;
+
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+void* TestAllocate(uintptr cBytes) { return new u8[cBytes]; }
+void TestFree(void * bytes) { delete[] (u8 *)bytes; }
+
+bool
+TestMemoryScratch()
+{
+    MEM::Fn_System_allocate systemAllocatePrev = MEM::system_allocate;
+    MEM::Fn_System_Free systemFreePrev = MEM::system_free;
+    MEM::system_allocate = TestAllocate;
+    MEM::system_free = TestFree;
+
+    // No arena on this thread yet, so scratch is a child of the fallback parent
+    {
+        Memory_Region parent = mem_region_begin(nullptr, KILOBYTES(16));
+        Scratch fallback = scratch_begin(parent, KILOBYTES(4));
+        DoTest(!MEM::scratch_arena.bytes);
+        DoTest(fallback.memory->parent == parent);
+        DoTest(allocate(fallback.memory, 100));
+        scratch_end(fallback);
+        DoTest(!parent->first_child);
+        mem_region_end(parent);
+    }
+
+    scratch_thread_begin(KILOBYTES(64));
+
+    Scratch outer = scratch_begin(KILOBYTES(4));
+    u8 * outerBytes = (u8 *)allocate(outer.memory, 100);
+    DoTest(outerBytes);
+
+    // Nested scratch comes right after the outer one, and rolls back to the same spot
+    Scratch inner = scratch_begin(KILOBYTES(4));
+    DoTest((u8 *)inner.memory > (u8 *)outer.memory);
+    allocate(inner.memory, KILOBYTES(8));       // Overflows
+    DoTest(inner.memory->overflow);
+    scratch_end(inner);
+
+    Scratch inner2 = scratch_begin(KILOBYTES(4));
+    DoTest(inner2.memory == inner.memory);
+    scratch_end(inner2);
+
+    // Too big for the arena, so it gets its own region
+    Scratch big = scratch_begin(KILOBYTES(128));
+    DoTest(big.memory);
+    scratch_end(big);
+
+    scratch_end(outer);
+    DoTest(MEM::scratch_arena.cursor == 0);
+
+    scratch_thread_end();
+
+    MEM::system_allocate = systemAllocatePrev;
+    MEM::system_free = systemFreePrev;
+
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestMemoryStats()
+{
+#if MEM_STATS_ENABLE
+    uint cBytes = KILOBYTES(16);
+    u8 * buffer = new u8[cBytes];
+
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr, "stats");
+    Memory_Region_Stats stats = mem_region_stats(memory);
+    DoTest(stats.counters.live_byte_count == 0);
+    DoTest(stats.shared_free_block_count == 1);
+    DoTest(stats.fragmentation == 0.0f);
+
+    u8 * a = (u8 *)allocate_tracked(memory, 100);
+    u8 * b = (u8 *)allocate_tracked(memory, 100);
+    u8 * c = (u8 *)allocate_tracked(memory, 100);
+    allocate(memory, 100);
+
+    stats = mem_region_stats(memory);
+    DoTest(stats.counters.live_byte_count >= 400);
+    DoTest(stats.counters.live_byte_count + stats.free_byte_count == cBytes - sizeof(MEM::Region_Header));
+
+    // A hole in the middle is fragmentation
+    free_tracked_allocation(memory, b);
+    stats = mem_region_stats(memory);
+    DoTest(stats.tracked_free_block_count == 1);
+    DoTest(stats.fragmentation > 0.0f);
+    DoTest(stats.counters.live_byte_count_peak > stats.counters.live_byte_count);
+
+    free_tracked_allocation(memory, a);
+    free_tracked_allocation(memory, c);
+
+    mem_region_reset(memory);
+    stats = mem_region_stats(memory);
+    DoTest(stats.counters.live_byte_count == 0);
+
+    delete[] buffer;
+#endif
+
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestRecycleAllocator()
+{
+    uint cBytes = KILOBYTES(64);
+    u8 * buffer = new u8[cBytes];
+
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    struct Node
+    {
+        int value;
+        Node * next;
+    };
+
+    Recycle_Allocator<Node> alloc;
+    recycle_allocator_init(&alloc, memory, 4 /* slab_slot_count_initial */, 16 /* slab_slot_count_max */);
+
+    // Slots within a slab are contiguous
+    Node * nodes[40];
+    for (int i = 0; i < 40; i++)
+    {
+        nodes[i] = allocate(&alloc);
+        nodes[i]->value = i;
+    }
+    DoTest(nodes[1] == nodes[0] + 1);
+    DoTest(nodes[3] == nodes[0] + 3);
+
+    // Slabs grow geometrically, up to the max: 4, 8, 16, 16
+    int cSlab = 0;
+    for (auto * slab = alloc.slabs; slab; slab = slab->next)
+    {
+        cSlab++;
+    }
+    DoTest(cSlab == 4);
+    DoTest(alloc.slabs->slot_count == 16);
+
+    // Recycled slots are reused first
+    recycle(&alloc, nodes[7]);
+    DoTest(allocate(&alloc) == nodes[7]);
+    nodes[7]->value = 7;
+
+    // Iteration skips recycled slots
+    for (int i = 0; i < 40; i += 2)
+    {
+        recycle(&alloc, nodes[i]);
+    }
+
+    int cLive = 0;
+    int sum = 0;
+    recycle_allocator_for_each_live(&alloc, [&](Node * node) { cLive++; sum += node->value; });
+    DoTest(cLive == 20);
+    DoTest(sum == 400);     // 1 + 3 + ... + 39
+
+    // Many slabs, with recycled slots spread over all of them
+    Node * nodesMore[2000];
+    for (int i = 0; i < ARRAY_LEN(nodesMore); i++)
+    {
+        nodesMore[i] = allocate(&alloc);
+        nodesMore[i]->value = 1;
+    }
+    for (int i = 0; i < ARRAY_LEN(nodesMore); i += 3)
+    {
+        recycle(&alloc, nodesMore[i]);
+    }
+
+    cLive = 0;
+    sum = 0;
+    recycle_allocator_for_each_live(&alloc, [&](Node * node) { cLive++; sum += node->value; });
+    DoTest(cLive == 20 + 1333);
+    DoTest(sum == 400 + 1333);
+
+    recycle_allocator_reset(&alloc);
+    DoTest(!alloc.slabs && !alloc.recycleList);
+
+    Node * node = allocate(&alloc);
+    DoTest(node);
+
+    delete[] buffer;
+    DoTestAuditLeaks();
+    AllTestsPass();
+}
+
+bool
+TestBytesEqual(u8 const * a, u8 const * b, uintptr cBytes)
+{
+    for (uintptr i = 0; i < cBytes; i++)
+    {
+        if (a[i] != b[i])
+            return false;
+    }
+
+    return true;
+}
+
+bool
+TestMemoryCopy()
+{
+    // Every size and alignment around the head / tail / vector width boundaries, checked against a byte loop
+    int const cBytesMax = 200;
+    u8 src[cBytesMax + 64];
+    u8 dst[cBytesMax + 64];
+    u8 expected[cBytesMax + 64];
+
+    for (int i = 0; i < ARRAY_LEN(src); i++)
+    {
+        src[i] = (u8)(i * 7 + 1);
+    }
+
+    for (int cBytes = 0; cBytes <= cBytesMax; cBytes++)
+    {
+        for (int offset = 0; offset < 32; offset++)
+        {
+            for (int i = 0; i < ARRAY_LEN(dst); i++)
+            {
+                dst[i] = 0xCD;
+                expected[i] = 0xCD;
+            }
+            for (int i = 0; i < cBytes; i++)
+            {
+                expected[offset + i] = src[i + 3];
+            }
+
+            mem_copy(dst + offset, src + 3, cBytes);
+            DoTest(TestBytesEqual(dst, expected, ARRAY_LEN(dst)));
+
+            mem_set(expected + offset, 0x5A, cBytes);
+            mem_set(dst + offset, 0x5A, cBytes);
+            DoTest(TestBytesEqual(dst, expected, ARRAY_LEN(dst)));
+
+            // Overlapping moves, in both directions
+            for (int shift = -17; shift <= 17; shift += 5)
+            {
+                int from = 17 + offset;
+                int to = from + shift;
+                for (int i = 0; i < ARRAY_LEN(dst); i++)
+                {
+                    dst[i] = src[i];
+                    expected[i] = src[i];
+                }
+
+                int cBytesMove = min(cBytes, (int)ARRAY_LEN(dst) - max(from, to));
+                for (int i = 0; i < cBytesMove; i++)
+                {
+                    expected[to + i] = src[from + i];
+                }
+
+                mem_move(dst + to, dst + from, cBytesMove);
+                DoTest(TestBytesEqual(dst, expected, ARRAY_LEN(dst)));
+            }
+        }
+    }
+
+    AllTestsPass();
+}
+
+struct TestConcurrentRegionWorker
+{
+    Concurrent_Region * shared;
+    MEM::Thread_Cache * cache;
+    void ** remote;             // Allocated by the main thread, freed by this one
+    int cRemote;
+    void * owned[64];           // Allocated and freed by this thread, then handed back by detaching
+};
+
+void
+TestConcurrentRegionWorkerProc(void * data)
+{
+    TestConcurrentRegionWorker * worker = (TestConcurrentRegionWorker *)data;
+    worker->cache = concurrent_region_attach(worker->shared);
+
+    for (int i = 0; i < ARRAY_LEN(worker->owned); i++)
+    {
+        worker->owned[i] = allocate(worker->cache, 48);
+    }
+    for (int i = 0; i < ARRAY_LEN(worker->owned); i++)
+    {
+        free_tracked_allocation(worker->cache, worker->owned[i]);
+    }
+
+    for (int i = 0; i < worker->cRemote; i++)
+    {
+        free_tracked_allocation(worker->cache, worker->remote[i]);
+    }
+
+    concurrent_region_detach(worker->cache);
+}
+
+bool
+TestConcurrentRegion()
+{
+    // Needs the thread hooks, installed by main() where the platform has them
+    if (!THREAD::system_thread_create)
+    {
+        AllTestsPass();
+    }
+
+    uint cBytes = MEGABYTES(1);
+    u8 * buffer = new u8[cBytes];
+    Memory_Region memory = mem_region_init(buffer, cBytes, nullptr);
+
+    Concurrent_Region * shared = concurrent_region_begin(memory, KILOBYTES(16));
+    MEM::Thread_Cache * cache = concurrent_region_attach(shared);
+
+    // Small allocations are 16-byte aligned, and recycled by local frees
+    u8 * small = (u8 *)allocate(cache, 100);
+    DoTest(((uintptr)small & 15) == 0);
+    mem_set(small, 0xAB, 100);
+    free_tracked_allocation(cache, small);
+    DoTest(allocate(cache, 120) == small);
+
+    // Too big for any size class, so it comes straight from the shared region
+    u8 * large = (u8 *)allocate(cache, KILOBYTES(100), CTZ::YES);
+    DoTest(((uintptr)large & 15) == 0);
+    DoTest(large[0] == 0 && large[KILOBYTES(100) - 1] == 0);
+    free_tracked_allocation(cache, large);
+
+    // Remote frees from a second thread, which then detaches
+    void * remote[32];
+    for (int i = 0; i < ARRAY_LEN(remote); i++)
+    {
+        remote[i] = allocate(cache, 200);
+    }
+
+    TestConcurrentRegionWorker worker = {};
+    worker.shared = shared;
+    worker.remote = remote;
+    worker.cRemote = ARRAY_LEN(remote);
+
+    void * thread = THREAD::system_thread_create(TestConcurrentRegionWorkerProc, &worker);
+    DoTest(thread);
+    THREAD::system_thread_join(thread);
+    DoTest(worker.cache != cache);
+
+    // Remote frees come back once our own list runs dry
+    for (int i = 0; i < ARRAY_LEN(remote); i++)
+    {
+        void * bytes = allocate(cache, 200);
+
+        bool isRemote = false;
+        for (int j = 0; j < ARRAY_LEN(remote); j++)
+        {
+            isRemote |= (bytes == remote[j]);
+        }
+        DoTest(isRemote);
+    }
+
+    // Blocks the worker freed locally were handed back to the region when it detached
+    for (int i = 0; i < ARRAY_LEN(worker.owned); i++)
+    {
+        void * bytes = allocate(cache, 40);
+
+        bool isOwned = false;
+        for (int j = 0; j < ARRAY_LEN(worker.owned); j++)
+        {
+            isOwned |= (bytes == worker.owned[j]);
+        }
+        DoTest(isOwned);
+    }
+
+    // The detached cache is reused by the next attach
+    MEM::Thread_Cache * cacheReused = concurrent_region_attach(shared);
+    DoTest(cacheReused == worker.cache);
+    concurrent_region_detach(cacheReused);
+
+    concurrent_region_detach(cache);
+    concurrent_region_end(shared);
+    delete[] buffer;
+
     DoTestAuditLeaks();
     AllTestsPass();
 }
@@ -8,6 +8,10 @@
 
 #include "../common.h"
 
+#if !COMPILER_MSVC
+#include "../thread_linux.h"
+#endif
+
 
 //
 // Convenience utilities for tests
@@ -43,12 +47,28 @@ void operator delete[](void* ptr)
 }
 
 #define DoTestAuditLeaks() do { DoTest(g_cntNew == g_cntDelete); } while(0)
+
+// System hooks for regions that overflow, and for the scratch arena. Not counted by DoTestAuditLeaks().
+void* TestSystemAllocate(uintptr cBytes) { return malloc(cBytes); }
+void* TestSystemReallocate(void * bytes, uintptr cBytes) { return realloc(bytes, cBytes); }
+void TestSystemFree(void * bytes) { free(bytes); }
     
 #include "mem.cpp"
 #include "array.cpp"
+#include "dict.cpp"
 
 int main()
 {
+    MEM::system_allocate = TestSystemAllocate;
+    MEM::system_reallocate = TestSystemReallocate;
+    MEM::system_free = TestSystemFree;
+
+    // Thread hooks, where the platform has them. Without them, Thread_Pool runs batches serially, and tests
+    //  that start their own threads are skipped.
+#if !COMPILER_MSVC
+    thread_linux_install();
+#endif
+
     printf("\n");
     fflush(stdout);
 
@@ -58,7 +78,32 @@ int main()
 #define RunTest(TEST) cntPass += TEST(); cntTest++;
 
     RunTest(TestMemory);
+    RunTest(TestMemoryTracked);
+    RunTest(TestMemoryReallocateInPlace);
+    RunTest(TestMemoryAligned);
+    RunTest(TestMemoryVirtual);
+    RunTest(TestMemoryScratch);
+    RunTest(TestMemoryStats);
+    RunTest(TestRecycleAllocator);
+    RunTest(TestMemoryCopy);
+    RunTest(TestConcurrentRegion);
     RunTest(TestDynArray);
+    RunTest(TestSlotMap);
+    RunTest(TestSort);
+    RunTest(TestParallelSort);
+    RunTest(TestSortedSearch);
+    RunTest(TestMergeSort);
+    RunTest(TestPriorityQueue);
+    RunTest(TestSwissDict);
+    RunTest(TestRobinHoodDict);
+    RunTest(TestDictIncrementalResize);
+    RunTest(TestDictPolicy);
+    RunTest(TestHash);
+    RunTest(TestDictFindBatch);
+    RunTest(TestConcurrentDict);
+    RunTest(TestConcurrentDictThreaded);
+    RunTest(TestStringInterner);
+    RunTest(TestStaticDict);
 
 #undef RunTest
 
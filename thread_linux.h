@@ -0,0 +1,100 @@
+#pragma once
+
+// --- Linux threads and semaphores for Thread_Pool
+//  Not included by core.h, since it pulls in system headers. Include it from the platform layer, and call
+//  thread_linux_install() once at startup. Link with -pthread.
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
+#include <stdlib.h>
+
+namespace THREAD
+{
+
+struct Linux_Thread_Start
+{
+    Fn_Thread_Proc proc;
+    void* data;
+};
+
+function void*
+linux_thread_start(void* data)
+{
+    Linux_Thread_Start start = *(Linux_Thread_Start*)data;
+    free(data);
+
+    start.proc(start.data);
+    return nullptr;
+}
+
+} // namespace THREAD
+
+function void*
+thread_linux_create(THREAD::Fn_Thread_Proc proc, void* data)
+{
+    using namespace THREAD;
+
+    pthread_t* result = (pthread_t*)malloc(sizeof(pthread_t));
+    Linux_Thread_Start* start = (Linux_Thread_Start*)malloc(sizeof(Linux_Thread_Start));
+    start->proc = proc;
+    start->data = data;
+
+    if (pthread_create(result, nullptr, linux_thread_start, start) != 0)
+    {
+        free(start);
+        free(result);
+        return nullptr;
+    }
+
+    return result;
+}
+
+function void
+thread_linux_join(void* thread)
+{
+    pthread_join(*(pthread_t*)thread, nullptr);
+    free(thread);
+}
+
+function void*
+thread_linux_semaphore_create()
+{
+    sem_t* result = (sem_t*)malloc(sizeof(sem_t));
+    sem_init(result, 0 /* pshared */, 0);
+    return result;
+}
+
+function void
+thread_linux_semaphore_wait(void* semaphore)
+{
+    // Retry if a signal interrupts the wait
+    while (sem_wait((sem_t*)semaphore) != 0 && errno == EINTR);
+}
+
+function void
+thread_linux_semaphore_post(void* semaphore, u32 count)
+{
+    for (u32 i = 0; i < count; i++)
+    {
+        sem_post((sem_t*)semaphore);
+    }
+}
+
+function void
+thread_linux_semaphore_destroy(void* semaphore)
+{
+    sem_destroy((sem_t*)semaphore);
+    free(semaphore);
+}
+
+function void
+thread_linux_install()
+{
+    THREAD::system_thread_create = thread_linux_create;
+    THREAD::system_thread_join = thread_linux_join;
+    THREAD::system_semaphore_create = thread_linux_semaphore_create;
+    THREAD::system_semaphore_wait = thread_linux_semaphore_wait;
+    THREAD::system_semaphore_post = thread_linux_semaphore_post;
+    THREAD::system_semaphore_destroy = thread_linux_semaphore_destroy;
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+// --- Thread pool
+//  A few worker threads that run batches of indexed tasks: thread_pool_run(..) calls task(data, i) for every i in
+//  [0, task_count), spread over the workers and the calling thread, and returns once they've all finished.
+//  Batches run one at a time, and only the thread that created the pool may start them.
+//
+//  Threads and semaphores come from the THREAD::system_* hooks, like memory comes from MEM::system_*. Install
+//  them from the platform layer (e.g. thread_linux_install() in thread_linux.h). Without them, pools get no
+//  workers, and batches run serially on the calling thread.
+//
+//  usage:
+//      Thread_Pool* pool = thread_pool_create(memory, 7);     // + the calling thread = 8
+//      thread_pool_run(pool, chunk_count, sort_chunk, &context);
+//      ...
+//      thread_pool_destroy(pool);
+
+namespace THREAD
+{
+
+using Fn_Thread_Proc = void (*) (void*);
+
+using Fn_System_Thread_Create = void* (*) (Fn_Thread_Proc, void*);
+using Fn_System_Thread_Join = void (*) (void*);
+using Fn_System_Semaphore_Create = void* (*) ();
+using Fn_System_Semaphore_Wait = void (*) (void*);
+using Fn_System_Semaphore_Post = void (*) (void*, u32);
+using Fn_System_Semaphore_Destroy = void (*) (void*);
+
+Fn_System_Thread_Create system_thread_create = {};
+Fn_System_Thread_Join system_thread_join = {};
+Fn_System_Semaphore_Create system_semaphore_create = {};
+Fn_System_Semaphore_Wait system_semaphore_wait = {};
+Fn_System_Semaphore_Post system_semaphore_post = {};
+Fn_System_Semaphore_Destroy system_semaphore_destroy = {};
+
+} // namespace THREAD
+
+using Fn_Thread_Pool_Task = void (*) (void* data, int task_index);
+
+struct Thread_Pool
+{
+    Memory_Region memory;
+    void** threads;
+    int thread_count;           // Workers, not counting the thread that runs batches
+
+    void* wake;                 // Semaphore. Posted once per worker per batch.
+    void* checked_in;           // Semaphore. Each worker posts it once per batch, after it runs out of tasks.
+
+    // The current batch. Written before the workers are woken, and not again until they've all checked in,
+    //  so a slow worker can't wake into a half-written batch.
+    Fn_Thread_Pool_Task task;
+    void* data;
+    u32 task_count;
+    u32 volatile next_task;
+    u32 volatile quit;
+};
+
+namespace THREAD
+{
+
+function void
+thread_pool_run_tasks(Thread_Pool* pool)
+{
+    while (true)
+    {
+        u32 task_index = atomic_add(&pool->next_task, 1u);
+        if (task_index >= pool->task_count)
+            break;
+
+        pool->task(pool->data, (int)task_index);
+    }
+}
+
+function void
+thread_pool_worker(void* data)
+{
+    Thread_Pool* pool = (Thread_Pool*)data;
+
+    // Tasks get a scratch arena on every worker. Without the memory hooks, they fall back like any other thread.
+    if (MEM::system_allocate)
+    {
+        scratch_thread_begin();
+    }
+
+    while (true)
+    {
+        system_semaphore_wait(pool->wake);
+        if (atomic_load(&pool->quit))
+            break;
+
+        thread_pool_run_tasks(pool);
+        system_semaphore_post(pool->checked_in, 1);
+    }
+
+    if (MEM::scratch_arena.bytes)
+    {
+        scratch_thread_end();
+    }
+}
+
+} // namespace THREAD
+
+function Thread_Pool*
+thread_pool_create(Memory_Region parent, int worker_count)
+{
+    using namespace THREAD;
+
+    worker_count = max(worker_count, 0);
+    Memory_Region memory = mem_region_begin(parent, sizeof(Thread_Pool) + worker_count * sizeof(void*));
+
+    Thread_Pool* result = allocate<Thread_Pool>(memory, CTZ::YES);
+    result->memory = memory;
+
+    bool has_hooks =
+        system_thread_create && system_thread_join &&
+        system_semaphore_create && system_semaphore_wait && system_semaphore_post && system_semaphore_destroy;
+
+    if (!has_hooks || worker_count == 0)
+        return result;
+
+    result->wake = system_semaphore_create();
+    result->checked_in = system_semaphore_create();
+    result->threads = allocate_array<void*>(memory, worker_count, alignof(void*), CTZ::YES);
+    for (int i = 0; i < worker_count; i++)
+    {
+        void* thread = system_thread_create(thread_pool_worker, result);
+        if (!thread)
+        {
+            ASSERT_FALSE_WARN;
+            break;
+        }
+
+        result->threads[i] = thread;
+        result->thread_count++;
+    }
+
+    return result;
+}
+
+// Waits for the workers to exit, then frees everything
+function void
+thread_pool_destroy(Thread_Pool* pool)
+{
+    using namespace THREAD;
+
+    if (pool->thread_count > 0)
+    {
+        atomic_store(&pool->quit, 1u);
+        system_semaphore_post(pool->wake, (u32)pool->thread_count);
+        for (int i = 0; i < pool->thread_count; i++)
+        {
+            system_thread_join(pool->threads[i]);
+        }
+    }
+
+    if (pool->wake)
+    {
+        system_semaphore_destroy(pool->wake);
+        system_semaphore_destroy(pool->checked_in);
+    }
+
+    mem_region_end(pool->memory);
+}
+
+// Workers plus the calling thread. Pass nullptr for "just the calling thread".
+function int
+thread_pool_thread_count(Thread_Pool const* pool)
+{
+    int result = pool ? pool->thread_count + 1 : 1;
+    return result;
+}
+
+function void
+thread_pool_run(Thread_Pool* pool, int task_count, Fn_Thread_Pool_Task task, void* data)
+{
+    using namespace THREAD;
+
+    if (!pool || pool->thread_count == 0 || task_count <= 1)
+    {
+        for (int i = 0; i < task_count; i++)
+        {
+            task(data, i);
+        }
+
+        return;
+    }
+
+    pool->task = task;
+    pool->data = data;
+    pool->task_count = (u32)task_count;
+    atomic_store(&pool->next_task, 0u);
+
+    // Wake every worker, even if there are fewer tasks, so they all check in and none of them is left behind
+    //  holding a wake-up meant for this batch.
+    system_semaphore_post(pool->wake, (u32)pool->thread_count);
+    thread_pool_run_tasks(pool);
+
+    for (int i = 0; i < pool->thread_count; i++)
+    {
+        system_semaphore_wait(pool->checked_in);
+    }
+}